@@ -0,0 +1,73 @@
+#include "batch_means.h"
+
+// Library headers
+#include "macros.h"
+
+// STD headers
+#include <algorithm>
+#include <math.h>
+
+/**
+ * BatchMeans implementation.
+ */
+size_t BatchMeans::getWarmupLength() const {
+    // MSER-5: Average the series over batches of 5 samples, and
+    // pick the truncation point (in the first half of the series)
+    // that minimizes the standard error of the remaining batches.
+    constexpr size_t kMSERBatchSize = 5;
+    const size_t num_batches = (samples_.size() / kMSERBatchSize);
+    if (num_batches < 2) { return 0; }
+
+    std::vector<double> batches(num_batches, 0);
+    for (size_t idx = 0; idx < num_batches * kMSERBatchSize; idx++) {
+        batches[idx / kMSERBatchSize] += (samples_[idx] / kMSERBatchSize);
+    }
+    // Suffix sums of the batch means and their squares
+    double sum = 0, sum_squares = 0;
+    double best_mser = kDblPosInfty;
+    size_t best_truncation = 0;
+    std::vector<double> mser(num_batches, 0);
+    for (size_t idx = num_batches; idx-- > 0;) {
+        sum += batches[idx];
+        sum_squares += (batches[idx] * batches[idx]);
+        const double n = (num_batches - idx);
+        mser[idx] = std::max(0.0, sum_squares - (sum * sum) / n) / (n * n);
+    }
+    for (size_t idx = 0; idx <= (num_batches / 2); idx++) {
+        if (mser[idx] < best_mser) {
+            best_mser = mser[idx];
+            best_truncation = idx;
+        }
+    }
+    return (best_truncation * kMSERBatchSize);
+}
+
+BatchMeans::Estimate
+BatchMeans::getEstimate(const size_t warmup_length) const {
+    Estimate estimate;
+    estimate.half_width = kDblPosInfty;
+
+    // Group the (latest) samples into batches of equal size
+    const size_t num_samples = (samples_.size() > warmup_length) ?
+                               (samples_.size() - warmup_length) : 0;
+    const size_t batch_size = (num_samples / kNumBatches);
+    if (batch_size == 0) { return estimate; }
+    const size_t start = (samples_.size() - (batch_size * kNumBatches));
+
+    double sum = 0, sum_squares = 0;
+    for (size_t batch = 0; batch < kNumBatches; batch++) {
+        double batch_mean = 0;
+        for (size_t idx = 0; idx < batch_size; idx++) {
+            batch_mean += samples_[start + (batch * batch_size) + idx];
+        }
+        batch_mean /= batch_size;
+        sum += batch_mean;
+        sum_squares += (batch_mean * batch_mean);
+    }
+    estimate.mean = (sum / kNumBatches);
+    const double variance = std::max(0.0, (sum_squares - (sum * sum) /
+                                           kNumBatches) / (kNumBatches - 1));
+
+    estimate.half_width = kCriticalValue * sqrt(variance / kNumBatches);
+    return estimate;
+}
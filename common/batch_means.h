@@ -0,0 +1,62 @@
+#ifndef COMMON_BATCH_MEANS_H
+#define COMMON_BATCH_MEANS_H
+
+// STD headers
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Estimates the steady-state mean of an (autocorrelated) output
+ * series, e.g. per-batch goodput samples. The initial transient is
+ * detected using MSER-5 and discarded; the remaining samples are
+ * then grouped into kNumBatches non-overlapping batches, and the
+ * confidence interval is computed from the batch means (which are
+ * approximately i.i.d. normal for sufficiently long batches).
+ */
+class BatchMeans final {
+public:
+    // Number of batches for the CI, and the corresponding critical
+    // value of the t-distribution (19 dof, 95% two-sided).
+    static constexpr uint32_t kNumBatches = 20;
+    static constexpr double kCriticalValue = 2.093;
+
+    /**
+     * Represents a point estimate and its 95% confidence interval.
+     */
+    struct Estimate {
+        double mean = 0; // Point estimate
+        double half_width = 0; // CI half-width (inf if undetermined)
+    };
+
+private:
+    std::vector<double> samples_; // Output series
+
+public:
+    // Accessors
+    size_t size() const { return samples_.size(); }
+
+    /**
+     * Appends a sample to the series.
+     */
+    void add(const double sample) { samples_.push_back(sample); }
+
+    /**
+     * Returns the warm-up period (in samples) to truncate, as
+     * determined by the MSER-5 rule.
+     */
+    size_t getWarmupLength() const;
+
+    /**
+     * Returns the batch-means estimate, discarding the given
+     * number of initial (warm-up) samples.
+     */
+    Estimate getEstimate(const size_t warmup_length) const;
+
+    /**
+     * Clears the series.
+     */
+    void reset() { samples_.clear(); }
+};
+
+#endif // COMMON_BATCH_MEANS_H
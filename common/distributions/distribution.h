@@ -3,6 +3,7 @@
 
 // Library headers
 #include "common/macros.h"
+#include "common/philox.h"
 #include "common/utils.h"
 
 // STD headers
@@ -45,9 +46,18 @@ protected:
     const double kMin = kDblNegInfty; // Minimum value (default: -inf)
     const double kMax = kDblPosInfty; // Maximum value (default: +inf)
 
-    // Randomness
-    std::random_device rd_;
-    std::mt19937 generator_;
+private:
+    // Randomness. Note: Distributions must be explicitly seeded
+    // before use; otherwise, they would all share the default
+    // stream (and their samples would be perfectly correlated).
+    Philox4x32 generator_;
+    bool is_seeded_ = false; // Has a stream been selected?
+
+protected:
+    /**
+     * Returns the random stream (which must have been seeded).
+     */
+    Philox4x32& generator() { SP_ASSERT(is_seeded_); return generator_; }
 
     /**
      * Helper method. Given an array of samples (from some
@@ -56,12 +66,11 @@ protected:
     static Statistics analyzeSamples(const std::vector<double>& v);
 
     // Constructors
-    explicit Distribution(const std::string type) :
-                          kType(type), generator_(rd_()) {}
+    explicit Distribution(const std::string type) : kType(type) {}
 
     explicit Distribution(const std::string type, const double
                           min, const double max) : kType(type),
-                          kMin(min), kMax(max), generator_(rd_()) {}
+                          kMin(min), kMax(max) {}
 public:
     virtual ~Distribution() { assert(kSampleStats.isInitialized()); }
     DISALLOW_COPY_AND_ASSIGN(Distribution);
@@ -81,6 +90,16 @@ public:
      * Sample from the distribution.
      */
     virtual double sample() = 0;
+
+    /**
+     * Seeds (and rewinds) the distribution's random stream. Any
+     * state cached by the implementation is also discarded, so
+     * the sequence of samples is a function of the seed alone.
+     */
+    virtual void seed(const uint64_t seed) {
+        generator_.seed(seed);
+        is_seeded_ = true;
+    }
 };
 
 #endif // COMMON_DISTRIBUTIONS_DISTRIBUTION_H
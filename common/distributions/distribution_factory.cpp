@@ -5,6 +5,7 @@
 #include "exponential_distribution.h"
 #include "normal_distribution.h"
 #include "uniform_distribution.h"
+#include "zipf_distribution.h"
 
 // STD headers
 #include <string>
@@ -74,6 +75,19 @@ generate(const libconfig::Setting& dist_config) {
                 "OR ('mean', 'std') for a uniform distribution.");
         }
     }
+    // Zipf distribution
+    else if (type == ZipfDistribution::name()) {
+        uint32_t num_elements; // Support size
+        double alpha = 1; // Zipf exponent
+        if (!dist_config.lookupValue("num_elements", num_elements)) {
+            throw std::runtime_error(
+                "Must specify 'num_elements' for a zipf distribution.");
+        }
+        else {
+            dist_config.lookupValue("alpha", alpha);
+            distribution = new ZipfDistribution(num_elements, alpha);
+        }
+    }
     // Unknown distribution
     else { throw std::runtime_error(
         "Unknown distribution type: " + type + "."); }
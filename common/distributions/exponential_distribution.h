@@ -34,7 +34,15 @@ public:
     /**
      * Sample from the distribution.
      */
-    double sample() override { return dist_(generator_); }
+    double sample() override { return dist_(generator()); }
+
+    /**
+     * Seeds (and rewinds) the distribution's random stream.
+     */
+    void seed(const uint64_t seed) override {
+        Distribution::seed(seed);
+        dist_.reset();
+    }
 
     /**
      * Distribution name.
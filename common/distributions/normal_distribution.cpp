@@ -28,11 +28,19 @@ void NormalDistribution::printConfiguration() const {
 void NormalDistribution::updateSampleParameters() {
     Statistics sample_stats{dist_.mean(), dist_.stddev()};
 
-    // Truncated distribution
+    // Truncated distribution. Note: The statistics are estimated
+    // using a private stream, so this distribution's own stream
+    // is left untouched (and must still be seeded before use).
     if (isTruncated()) {
         constexpr size_t kMaxNumSamples = 1000000;
+        std::normal_distribution<double> dist(dist_.param());
+        Philox4x32 generator;
+
         std::vector<double> v(kMaxNumSamples, 0); // Samples
-        for (size_t idx = 0; idx < v.size(); idx++) { v[idx] = sample(); }
+        for (size_t idx = 0; idx < v.size();) {
+            const double sample = dist(generator);
+            if (sample >= kMin && sample <= kMax) { v[idx++] = sample; }
+        }
         sample_stats = analyzeSamples(v); // Compute the sample statistics
     }
     // Update the sample stats
@@ -51,7 +59,7 @@ bool NormalDistribution::isTruncated() const {
  */
 double NormalDistribution::sample() {
     while (true) {
-        double sample = dist_(generator_);
+        double sample = dist_(generator());
         if (sample >= kMin && sample <= kMax) { return sample; }
     }
 }
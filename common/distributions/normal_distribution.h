@@ -29,6 +29,14 @@ public:
     bool isTruncated() const;
     double sample() override;
 
+    /**
+     * Seeds (and rewinds) the distribution's random stream.
+     */
+    void seed(const uint64_t seed) override {
+        Distribution::seed(seed);
+        dist_.reset();
+    }
+
     /**
      * Distribution name.
      */
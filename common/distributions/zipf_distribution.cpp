@@ -0,0 +1,57 @@
+#include "zipf_distribution.h"
+
+// STD headers
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * ZipfDistribution implementation.
+ */
+ZipfDistribution::ZipfDistribution(
+    const uint32_t num_elements, const double alpha) :
+    Distribution(name(), 1, num_elements), kAlpha(alpha), dist_(0, 1) {
+    if (num_elements == 0) {
+        throw std::invalid_argument("Element count must be positive");
+    }
+    else if (alpha < 0) {
+        throw std::invalid_argument("Exponent must be non-negative");
+    }
+    // Compute the (unnormalized) CDF
+    cdf_.resize(num_elements);
+    double total = 0;
+    for (uint32_t idx = 0; idx < num_elements; idx++) {
+        total += (1 / std::pow(idx + 1, alpha));
+        cdf_[idx] = total;
+    }
+    // Normalize the CDF and compute the sample stats
+    double mean = 0, second_moment = 0;
+    for (uint32_t idx = 0; idx < num_elements; idx++) {
+        const double rank = (idx + 1);
+        const double p = (1 / std::pow(rank, alpha)) / total;
+        mean += (p * rank);
+        second_moment += (p * rank * rank);
+        cdf_[idx] /= total;
+    }
+    cdf_.back() = 1; // Guard against rounding errors
+    kSampleStats.set(mean, sqrt(std::max(
+        0.0, second_moment - (mean * mean))));
+}
+
+void ZipfDistribution::printConfiguration() const {
+    std::cout << "{ type: " << name() << ", "
+              << std::fixed << std::setprecision(2)
+              << "num_elements: " << cdf_.size() << ", "
+              << "alpha: " << kAlpha << " }";
+}
+
+/**
+ * Sample from the distribution.
+ */
+double ZipfDistribution::sample() {
+    auto iter = std::lower_bound(cdf_.begin(), cdf_.end(),
+                                 dist_(generator()));
+    return static_cast<double>((iter - cdf_.begin()) + 1);
+}
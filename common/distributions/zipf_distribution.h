@@ -0,0 +1,50 @@
+#ifndef COMMON_DISTRIBUTIONS_ZIPF_DISTRIBUTION_H
+#define COMMON_DISTRIBUTIONS_ZIPF_DISTRIBUTION_H
+
+// Library headers
+#include "distribution.h"
+
+// STD headers
+#include <vector>
+
+/**
+ * Represents a (bounded) Zipf distribution over the ranks
+ * {1, ..., N}, where P(k) is proportional to 1 / k^alpha.
+ * An exponent of zero yields a discrete uniform distribution.
+ */
+class ZipfDistribution : public Distribution {
+private:
+    const double kAlpha; // Zipf exponent
+    std::vector<double> cdf_; // Cumulative probabilities
+    std::uniform_real_distribution<double> dist_; // U(0, 1)
+
+public:
+    explicit ZipfDistribution(const uint32_t num_elements,
+                              const double alpha);
+    virtual ~ZipfDistribution() {}
+
+    /**
+     * Print the distribution configuration.
+     */
+    virtual void printConfiguration() const override;
+
+    /**
+     * Sample from the distribution.
+     */
+    double sample() override;
+
+    /**
+     * Seeds (and rewinds) the distribution's random stream.
+     */
+    void seed(const uint64_t seed) override {
+        Distribution::seed(seed);
+        dist_.reset();
+    }
+
+    /**
+     * Distribution name.
+     */
+    static std::string name() { return "zipf"; }
+};
+
+#endif // COMMON_DISTRIBUTIONS_ZIPF_DISTRIBUTION_H
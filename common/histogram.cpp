@@ -0,0 +1,43 @@
+#include "histogram.h"
+
+// STD headers
+#include <math.h>
+
+/**
+ * LogLinearHistogram implementation.
+ */
+double LogLinearHistogram::getBucketMidpoint(const uint32_t idx) const {
+    // Buckets in the first two power-of-two ranges have unit
+    // width; beyond that, the width doubles every 2^kPrecision.
+    const uint32_t range = (idx >> kPrecision);
+    const uint32_t shift = (range > 1) ? (range - 1) : 0;
+    const uint64_t lower = static_cast<uint64_t>(
+        idx - (shift << kPrecision)) << shift;
+
+    return lower + ((static_cast<uint64_t>(1) << shift) >> 1);
+}
+
+double LogLinearHistogram::getQuantile(const double q) const {
+    if (count_ == 0) { return 0; }
+
+    // Find the bucket containing the sample of the given rank
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(
+        ceil(std::min(1.0, std::max(0.0, q)) * count_)));
+    if (rank == count_) { return max_; }
+
+    uint64_t cumulative = 0;
+    for (uint32_t idx = 0; idx < counts_.size(); idx++) {
+        cumulative += counts_[idx];
+        if (cumulative >= rank) {
+            return std::min(max_, std::max(min_, getBucketMidpoint(idx)));
+        }
+    }
+    return max_;
+}
+
+void LogLinearHistogram::reset() {
+    counts_.clear();
+    count_ = 0;
+    min_ = kDblPosInfty;
+    max_ = 0;
+}
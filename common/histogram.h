@@ -0,0 +1,74 @@
+#ifndef COMMON_HISTOGRAM_H
+#define COMMON_HISTOGRAM_H
+
+// Library headers
+#include "macros.h"
+
+// STD headers
+#include <algorithm>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Streaming log-linear histogram (a la HdrHistogram), used to track
+ * quantiles of non-negative values (e.g., latencies in ns) in O(1)
+ * time per sample. Values are rounded to integers and binned so that
+ * every power-of-two range [2^k, 2^(k+1)) is split into 2^kPrecision
+ * equal-width buckets, bounding the relative quantile error by
+ * 2^-kPrecision. Buckets are allocated on demand (up to the largest
+ * value recorded, M), so a histogram uses roughly (log2(M) - kPrecision
+ * + 2) * 2^kPrecision 8-byte counters. For nanosecond values of up to
+ * 1 second, this is about 170KB at the default precision (10), and
+ * about 7KB at a precision of 5.
+ */
+class LogLinearHistogram final {
+private:
+    uint32_t kPrecision; // Sub-buckets per power-of-two (log2)
+    std::vector<uint64_t> counts_; // Per-bucket sample counts
+    uint64_t count_ = 0; // Total sample count
+    double min_ = kDblPosInfty; // Minimum sample
+    double max_ = 0; // Maximum sample
+
+    // Internal helper methods
+    uint32_t getIndex(const uint64_t value) const {
+        const uint32_t msb = (value == 0) ? 0 : (63 - __builtin_clzll(value));
+        const uint32_t shift = (msb > kPrecision) ? (msb - kPrecision) : 0;
+        return (shift << kPrecision) + static_cast<uint32_t>(value >> shift);
+    }
+    double getBucketMidpoint(const uint32_t idx) const;
+
+public:
+    explicit LogLinearHistogram(const uint32_t precision=10) :
+                                kPrecision(precision) {}
+    // Accessors
+    uint64_t getCount() const { return count_; }
+    double getMin() const { return (count_ == 0) ? 0 : min_; }
+    double getMax() const { return max_; }
+
+    /**
+     * Records a (non-negative) sample.
+     */
+    void record(const double value) {
+        const uint32_t idx = getIndex(static_cast<uint64_t>(value + 0.5));
+        if (idx >= counts_.size()) { counts_.resize(idx + 1, 0); }
+        counts_[idx]++;
+        count_++;
+
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    /**
+     * Returns the (approximate) q-th quantile of the recorded
+     * samples, for q in [0, 1]. Returns 0 if the histogram is
+     * empty.
+     */
+    double getQuantile(const double q) const;
+
+    /**
+     * Clears all samples.
+     */
+    void reset();
+};
+
+#endif // COMMON_HISTOGRAM_H
@@ -0,0 +1,93 @@
+#ifndef COMMON_PHILOX_H
+#define COMMON_PHILOX_H
+
+// STD headers
+#include <limits>
+#include <stdint.h>
+
+/**
+ * Philox4x32-10 counter-based random number engine (Salmon et al.,
+ * "Parallel Random Numbers: As Easy as 1, 2, 3", SC'11). The n'th
+ * block of output is a pure function of (key, n), so every key is
+ * an independent stream; seeding is O(1), and streams for distinct
+ * (seed, role) pairs can be derived without any coordination (see
+ * deriveSeed). Satisfies UniformRandomBitGenerator, so it can be
+ * used with the <random> distributions in place of std::mt19937.
+ */
+class Philox4x32 final {
+public:
+    typedef uint32_t result_type;
+
+private:
+    // Round constants
+    static constexpr uint32_t kMultiplier0 = 0xD2511F53;
+    static constexpr uint32_t kMultiplier1 = 0xCD9E8D57;
+    static constexpr uint32_t kWeyl0 = 0x9E3779B9;
+    static constexpr uint32_t kWeyl1 = 0xBB67AE85;
+    static constexpr uint32_t kNumRounds = 10;
+
+    uint32_t key_[2] = {0, 0}; // Stream key
+    uint64_t counter_ = 0; // Index of the next block
+    uint32_t block_[4] = {0, 0, 0, 0}; // Current output block
+    uint32_t offset_ = 4; // Next word in the current block
+
+    // Internal helper method. Generates the next output block.
+    void generate() {
+        uint32_t x[4] = {static_cast<uint32_t>(counter_),
+                         static_cast<uint32_t>(counter_ >> 32), 0, 0};
+        uint32_t k0 = key_[0], k1 = key_[1];
+        for (uint32_t round = 0; round < kNumRounds; round++) {
+            const uint64_t p0 = (static_cast<uint64_t>(kMultiplier0) * x[0]);
+            const uint64_t p1 = (static_cast<uint64_t>(kMultiplier1) * x[2]);
+            const uint32_t y0 = (static_cast<uint32_t>(p1 >> 32) ^ x[1] ^ k0);
+            const uint32_t y2 = (static_cast<uint32_t>(p0 >> 32) ^ x[3] ^ k1);
+            x[0] = y0; x[1] = static_cast<uint32_t>(p1);
+            x[2] = y2; x[3] = static_cast<uint32_t>(p0);
+            k0 += kWeyl0; k1 += kWeyl1;
+        }
+        for (uint32_t idx = 0; idx < 4; idx++) { block_[idx] = x[idx]; }
+        counter_++;
+        offset_ = 0;
+    }
+
+public:
+    explicit Philox4x32(const uint64_t key=0) { seed(key); }
+
+    /**
+     * Selects the stream with the given key, and rewinds it.
+     */
+    void seed(const uint64_t key) {
+        key_[0] = static_cast<uint32_t>(key);
+        key_[1] = static_cast<uint32_t>(key >> 32);
+        counter_ = 0;
+        offset_ = 4;
+    }
+
+    /**
+     * Returns the next 32-bit word in the stream.
+     */
+    result_type operator()() {
+        if (offset_ == 4) { generate(); }
+        return block_[offset_++];
+    }
+
+    // UniformRandomBitGenerator interface
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+};
+
+/**
+ * Helper function. Derives the seed for the given (sub-)stream of
+ * the given seed (using the SplitMix64 finalizer), e.g. to assign
+ * distinct streams to every replication or simulation component.
+ */
+inline uint64_t deriveSeed(const uint64_t seed, const uint64_t stream) {
+    uint64_t z = (seed + 0x9E3779B97F4A7C15ULL * (stream + 1));
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (z ^ (z >> 31));
+}
+
+#endif // COMMON_PHILOX_H
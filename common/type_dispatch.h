@@ -0,0 +1,44 @@
+#ifndef COMMON_TYPE_DISPATCH_H
+#define COMMON_TYPE_DISPATCH_H
+
+// STD headers
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+/**
+ * Tag representing a type (passed to TypeDispatcher callbacks).
+ */
+template<class T> struct TypeTag { typedef T type; };
+
+/**
+ * Dispatches on the dynamic type of an object. If the object's type
+ * is exactly one of Types, invokes the callback with the TypeTag of
+ * that type; else, invokes the fallback (with no arguments). This
+ * allows using the dynamic type to select a template specialization
+ * once (e.g., one in which calls to final classes are devirtualized),
+ * with a generic fallback for types that are unknown at compile-time.
+ */
+template<class Base, class... Types> struct TypeDispatcher;
+
+template<class Base> struct TypeDispatcher<Base> {
+    template<class F, class Fallback>
+    static auto dispatch(const Base&, F&&, Fallback&& fallback) {
+        return fallback();
+    }
+};
+
+template<class Base, class T, class... Types>
+struct TypeDispatcher<Base, T, Types...> {
+    static_assert(std::is_base_of<Base, T>::value,
+                  "Dispatched types must derive from Base");
+
+    template<class F, class Fallback>
+    static auto dispatch(const Base& obj, F&& f, Fallback&& fallback) {
+        if (typeid(obj) == typeid(T)) { return f(TypeTag<T>()); }
+        return TypeDispatcher<Base, Types...>::dispatch(
+            obj, std::forward<F>(f), std::forward<Fallback>(fallback));
+    }
+};
+
+#endif // COMMON_TYPE_DISPATCH_H
@@ -4,16 +4,22 @@
 // DPDK headers
 #include <rte_ether.h>
 #include <rte_ip.h>
+#include <rte_tcp.h>
 #include <rte_udp.h>
 
 /**
  * Traffic parameters.
  */
 // Packet size
-constexpr uint32_t kCommonPSize = (sizeof(struct rte_ether_hdr) +
-                                   sizeof(struct rte_ipv4_hdr) +
+constexpr uint32_t kL3HeaderSize = (sizeof(struct rte_ether_hdr) +
+                                    sizeof(struct rte_ipv4_hdr));
+
+constexpr uint32_t kCommonPSize = (kL3HeaderSize +
                                    sizeof(struct rte_udp_hdr));
 
+constexpr uint32_t kCommonTCPPSize = (kL3HeaderSize +
+                                      sizeof(struct rte_tcp_hdr));
+
 constexpr uint32_t kInnocentMaxPayloadSize = 1450;
 constexpr uint32_t kInnocentAvgPayloadSize = 1208;
 constexpr uint32_t kInnocentStdPayloadSize = 100;
@@ -36,8 +42,9 @@ constexpr uint32_t kInnocentStdJSizeInNs = 100;
 constexpr uint32_t kAttackJSizeInNs = 10000;
 
 // Packet parameters
-#define PAYLOAD_JSIZE_OFFSET    0
-#define PAYLOAD_CLASS_OFFSET    4
+#define PAYLOAD_JSIZE_OFFSET            0
+#define PAYLOAD_CLASS_OFFSET            4
+#define PAYLOAD_JSIZE_ACTUAL_OFFSET     8 // Written by the server
 enum PacketClass { ATTACK = 0, INNOCENT };
 
 /**
@@ -49,15 +56,50 @@ struct PacketParams {
     uint32_t psize_bytes; // Packet size (in bytes)
 };
 
+/**
+ * Returns the payload offset for the given packet mbuf. Packets
+ * carry either a UDP or a (option-less) TCP header.
+ */
+static inline uint32_t getPayloadOffset(rte_mbuf* mbuf) {
+    struct rte_ipv4_hdr* ip_hdr = rte_pktmbuf_mtod_offset(
+        mbuf, struct rte_ipv4_hdr*, sizeof(struct rte_ether_hdr));
+
+    return (ip_hdr->next_proto_id == IPPROTO_TCP) ?
+            kCommonTCPPSize : kCommonPSize;
+}
+
+/**
+ * Flow (5-tuple) identifier.
+ */
+struct FlowKey {
+    uint32_t src_ip; // Source IP
+    uint32_t dst_ip; // Destination IP
+    uint16_t src_port; // Source port
+    uint16_t dst_port; // Destination port
+    uint32_t protocol; // L4 protocol (padded)
+};
+
+/**
+ * Returns the flow key corresponding to the given packet mbuf.
+ * Note: Both UDP and TCP headers begin with the port numbers.
+ */
+static inline FlowKey getFlowKey(rte_mbuf* mbuf) {
+    struct rte_ipv4_hdr* ip_hdr = rte_pktmbuf_mtod_offset(
+        mbuf, struct rte_ipv4_hdr*, sizeof(struct rte_ether_hdr));
+
+    struct rte_udp_hdr* l4_hdr = rte_pktmbuf_mtod_offset(
+        mbuf, struct rte_udp_hdr*, kL3HeaderSize);
+
+    return FlowKey{ip_hdr->src_addr, ip_hdr->dst_addr, l4_hdr->src_port,
+                   l4_hdr->dst_port, ip_hdr->next_proto_id};
+}
+
 /**
  * Returns parameters corresponding to the given packet mbuf.
  */
 static inline PacketParams getPacketParams(rte_mbuf* mbuf) {
     char* payload = rte_pktmbuf_mtod_offset(
-        mbuf, char*,
-        (sizeof(struct rte_ether_hdr) +
-         sizeof(struct rte_ipv4_hdr) +
-         sizeof(struct rte_udp_hdr)));
+        mbuf, char*, getPayloadOffset(mbuf));
 
     // Fetch the job size and class
     uint32_t jsize_ns = rte_be_to_cpu_32(
@@ -70,4 +112,26 @@ static inline PacketParams getPacketParams(rte_mbuf* mbuf) {
     return PacketParams{class_tag, jsize_ns, mbuf->pkt_len};
 }
 
+/**
+ * Returns the actual job size (in ns) recorded for the given mbuf.
+ */
+static inline uint32_t getActualJobSize(rte_mbuf* mbuf) {
+    char* payload = rte_pktmbuf_mtod_offset(
+        mbuf, char*, getPayloadOffset(mbuf));
+
+    return rte_be_to_cpu_32(
+        *((uint32_t*) (payload + PAYLOAD_JSIZE_ACTUAL_OFFSET)));
+}
+
+/**
+ * Records the actual job size (in ns) for the given mbuf.
+ */
+static inline void setActualJobSize(rte_mbuf* mbuf, const uint32_t jsize_ns) {
+    char* payload = rte_pktmbuf_mtod_offset(
+        mbuf, char*, getPayloadOffset(mbuf));
+
+    *((uint32_t*) (payload + PAYLOAD_JSIZE_ACTUAL_OFFSET)) = (
+        rte_cpu_to_be_32(jsize_ns));
+}
+
 #endif // SCHEDULER_BENCHMARK_PACKET_H
@@ -0,0 +1,121 @@
+#include "flow_generator.h"
+
+// Library headers
+#include "common/philox.h"
+
+// STD headers
+#include <stdexcept>
+
+/**
+ * FlowGenerator implementation.
+ */
+FlowGenerator::FlowGenerator(const Parameters& params) :
+    kParams(params), flows_(params.num_flows),
+    flow_dist_(params.num_flows, params.zipf_alpha),
+    coin_(0, 1), isn_dist_(1, (1UL << 31)) {
+    if ((params.ooo_rate < 0) || (params.ooo_rate > 1) ||
+        (params.dup_rate < 0) || (params.dup_rate > 1)) {
+        throw std::invalid_argument("Rates must be in [0, 1]");
+    }
+    // Initialize the source ports. Flows are distinguished
+    // by source IP, connections (within a flow) by port.
+    for (uint32_t idx = 0; idx < params.num_flows; idx++) {
+        flows_[idx].src_port = params.src_port_base;
+    }
+}
+
+void FlowGenerator::seed(const uint64_t seed) {
+    flow_dist_.seed(deriveSeed(seed, kFlowStream));
+    coin_.seed(deriveSeed(seed, kCoinStream));
+    isn_dist_.seed(deriveSeed(seed, kISNStream));
+}
+
+Segment FlowGenerator::initSegment(
+    const uint32_t flow_idx, const uint16_t payload_size) const {
+    Segment segment{};
+    segment.src_ip = (kParams.src_ip_base + flow_idx);
+    segment.dst_ip = kParams.dst_ip;
+    segment.src_port = flows_[flow_idx].src_port;
+    segment.dst_port = kParams.dst_port;
+    segment.is_tcp = kParams.use_tcp;
+    segment.payload_size = payload_size;
+    return segment;
+}
+
+Segment FlowGenerator::nextDataSegment(
+    const uint32_t flow_idx, const uint16_t payload_size) {
+    FlowState& flow = flows_[flow_idx];
+    Segment segment = initSegment(flow_idx, payload_size);
+    segment.psn = flow.next_psn;
+
+    // Update the flow state
+    flow.next_psn += payload_size;
+    flow.num_sent++;
+    return segment;
+}
+
+Segment FlowGenerator::next(const uint16_t payload_size) {
+    const uint32_t flow_idx = static_cast<uint32_t>(
+        flow_dist_.sample()) - 1;
+
+    // Non-TCP traffic is stateless
+    if (!kParams.use_tcp) {
+        return initSegment(flow_idx, payload_size);
+    }
+    FlowState& flow = flows_[flow_idx];
+
+    // Open a new connection. Note: In order for the server to
+    // parse it, every packet (including SYN/FIN) carries data.
+    if (!flow.is_open) {
+        Segment segment = initSegment(flow_idx, payload_size);
+        segment.psn = static_cast<uint32_t>(isn_dist_.sample());
+        segment.flag_syn = true;
+
+        flow.is_open = true;
+        flow.num_sent = 0;
+        flow.has_last = false;
+        flow.next_psn = (segment.psn + 1 + payload_size);
+        num_connections_++;
+        return segment;
+    }
+    // Release a previously-withheld segment
+    else if (flow.has_held) {
+        flow.has_held = false;
+        flow.last = flow.held;
+        return flow.held;
+    }
+    // Retransmit the last data segment
+    else if (flow.has_last && (coin_.sample() < kParams.dup_rate)) {
+        num_duplicates_++;
+        return flow.last;
+    }
+    // Close the connection. The next connection on this
+    // flow uses a new source port (and a fresh ISN).
+    else if ((kParams.packets_per_flow != 0) &&
+             (flow.num_sent >= kParams.packets_per_flow)) {
+        Segment segment = initSegment(flow_idx, payload_size);
+        segment.psn = flow.next_psn;
+        segment.flag_fin = true;
+
+        flow.src_port++;
+        flow.is_open = false;
+        return segment;
+    }
+    // Generate a new data segment. To induce reordering, withhold
+    // it and transmit the subsequent one first. Both segments count
+    // against the connection's budget, so only swap if at least two
+    // segments remain.
+    const bool can_reorder = ((kParams.packets_per_flow == 0) ||
+        ((kParams.packets_per_flow - flow.num_sent) >= 2));
+
+    Segment segment = nextDataSegment(flow_idx, payload_size);
+    if (can_reorder && (coin_.sample() < kParams.ooo_rate)) {
+        flow.held = segment;
+        flow.has_held = true;
+        segment = nextDataSegment(flow_idx, payload_size);
+        num_out_of_order_++;
+    }
+    flow.last = segment;
+    flow.has_last = true;
+    return segment;
+}
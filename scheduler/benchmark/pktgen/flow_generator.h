@@ -0,0 +1,115 @@
+#ifndef SCHEDULER_BENCHMARK_PKTGEN_FLOW_GENERATOR_H
+#define SCHEDULER_BENCHMARK_PKTGEN_FLOW_GENERATOR_H
+
+// Library headers
+#include "common/distributions/uniform_distribution.h"
+#include "common/distributions/zipf_distribution.h"
+
+// STD headers
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Represents the L3/L4 header fields of a single packet.
+ */
+struct Segment {
+    uint32_t src_ip; // Source IP
+    uint32_t dst_ip; // Destination IP
+    uint16_t src_port; // Source port
+    uint16_t dst_port; // Destination port
+
+    // TCP header data (only valid if is_tcp is set)
+    bool is_tcp; // TCP segment?
+    bool flag_syn; // TCP SYN flag
+    bool flag_fin; // TCP FIN flag
+    uint32_t psn; // Packet sequence number
+    uint16_t payload_size; // Payload size (in bytes)
+};
+
+/**
+ * Generates packets for a set of concurrent flows. Flows are picked
+ * according to a Zipf popularity distribution. If TCP is enabled,
+ * each flow is a sequence of connections (SYN, data segments, FIN)
+ * with controllable rates of out-of-order and duplicate segments,
+ * mirroring the workload modeled by TCPReassembly in the simulator.
+ */
+class FlowGenerator {
+public:
+    // Generator parameters
+    struct Parameters {
+        uint32_t num_flows = 1; // Number of concurrent flows
+        double zipf_alpha = 0; // Flow popularity exponent
+        bool use_tcp = false; // Generate TCP segments?
+        double ooo_rate = 0; // Probability of reordering a segment
+        double dup_rate = 0; // Probability of duplicating a segment
+        uint32_t packets_per_flow = 0; // Data segments per connection
+                                       // (zero implies never closing)
+        uint32_t src_ip_base = 0; // Source IP of the first flow
+        uint32_t dst_ip = 0; // Destination IP (shared)
+        uint16_t src_port_base = 0; // Source port of the first connection
+        uint16_t dst_port = 0; // Destination port (shared)
+    };
+
+private:
+    /**
+     * Per-flow state.
+     */
+    struct FlowState {
+        bool is_open = false; // Connection established?
+        uint16_t src_port = 0; // Source port of the current connection
+        uint32_t next_psn = 0; // Next sequence number to use
+        uint32_t num_sent = 0; // Data segments sent on this connection
+        bool has_held = false; // Is a (reordered) segment pending?
+        bool has_last = false; // Has a data segment been sent?
+        Segment held; // Segment withheld to induce reordering
+        Segment last; // Last data segment (for duplicates)
+    };
+
+    // RNG stream IDs (relative to the generator's seed)
+    static constexpr uint64_t kFlowStream = 0;
+    static constexpr uint64_t kCoinStream = 1;
+    static constexpr uint64_t kISNStream = 2;
+
+    const Parameters kParams; // Generator parameters
+    std::vector<FlowState> flows_; // Flow index -> State
+    ZipfDistribution flow_dist_; // Flow popularity
+    UniformDistribution coin_; // U(0, 1), for reordering and duplicates
+    UniformDistribution isn_dist_; // Initial sequence numbers
+
+    // Housekeeping
+    uint64_t num_connections_ = 0; // Total SYNs generated
+    uint64_t num_duplicates_ = 0; // Total duplicates generated
+    uint64_t num_out_of_order_ = 0; // Total reordered segments
+
+    // Internal helper methods
+    Segment initSegment(const uint32_t flow_idx,
+                        const uint16_t payload_size) const;
+
+    Segment nextDataSegment(const uint32_t flow_idx,
+                            const uint16_t payload_size);
+
+public:
+    explicit FlowGenerator(const Parameters& params);
+
+    // Accessors
+    const Parameters& getParameters() const { return kParams; }
+    uint64_t getNumConnections() const { return num_connections_; }
+    uint64_t getNumDuplicates() const { return num_duplicates_; }
+    uint64_t getNumOutOfOrder() const { return num_out_of_order_; }
+
+    /**
+     * Seeds the generator. Each of its distributions is assigned
+     * an independent stream (derived from the given seed). Must
+     * be invoked before generating any packets.
+     */
+    void seed(const uint64_t seed);
+
+    /**
+     * Returns the headers for the next packet to transmit. The
+     * payload size is only used for newly-generated segments;
+     * reordered and duplicate segments retain their own size.
+     */
+    Segment next(const uint16_t payload_size);
+};
+
+#endif // SCHEDULER_BENCHMARK_PKTGEN_FLOW_GENERATOR_H
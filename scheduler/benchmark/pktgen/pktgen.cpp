@@ -1,14 +1,21 @@
 // Library headers
 #include "benchmark/packet.h"
 #include "common/distributions/normal_distribution.h"
+#include "common/philox.h"
 #include "common/tsc_clock.h"
+#include "flow_generator.h"
 
 // STD headers
+#include <cmath>
+#include <errno.h>
 #include <getopt.h>
 #include <iomanip>
 #include <iostream>
+#include <random>
 #include <signal.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <unordered_map>
 
@@ -20,6 +27,7 @@
 #include <rte_ip.h>
 #include <rte_lcore.h>
 #include <rte_mbuf.h>
+#include <rte_tcp.h>
 #include <rte_udp.h>
 
 // DPDK-related macros
@@ -41,8 +49,10 @@ static void signal_handler(int signum) {
 constexpr uint16_t src_port = 8091;
 constexpr uint16_t dst_port = 8091;
 
-// Source/destination IPs
+// Source/destination IPs. Each flow uses a distinct
+// source IP, starting at the base address per class.
 constexpr uint32_t src_ip = 171704321; // 10.60.0.1
+constexpr uint32_t src_ip_attack = 172359681; // 10.70.0.1
 constexpr uint32_t dst_ip = 171048961; // 10.50.0.1
 
 // Source/destination MACs
@@ -50,29 +60,61 @@ struct rte_ether_addr src_mac = {{0xb4, 0x96, 0x91, 0xa4, 0x02, 0xe9}};
 struct rte_ether_addr dst_mac = {{0xb4, 0x96, 0x91, 0xa4, 0x04, 0x21}};
 
 // Typedefs
-typedef std::unordered_map<uint16_t, uint16_t> PayloadSizeToIPChecksumMap;
+typedef std::unordered_map<uint32_t, uint16_t> IPLengthToPartialChecksumMap;
 
 #define CMD_OPT_HELP "help"
 #define CMD_OPT_RATE_ATTACK "rate-attack"
 #define CMD_OPT_RATE_INNOCENT "rate-innocent"
+#define CMD_OPT_FLOWS "flows"
+#define CMD_OPT_ATTACK_FLOWS "attack-flows"
+#define CMD_OPT_ZIPF "zipf"
+#define CMD_OPT_TCP "tcp"
+#define CMD_OPT_FLOW_PACKETS "flow-packets"
+#define CMD_OPT_OOO_RATE "ooo-rate"
+#define CMD_OPT_DUP_RATE "dup-rate"
+#define CMD_OPT_SEED "seed"
 enum {
     /* long options mapped to short options: first long only option value must
     * be >= 256, so that it does not conflict with short options.
     */
     CMD_OPT_HELP_NUM = 256,
     CMD_OPT_RATE_ATTACK_NUM,
-    CMD_OPT_RATE_INNOCENT_NUM
+    CMD_OPT_RATE_INNOCENT_NUM,
+    CMD_OPT_FLOWS_NUM,
+    CMD_OPT_ATTACK_FLOWS_NUM,
+    CMD_OPT_ZIPF_NUM,
+    CMD_OPT_TCP_NUM,
+    CMD_OPT_FLOW_PACKETS_NUM,
+    CMD_OPT_OOO_RATE_NUM,
+    CMD_OPT_DUP_RATE_NUM,
+    CMD_OPT_SEED_NUM
 };
 
 static void print_usage(const char* program_name) {
     printf("%s [EAL options] --"
         " [--help] |\n"
         " [--rate-attack RATE_ATTACK]\n"
-        " [--rate-innocent RATE_INNOCENT]\n\n"
+        " [--rate-innocent RATE_INNOCENT]\n"
+        " [--flows NUM_FLOWS]\n"
+        " [--attack-flows NUM_ATTACK_FLOWS]\n"
+        " [--zipf ALPHA]\n"
+        " [--tcp]\n"
+        " [--flow-packets NUM_PACKETS]\n"
+        " [--ooo-rate OOO_RATE]\n"
+        " [--dup-rate DUP_RATE]\n"
+        " [--seed SEED]\n\n"
 
         "  --help: Show this help and exit\n"
         "  --rate-attack RATE_ATTACK: Rate (in Gbps) of attack traffic\n"
-        "  --rate-innocent RATE_INNOCENT: Rate (in Gbps) of innocent traffic\n",
+        "  --rate-innocent RATE_INNOCENT: Rate (in Gbps) of innocent traffic\n"
+        "  --flows NUM_FLOWS: Number of concurrent innocent flows (default: 1)\n"
+        "  --attack-flows NUM_ATTACK_FLOWS: Number of concurrent attack flows (default: 1)\n"
+        "  --zipf ALPHA: Zipf exponent for flow popularity (default: 0, uniform)\n"
+        "  --tcp: Send innocent traffic as TCP segments (default: UDP)\n"
+        "  --flow-packets NUM_PACKETS: Data segments per TCP connection (default: 0, never close)\n"
+        "  --ooo-rate OOO_RATE: Probability of reordering a TCP segment, in [0, 1] (default: 0)\n"
+        "  --dup-rate DUP_RATE: Probability of duplicating a TCP segment, in [0, 1] (default: 0)\n"
+        "  --seed SEED: Base RNG seed (default: random)\n",
         program_name);
 }
 
@@ -83,6 +125,14 @@ static const struct option long_options[] = {
     {CMD_OPT_HELP, no_argument, NULL, CMD_OPT_HELP_NUM},
     {CMD_OPT_RATE_ATTACK, required_argument, NULL, CMD_OPT_RATE_ATTACK_NUM},
     {CMD_OPT_RATE_INNOCENT, required_argument, NULL, CMD_OPT_RATE_INNOCENT_NUM},
+    {CMD_OPT_FLOWS, required_argument, NULL, CMD_OPT_FLOWS_NUM},
+    {CMD_OPT_ATTACK_FLOWS, required_argument, NULL, CMD_OPT_ATTACK_FLOWS_NUM},
+    {CMD_OPT_ZIPF, required_argument, NULL, CMD_OPT_ZIPF_NUM},
+    {CMD_OPT_TCP, no_argument, NULL, CMD_OPT_TCP_NUM},
+    {CMD_OPT_FLOW_PACKETS, required_argument, NULL, CMD_OPT_FLOW_PACKETS_NUM},
+    {CMD_OPT_OOO_RATE, required_argument, NULL, CMD_OPT_OOO_RATE_NUM},
+    {CMD_OPT_DUP_RATE, required_argument, NULL, CMD_OPT_DUP_RATE_NUM},
+    {CMD_OPT_SEED, required_argument, NULL, CMD_OPT_SEED_NUM},
     {0, 0, 0, 0}
 };
 
@@ -90,6 +140,9 @@ static const struct option long_options[] = {
 struct cl_arguments {
     double attack_rate_gbps;
     double innocent_rate_gbps;
+    FlowGenerator::Parameters attack_flows;
+    FlowGenerator::Parameters innocent_flows;
+    uint64_t seed;
 };
 
 // Worker configuration
@@ -98,12 +151,21 @@ struct worker_conf {
     uint16_t class_tag;
     double tx_rate_gbps;
     uint32_t avg_psize_bytes;
+    FlowGenerator::Parameters flow_params;
+    uint64_t seed;
 
     worker_conf(rte_mempool* pool, uint16_t class_tag, double rate_gbps,
-                uint32_t avg_psize_bytes) : pool(pool), class_tag(class_tag),
-                tx_rate_gbps(rate_gbps), avg_psize_bytes(avg_psize_bytes) {}
+                uint32_t avg_psize_bytes, const FlowGenerator::Parameters&
+                flow_params, uint64_t seed) : pool(pool), class_tag(class_tag),
+                tx_rate_gbps(rate_gbps), avg_psize_bytes(avg_psize_bytes),
+                flow_params(flow_params), seed(seed) {}
 };
 
+// RNG stream IDs (relative to each worker's seed)
+constexpr uint64_t kPSizeStream = 0;
+constexpr uint64_t kJSizeStream = 1;
+constexpr uint64_t kFlowGenStream = 2;
+
 /**
  * Given a desired throughput and (expected) packet size,
  * computes the number of TSC ticks per packet burst.
@@ -145,20 +207,12 @@ generate_template_packet(struct rte_mempool* pool) {
     ip_hdr->packet_id = 0;
     ip_hdr->fragment_offset = 0;
     ip_hdr->time_to_live   = 64;
-    ip_hdr->next_proto_id = IPPROTO_UDP;
+    ip_hdr->next_proto_id = IPPROTO_UDP; // Parameter
     ip_hdr->hdr_checksum = 0; // Parameter
-    ip_hdr->src_addr = rte_cpu_to_be_32(src_ip);
-    ip_hdr->dst_addr = rte_cpu_to_be_32(dst_ip);
-
-    // Initialize the UDP header
-    struct rte_udp_hdr* udp_hdr = (struct rte_udp_hdr*) (
-        ((char*) ip_hdr) + sizeof(struct rte_ipv4_hdr));
-
-    udp_hdr->src_port = rte_cpu_to_be_16(src_port);
-    udp_hdr->dst_port = rte_cpu_to_be_16(dst_port);
-    udp_hdr->dgram_len = 0; // Parameter
-    udp_hdr->dgram_cksum = 0; // Unused
+    ip_hdr->src_addr = 0; // Parameter
+    ip_hdr->dst_addr = 0; // Parameter
 
+    // Note: The L4 header is populated per-packet
     return mbuf;
 }
 
@@ -174,43 +228,104 @@ clone_template_packet(struct rte_mempool* pool,
 
     char* src = ((char*) template_packet->buf_addr) + template_packet->data_off;
     char* dst = ((char*) mbuf->buf_addr) + mbuf->data_off;
-    memcpy(dst, src, kCommonPSize);
+    memcpy(dst, src, kL3HeaderSize);
     return mbuf;
 }
 
 /**
- * Updates packet headers based on the given payload size.
+ * Returns the IPv4 header checksum. Since the source and destination
+ * addresses vary across flows, we memoize the (one's complement) sum
+ * over the remaining header fields (keyed by length and protocol),
+ * then fold in the addresses for each packet.
  */
-static inline void
-update_headers(struct rte_mbuf* mbuf,
-               uint16_t payload_size,
-               PayloadSizeToIPChecksumMap& csum_map) {
+static inline uint16_t
+compute_ipv4_checksum(struct rte_ipv4_hdr* ip_hdr,
+                      IPLengthToPartialChecksumMap& csum_map) {
+    const uint32_t key = ((uint32_t(ip_hdr->total_length) << 8) |
+                          ip_hdr->next_proto_id);
+    uint32_t sum = 0;
+
+    // If required, compute and memoize the partial sum
+    auto iter = csum_map.find(key);
+    if (iter == csum_map.end()) {
+        const uint32_t src_addr = ip_hdr->src_addr;
+        const uint32_t dst_addr = ip_hdr->dst_addr;
+        ip_hdr->src_addr = 0;
+        ip_hdr->dst_addr = 0;
 
-    // Fetch the IPv4 and UDP headers
-    struct rte_ipv4_hdr* ip_hdr = rte_pktmbuf_mtod_offset(
-        mbuf, struct rte_ipv4_hdr*, sizeof(struct rte_ether_hdr));
+        sum = (uint16_t) ~rte_ipv4_cksum(ip_hdr);
+        csum_map[key] = sum;
+
+        ip_hdr->src_addr = src_addr;
+        ip_hdr->dst_addr = dst_addr;
+    }
+    // Else, use the precomputed partial sum
+    else { sum = iter->second; }
 
-    struct rte_udp_hdr* udp_hdr = (struct rte_udp_hdr*) (
-        ((char*) ip_hdr) + sizeof(struct rte_ipv4_hdr));
+    // Fold in the source and destination addresses
+    sum += ((ip_hdr->src_addr & 0xFFFF) + (ip_hdr->src_addr >> 16) +
+            (ip_hdr->dst_addr & 0xFFFF) + (ip_hdr->dst_addr >> 16));
 
-    // Compute and update the UDP length
-    uint16_t udp_len = payload_size + sizeof(struct rte_udp_hdr);
-    udp_hdr->dgram_len = udp_len;
+    sum = ((sum >> 16) + (sum & 0xFFFF));
+    sum += (sum >> 16);
+    const uint16_t checksum = (uint16_t) sum;
+    return (checksum == 0xFFFF) ? checksum : (uint16_t) ~checksum;
+}
 
-    // Compute and update the IPv4 length and checksum
-    uint16_t ip_len = udp_len + sizeof(struct rte_ipv4_hdr);
-    ip_hdr->total_length = ip_len;
-    uint16_t ip_checksum = 0;
+/**
+ * Updates packet headers based on the given segment. Returns
+ * the offset (from the start of the packet) of the payload.
+ */
+static inline uint32_t
+update_headers(struct rte_mbuf* mbuf,
+               const Segment& segment,
+               IPLengthToPartialChecksumMap& csum_map) {
 
-    // If required, compute and memoize the checksum
-    auto iter = csum_map.find(ip_len);
-    if (iter == csum_map.end()) {
-        ip_checksum = rte_ipv4_cksum(ip_hdr);
-        csum_map[ip_len] = ip_checksum;
+    // Fetch the IPv4 and L4 headers
+    struct rte_ipv4_hdr* ip_hdr = rte_pktmbuf_mtod_offset(
+        mbuf, struct rte_ipv4_hdr*, sizeof(struct rte_ether_hdr));
+
+    char* l4_hdr = ((char*) ip_hdr) + sizeof(struct rte_ipv4_hdr);
+    uint16_t l4_len = 0;
+
+    // Populate the TCP header
+    if (segment.is_tcp) {
+        struct rte_tcp_hdr* tcp_hdr = (struct rte_tcp_hdr*) l4_hdr;
+        l4_len = segment.payload_size + sizeof(struct rte_tcp_hdr);
+
+        tcp_hdr->src_port = rte_cpu_to_be_16(segment.src_port);
+        tcp_hdr->dst_port = rte_cpu_to_be_16(segment.dst_port);
+        tcp_hdr->sent_seq = rte_cpu_to_be_32(segment.psn);
+        tcp_hdr->recv_ack = 0;
+        tcp_hdr->data_off = ((sizeof(struct rte_tcp_hdr) / 4) << 4);
+        tcp_hdr->tcp_flags = (RTE_TCP_ACK_FLAG |
+            (segment.flag_syn ? RTE_TCP_SYN_FLAG : 0) |
+            (segment.flag_fin ? RTE_TCP_FIN_FLAG : 0));
+
+        tcp_hdr->rx_win = rte_cpu_to_be_16(0xFFFF);
+        tcp_hdr->cksum = 0; // Unused
+        tcp_hdr->tcp_urp = 0;
+        ip_hdr->next_proto_id = IPPROTO_TCP;
+    }
+    // Populate the UDP header
+    else {
+        struct rte_udp_hdr* udp_hdr = (struct rte_udp_hdr*) l4_hdr;
+        l4_len = segment.payload_size + sizeof(struct rte_udp_hdr);
+
+        udp_hdr->src_port = rte_cpu_to_be_16(segment.src_port);
+        udp_hdr->dst_port = rte_cpu_to_be_16(segment.dst_port);
+        udp_hdr->dgram_len = l4_len;
+        udp_hdr->dgram_cksum = 0; // Unused
+        ip_hdr->next_proto_id = IPPROTO_UDP;
     }
-    // Else, use the precomputed checksum
-    else { ip_checksum = iter->second; }
-    ip_hdr->hdr_checksum = ip_checksum;
+    // Update the IPv4 addresses, length, and checksum
+    ip_hdr->src_addr = rte_cpu_to_be_32(segment.src_ip);
+    ip_hdr->dst_addr = rte_cpu_to_be_32(segment.dst_ip);
+    ip_hdr->total_length = l4_len + sizeof(struct rte_ipv4_hdr);
+    ip_hdr->hdr_checksum = 0;
+    ip_hdr->hdr_checksum = compute_ipv4_checksum(ip_hdr, csum_map);
+
+    return (segment.is_tcp ? kCommonTCPPSize : kCommonPSize);
 }
 
 /**
@@ -219,22 +334,25 @@ update_headers(struct rte_mbuf* mbuf,
 static inline struct rte_mbuf*
 generate_attack_packet(struct rte_mempool* pool,
                        struct rte_mbuf* template_packet,
-                       PayloadSizeToIPChecksumMap& csum_map) {
+                       FlowGenerator& flow_gen,
+                       IPLengthToPartialChecksumMap& csum_map) {
     // Allocate a clone of the template packet, then update headers
     rte_mbuf* mbuf = clone_template_packet(pool, template_packet);
     if (unlikely(mbuf == NULL)) { return NULL; }
-    update_headers(mbuf, kAttackPayloadSize, csum_map);
+    const Segment segment = flow_gen.next(kAttackPayloadSize);
+    const uint32_t offset = update_headers(mbuf, segment, csum_map);
 
     // Write the payload
-    char* payload = rte_pktmbuf_mtod_offset(mbuf, char*, kCommonPSize);
+    char* payload = rte_pktmbuf_mtod_offset(mbuf, char*, offset);
     *((uint32_t*) (payload + PAYLOAD_JSIZE_OFFSET)) = (
         rte_cpu_to_be_32(kAttackJSizeInNs));
 
     *((uint8_t*) (payload + PAYLOAD_CLASS_OFFSET)) = PacketClass::ATTACK;
 
     // Set the mbuf parameters
-    mbuf->pkt_len = kAttackPSizeInBytes;
-    mbuf->data_len = kAttackPSizeInBytes;
+    const uint32_t psize = (offset + segment.payload_size);
+    mbuf->pkt_len = psize;
+    mbuf->data_len = psize;
 
     return mbuf;
 }
@@ -247,27 +365,64 @@ generate_innocent_packet(struct rte_mempool* pool,
                          const uint32_t job_size_ns,
                          const uint32_t payload_size,
                          struct rte_mbuf* template_packet,
-                         PayloadSizeToIPChecksumMap& csum_map) {
+                         FlowGenerator& flow_gen,
+                         IPLengthToPartialChecksumMap& csum_map) {
     // Allocate a clone of the template packet, then update headers
     rte_mbuf* mbuf = clone_template_packet(pool, template_packet);
     if (unlikely(mbuf == NULL)) { return NULL; }
-    update_headers(mbuf, payload_size, csum_map);
+    const Segment segment = flow_gen.next(payload_size);
+    const uint32_t offset = update_headers(mbuf, segment, csum_map);
 
     // Write the payload
-    char* payload = rte_pktmbuf_mtod_offset(mbuf, char*, kCommonPSize);
+    char* payload = rte_pktmbuf_mtod_offset(mbuf, char*, offset);
     *((uint32_t*) (payload + PAYLOAD_JSIZE_OFFSET)) = (
         rte_cpu_to_be_32(job_size_ns));
 
     *((uint8_t*) (payload + PAYLOAD_CLASS_OFFSET)) = PacketClass::INNOCENT;
 
-    // Set the packet parameters
-    const uint32_t psize = (kCommonPSize + payload_size);
+    // Set the packet parameters. Note: Reordered or duplicate
+    // segments retain their original payload size.
+    const uint32_t psize = (offset + segment.payload_size);
     mbuf->data_len = psize;
     mbuf->pkt_len = psize;
 
     return mbuf;
 }
 
+/**
+ * Helper functions. Parse a numeric command-line argument,
+ * returning 0 on success (and -1 if the value is malformed
+ * or out of range).
+ */
+static int parse_uint64(const char* arg, uint64_t& value) {
+    char* end = NULL;
+    errno = 0;
+    // Note: strtoull silently negates negative inputs
+    if (strchr(arg, '-') != NULL) { return -1; }
+    const unsigned long long parsed = strtoull(arg, &end, 10);
+    if ((errno != 0) || (end == arg) || (*end != '\0')) { return -1; }
+    value = parsed;
+    return 0;
+}
+
+static int parse_uint32(const char* arg, uint32_t& value) {
+    uint64_t parsed;
+    if ((parse_uint64(arg, parsed) != 0) ||
+        (parsed > UINT32_MAX)) { return -1; }
+    value = (uint32_t) parsed;
+    return 0;
+}
+
+static int parse_double(const char* arg, double& value) {
+    char* end = NULL;
+    errno = 0;
+    const double parsed = strtod(arg, &end);
+    if ((errno != 0) || (end == arg) || (*end != '\0') ||
+        !std::isfinite(parsed)) { return -1; }
+    value = parsed;
+    return 0;
+}
+
 /**
  * Returns the parsed command-line arguments.
  */
@@ -278,6 +433,14 @@ int get_cl_arguments(int argc, char** argv,
 
     cl_args.attack_rate_gbps = 0;
     cl_args.innocent_rate_gbps = 0;
+    cl_args.attack_flows = FlowGenerator::Parameters();
+    cl_args.innocent_flows = FlowGenerator::Parameters();
+
+    std::random_device rd; // Default seed
+    cl_args.seed = ((static_cast<uint64_t>(rd()) << 32) | rd());
+
+    FlowGenerator::Parameters& attack = cl_args.attack_flows;
+    FlowGenerator::Parameters& innocent = cl_args.innocent_flows;
 
     while ((opt = getopt_long(argc, argv, short_options,
                     long_options, &long_index)) != EOF) {
@@ -286,11 +449,44 @@ int get_cl_arguments(int argc, char** argv,
                 return 1;
             }
             case CMD_OPT_RATE_ATTACK_NUM: {
-                cl_args.attack_rate_gbps = atof(optarg);
+                if (parse_double(optarg, cl_args.attack_rate_gbps)) { return -1; }
                 break;
             }
             case CMD_OPT_RATE_INNOCENT_NUM: {
-                cl_args.innocent_rate_gbps = atof(optarg);
+                if (parse_double(optarg, cl_args.innocent_rate_gbps)) { return -1; }
+                break;
+            }
+            case CMD_OPT_FLOWS_NUM: {
+                if (parse_uint32(optarg, innocent.num_flows)) { return -1; }
+                break;
+            }
+            case CMD_OPT_ATTACK_FLOWS_NUM: {
+                if (parse_uint32(optarg, attack.num_flows)) { return -1; }
+                break;
+            }
+            case CMD_OPT_ZIPF_NUM: {
+                if (parse_double(optarg, innocent.zipf_alpha)) { return -1; }
+                attack.zipf_alpha = innocent.zipf_alpha;
+                break;
+            }
+            case CMD_OPT_TCP_NUM: {
+                innocent.use_tcp = true;
+                break;
+            }
+            case CMD_OPT_FLOW_PACKETS_NUM: {
+                if (parse_uint32(optarg, innocent.packets_per_flow)) { return -1; }
+                break;
+            }
+            case CMD_OPT_OOO_RATE_NUM: {
+                if (parse_double(optarg, innocent.ooo_rate)) { return -1; }
+                break;
+            }
+            case CMD_OPT_DUP_RATE_NUM: {
+                if (parse_double(optarg, innocent.dup_rate)) { return -1; }
+                break;
+            }
+            case CMD_OPT_SEED_NUM: {
+                if (parse_uint64(optarg, cl_args.seed)) { return -1; }
                 break;
             }
             default: {
@@ -298,7 +494,21 @@ int get_cl_arguments(int argc, char** argv,
             }
         }
     }
-
+    // Validate the traffic rates
+    if ((cl_args.attack_rate_gbps < 0) ||
+        (cl_args.innocent_rate_gbps < 0)) {
+        return -1;
+    }
+    // Validate the flow configuration
+    if (attack.num_flows == 0 || innocent.num_flows == 0) {
+        return -1;
+    }
+    // Validate the Zipf exponent, and the reordering and duplication rates
+    if ((innocent.zipf_alpha < 0) ||
+        !((innocent.ooo_rate >= 0) && (innocent.ooo_rate <= 1)) ||
+        !((innocent.dup_rate >= 0) && (innocent.dup_rate <= 1))) {
+        return -1;
+    }
     return 0;
 }
 
@@ -409,7 +619,17 @@ lcore_worker(void* arg) {
                                   kInnocentStdJSizeInNs, 0,
                                   (2 * kInnocentAvgJSizeInNs));
 
-    PayloadSizeToIPChecksumMap ip_csum_map; // Payload size -> IPv4 checksum
+    FlowGenerator flow_gen(conf->flow_params); // Flow headers
+
+    // Seed the RNG streams. Every (lcore, role) pair is assigned
+    // an independent stream, so the generated traffic differs
+    // across lcores, but is reproducible for a given seed.
+    const uint64_t seed = deriveSeed(conf->seed, rte_lcore_id());
+    psize_dist.seed(deriveSeed(seed, kPSizeStream));
+    jsize_dist.seed(deriveSeed(seed, kJSizeStream));
+    flow_gen.seed(deriveSeed(seed, kFlowGenStream));
+
+    IPLengthToPartialChecksumMap ip_csum_map; // IPv4 length -> Partial checksum
     struct rte_mbuf* template_packet = generate_template_packet(conf->pool);
 
     // Rate control
@@ -424,11 +644,13 @@ lcore_worker(void* arg) {
         // Generate a burst of packets
         for (unsigned i = 0; i < BURST_SIZE; i++) {
             mbufs[i] = is_attack ?
-                generate_attack_packet(conf->pool, template_packet, ip_csum_map) :
+                generate_attack_packet(conf->pool, template_packet,
+                                       flow_gen, ip_csum_map) :
                 generate_innocent_packet(conf->pool,
                                          (uint32_t) jsize_dist.sample(),
                                          (uint32_t) psize_dist.sample(),
-                                         template_packet, ip_csum_map);
+                                         template_packet, flow_gen,
+                                         ip_csum_map);
 
             total_psize_bytes += mbufs[i]->pkt_len;
         }
@@ -459,6 +681,15 @@ lcore_worker(void* arg) {
     std::cout << "Packet type: " << class_tag << std::endl;
     std::cout << "Ticks per burst: " << ticks_per_burst << std::endl;
     std::cout << "Number of TX packets: " << num_total_tx << std::endl;
+    std::cout << "Number of flows: " << conf->flow_params.num_flows << std::endl;
+    if (conf->flow_params.use_tcp) {
+        std::cout << "Number of TCP connections: "
+                  << flow_gen.getNumConnections() << std::endl;
+        std::cout << "Number of reordered segments: "
+                  << flow_gen.getNumOutOfOrder() << std::endl;
+        std::cout << "Number of duplicate segments: "
+                  << flow_gen.getNumDuplicates() << std::endl;
+    }
 
     std::cout << "Total time elapsed: "
               << std::fixed << std::setprecision(2)
@@ -501,6 +732,8 @@ int main(int argc, char *argv[]) {
     if (rte_lcore_count() != 3) {
         rte_exit(EXIT_FAILURE, "Error: lcore_count must be 3\n");
     }
+    // Report the seed, so that the run can be reproduced
+    std::cout << "Seed: " << cl_args.seed << std::endl;
 
     unsigned mbuf_entries = (MBUF_CACHE_SIZE +
                              (3 * BURST_SIZE) +
@@ -518,15 +751,33 @@ int main(int argc, char *argv[]) {
     if (port_init(0, mbuf_pool))
         rte_exit(EXIT_FAILURE, "Cannot init port %" PRIu16 "\n", 0);
 
+    // Flow configurations
+    FlowGenerator::Parameters& attack_flows = cl_args.attack_flows;
+    attack_flows.src_ip_base = src_ip_attack;
+    attack_flows.src_port_base = src_port;
+    attack_flows.dst_ip = dst_ip;
+    attack_flows.dst_port = dst_port;
+
+    FlowGenerator::Parameters& innocent_flows = cl_args.innocent_flows;
+    innocent_flows.src_ip_base = src_ip;
+    innocent_flows.src_port_base = src_port;
+    innocent_flows.dst_ip = dst_ip;
+    innocent_flows.dst_port = dst_port;
+
+    // TCP headers are larger than UDP headers
+    const uint32_t innocent_avg_psize = (
+        kInnocentAvgPSizeInBytes + (innocent_flows.use_tcp ?
+            (kCommonTCPPSize - kCommonPSize) : 0));
+
     // Create the configurations
     worker_conf* confs[2];
     confs[PacketClass::ATTACK] = new worker_conf(mbuf_pool,
         PacketClass::ATTACK, cl_args.attack_rate_gbps,
-        kAttackPSizeInBytes);
+        kAttackPSizeInBytes, attack_flows, cl_args.seed);
 
     confs[PacketClass::INNOCENT] = new worker_conf(mbuf_pool,
         PacketClass::INNOCENT, cl_args.innocent_rate_gbps,
-        kInnocentAvgPSizeInBytes);
+        innocent_avg_psize, innocent_flows, cl_args.seed);
 
     // Run the worker process
     unsigned idx = 0;
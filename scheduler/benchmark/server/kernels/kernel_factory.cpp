@@ -0,0 +1,34 @@
+#include "kernel_factory.h"
+
+// Library headers
+#include "kernel_hash_lookup.h"
+#include "kernel_string_match.h"
+#include "kernel_tcp_reassembly.h"
+
+// STD headers
+#include <stdexcept>
+
+NFKernel* NFKernelFactory::generate(
+    const std::string& type, const NFKernel::Parameters& params) {
+    NFKernel* kernel = nullptr;
+
+    // Emulated job sizes
+    if (type == "none") {}
+    // Multi-pattern string matching
+    else if (type == KernelStringMatch::name()) {
+        kernel = new KernelStringMatch();
+    }
+    // Hash table lookups
+    else if (type == KernelHashLookup::name()) {
+        kernel = new KernelHashLookup(params.collision_rate);
+    }
+    // TCP reassembly
+    else if (type == KernelTCPReassembly::name()) {
+        kernel = new KernelTCPReassembly();
+    }
+    // Unknown kernel
+    else { throw std::runtime_error(
+        "Unknown NF kernel: " + type + "."); }
+
+    return kernel;
+}
@@ -0,0 +1,24 @@
+#ifndef SCHEDULER_BENCHMARK_SERVER_KERNELS_KERNEL_FACTORY_H
+#define SCHEDULER_BENCHMARK_SERVER_KERNELS_KERNEL_FACTORY_H
+
+// Library headers
+#include "nf_kernel.h"
+
+// STD headers
+#include <string>
+
+/**
+ * Factory class for instantiating NF kernels.
+ */
+class NFKernelFactory final {
+public:
+    /**
+     * Returns the NF kernel corresponding to the given type,
+     * or nullptr if job sizes should be emulated ("none").
+     * @throw runtime error if the type is unknown.
+     */
+    static NFKernel* generate(const std::string& type,
+                              const NFKernel::Parameters& params);
+};
+
+#endif // SCHEDULER_BENCHMARK_SERVER_KERNELS_KERNEL_FACTORY_H
@@ -0,0 +1,65 @@
+#include "kernel_hash_lookup.h"
+
+// Library headers
+#include "benchmark/packet.h"
+
+// STD headers
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+// DPDK headers
+#include <rte_hash_crc.h>
+
+/**
+ * KernelHashLookup implementation.
+ */
+KernelHashLookup::KernelHashLookup(const double collision_rate) :
+    NFKernel(name()), kCollisionThreshold(static_cast<uint32_t>(
+        collision_rate * static_cast<double>(UINT32_MAX))),
+    buckets_(kNumBuckets, kInvalidIdx), entries_(kNumEntries) {
+    if ((collision_rate < 0) || (collision_rate > 1)) {
+        throw std::invalid_argument("Collision rate must be in [0, 1]");
+    }
+    // Populate the table with random keys. Note: We index the
+    // entries randomly (rather than sequentially) so that the
+    // chains are not laid out contiguously in memory.
+    std::mt19937_64 generator(0);
+    std::vector<uint32_t> order(kNumEntries);
+    for (uint32_t idx = 0; idx < kNumEntries; idx++) { order[idx] = idx; }
+    std::shuffle(order.begin(), order.end(), generator);
+
+    const uint32_t num_colliding = static_cast<uint32_t>(
+        collision_rate * kNumEntries);
+
+    for (uint32_t idx = 0; idx < kNumEntries; idx++) {
+        Entry& entry = entries_[order[idx]];
+        entry.key = generator();
+        entry.value = idx;
+
+        // The first few entries collide in bucket 0
+        const uint32_t bucket = (idx < num_colliding) ? 0 :
+            getBucket(rte_hash_crc(&entry.key, sizeof(entry.key), 0));
+
+        entry.next = buckets_[bucket];
+        buckets_[bucket] = order[idx];
+    }
+}
+
+void KernelHashLookup::process(rte_mbuf* mbuf) {
+    const FlowKey flow_key = getFlowKey(mbuf);
+    const uint32_t hash = rte_hash_crc(&flow_key, sizeof(flow_key), 0);
+    const uint64_t key = ((static_cast<uint64_t>(hash) << 32) |
+                          rte_hash_crc(&flow_key, sizeof(flow_key), hash));
+
+    // Walk the chain (flows are typically absent from the table)
+    uint64_t value = 0;
+    for (uint32_t idx = buckets_[getBucket(hash)];
+         idx != kInvalidIdx; idx = entries_[idx].next) {
+        if (entries_[idx].key == key) {
+            value = entries_[idx].value;
+            break;
+        }
+    }
+    sink_ += value;
+}
@@ -0,0 +1,66 @@
+#ifndef SCHEDULER_BENCHMARK_SERVER_KERNELS_KERNEL_HASH_LOOKUP_H
+#define SCHEDULER_BENCHMARK_SERVER_KERNELS_KERNEL_HASH_LOOKUP_H
+
+// Library headers
+#include "nf_kernel.h"
+
+// STD headers
+#include <string>
+#include <vector>
+
+/**
+ * Per-packet lookups into a chained hash table (as performed by,
+ * e.g., NAT or connection-tracking NFs), keyed by the 5-tuple.
+ *
+ * The collision rate (c) models a hash-flooding attack: a fraction
+ * c of the table's entries are forced into a single bucket, and a
+ * fraction c of flows (those whose hash falls below a threshold)
+ * are directed to that bucket, walking its chain in its entirety.
+ * Use many flows (pktgen's --flows) to realize the target rate.
+ */
+class KernelHashLookup final : public NFKernel {
+private:
+    // Table configuration
+    static constexpr uint32_t kNumBuckets = (1 << 16);
+    static constexpr uint32_t kNumEntries = (1 << 16);
+    static constexpr uint32_t kInvalidIdx = UINT32_MAX;
+
+    /**
+     * Represents a single hash table entry.
+     */
+    struct Entry {
+        uint64_t key = 0; // Lookup key
+        uint64_t value = 0; // Associated value
+        uint32_t next = kInvalidIdx; // Next entry in the chain
+    };
+
+    const uint32_t kCollisionThreshold; // Hash threshold for collisions
+                                        // (i.e., the fraction of colliding
+                                        // lookups, scaled to UINT32_MAX)
+    std::vector<uint32_t> buckets_; // Bucket -> Head entry index
+    std::vector<Entry> entries_; // Entry pool
+
+    /**
+     * Internal helper method. Returns the bucket for the given hash.
+     */
+    inline uint32_t getBucket(const uint32_t hash) const {
+        return (hash < kCollisionThreshold) ?
+            0 : (1 + (hash % (kNumBuckets - 1)));
+    }
+
+public:
+    explicit KernelHashLookup(const double collision_rate);
+    virtual ~KernelHashLookup() {}
+
+    /**
+     * Kernel name.
+     */
+    static std::string name() { return "hash_lookup"; }
+
+    /**
+     * Looks up the packet's 5-tuple in the hash table.
+     */
+    virtual void process(rte_mbuf* mbuf) override;
+};
+
+#endif // SCHEDULER_BENCHMARK_SERVER_KERNELS_KERNEL_HASH_LOOKUP_H
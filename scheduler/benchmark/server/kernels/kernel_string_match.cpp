@@ -0,0 +1,90 @@
+#include "kernel_string_match.h"
+
+// Library headers
+#include "benchmark/packet.h"
+
+// STD headers
+#include <queue>
+
+// A representative set of (IDS-style) signatures
+static const std::vector<std::string> kDefaultPatterns = {
+    "GET /", "POST /", "HTTP/1.", "Host: ", "User-Agent: ", "Cookie: ",
+    "/etc/passwd", "/bin/sh", "cmd.exe", "<script>", "javascript:",
+    "SELECT ", "UNION ", "DROP TABLE", "' OR '1'='1", "../../",
+    "%00", "\\x90\\x90\\x90\\x90", "wget ", "curl ", "base64_decode",
+    "eval(", "exec(", "system(", "powershell", "nc -e", "/dev/tcp/",
+    "Content-Length: ", "Transfer-Encoding: chunked", "Authorization: ",
+    "\x90\x90\x90\x90", "AAAAAAAA",
+};
+
+/**
+ * KernelStringMatch implementation.
+ */
+KernelStringMatch::KernelStringMatch() : NFKernel(name()) {
+    compile(kDefaultPatterns);
+}
+
+void KernelStringMatch::compile(
+    const std::vector<std::string>& patterns) {
+    // Build the trie (state 0 is the root)
+    std::vector<std::vector<int64_t>> trie(1, std::vector<int64_t>(256, -1));
+    num_outputs_.assign(1, 0);
+    for (const auto& pattern : patterns) {
+        uint32_t state = 0;
+        for (const unsigned char c : pattern) {
+            if (trie[state][c] < 0) {
+                trie[state][c] = trie.size();
+                trie.emplace_back(256, -1);
+                num_outputs_.push_back(0);
+            }
+            state = trie[state][c];
+        }
+        num_outputs_[state]++;
+    }
+    // Compute failure links (BFS), and fill in the DFA transitions
+    const uint32_t num_states = trie.size();
+    std::vector<uint32_t> failure(num_states, 0);
+    transitions_.assign(num_states * 256, 0);
+
+    std::queue<uint32_t> queue;
+    for (uint32_t c = 0; c < 256; c++) {
+        if (trie[0][c] > 0) {
+            transitions_[c] = trie[0][c];
+            queue.push(trie[0][c]);
+        }
+    }
+    while (!queue.empty()) {
+        const uint32_t state = queue.front();
+        queue.pop();
+        num_outputs_[state] += num_outputs_[failure[state]];
+
+        for (uint32_t c = 0; c < 256; c++) {
+            const uint32_t fallback = transitions_[failure[state] * 256 + c];
+            if (trie[state][c] > 0) {
+                const uint32_t next = trie[state][c];
+                failure[next] = fallback;
+                transitions_[state * 256 + c] = next;
+                queue.push(next);
+            }
+            else { transitions_[state * 256 + c] = fallback; }
+        }
+    }
+}
+
+void KernelStringMatch::process(rte_mbuf* mbuf) {
+    const uint32_t offset = getPayloadOffset(mbuf);
+    if (UNLIKELY(mbuf->data_len <= offset)) { return; }
+
+    const uint8_t* payload = rte_pktmbuf_mtod_offset(
+        mbuf, const uint8_t*, offset);
+    const uint32_t length = (mbuf->data_len - offset);
+
+    // Run the DFA over the payload
+    uint32_t state = 0;
+    uint64_t num_matches = 0;
+    for (uint32_t idx = 0; idx < length; idx++) {
+        state = transitions_[state * 256 + payload[idx]];
+        num_matches += num_outputs_[state];
+    }
+    sink_ += num_matches;
+}
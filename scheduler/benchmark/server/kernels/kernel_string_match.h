@@ -0,0 +1,41 @@
+#ifndef SCHEDULER_BENCHMARK_SERVER_KERNELS_KERNEL_STRING_MATCH_H
+#define SCHEDULER_BENCHMARK_SERVER_KERNELS_KERNEL_STRING_MATCH_H
+
+// Library headers
+#include "nf_kernel.h"
+
+// STD headers
+#include <string>
+#include <vector>
+
+/**
+ * Multi-pattern string matching (as performed by IDS/DPI NFs)
+ * over the packet payload, using an Aho-Corasick automaton
+ * compiled to a dense DFA transition table.
+ */
+class KernelStringMatch final : public NFKernel {
+private:
+    std::vector<uint32_t> transitions_; // (State, Byte) -> State
+    std::vector<uint32_t> num_outputs_; // State -> Number of matches
+
+    /**
+     * Internal helper method. Compiles the given patterns into a DFA.
+     */
+    void compile(const std::vector<std::string>& patterns);
+
+public:
+    explicit KernelStringMatch();
+    virtual ~KernelStringMatch() {}
+
+    /**
+     * Kernel name.
+     */
+    static std::string name() { return "string_match"; }
+
+    /**
+     * Scans the packet payload, counting pattern matches.
+     */
+    virtual void process(rte_mbuf* mbuf) override;
+};
+
+#endif // SCHEDULER_BENCHMARK_SERVER_KERNELS_KERNEL_STRING_MATCH_H
@@ -0,0 +1,96 @@
+#include "kernel_tcp_reassembly.h"
+
+// STD headers
+#include <algorithm>
+#include <iterator>
+
+// DPDK headers
+#include <rte_tcp.h>
+
+/**
+ * KernelTCPReassembly implementation.
+ */
+uint32_t KernelTCPReassembly::insert(
+    FlowState& flow, uint32_t start, uint32_t end) {
+    OOOList& ooo_list = flow.ooo_list;
+    uint32_t num_traversals = 0;
+
+    // Find the insertion position: the first interval whose
+    // end is GEQ to the next expected PSN for this segment.
+    auto next_iter = ooo_list.begin();
+    while (next_iter != ooo_list.end()) {
+        num_traversals++;
+        if (end <= next_iter->second) { break; }
+        next_iter++;
+    }
+    start = std::max(flow.next_psn, start);
+
+    // Not inserting at the tail
+    if (next_iter != ooo_list.end()) {
+        end = std::min(end, next_iter->first);
+    }
+    // Not inserting at the head
+    if (next_iter != ooo_list.begin()) {
+        auto prev_iter = std::prev(next_iter);
+        while (prev_iter != ooo_list.begin() &&
+               prev_iter->first >= start) {
+            // Erase the previous node
+            prev_iter = std::prev(ooo_list.erase(prev_iter));
+        }
+        // Deleting the new head
+        if (prev_iter->first >= start) { ooo_list.erase(prev_iter); }
+
+        // Update the range, if required
+        else { start = std::max(start, prev_iter->second); }
+    }
+    // This segment has at least one new byte
+    if (end > start) {
+        ooo_list.insert(next_iter, std::make_pair(start, end));
+
+        // Finally, release any in-order nodes
+        auto iter = ooo_list.begin();
+        while (iter != ooo_list.end() && flow.next_psn == iter->first) {
+            flow.next_psn = iter->second;
+            iter = ooo_list.erase(iter);
+            num_traversals++;
+        }
+    }
+    return num_traversals;
+}
+
+void KernelTCPReassembly::process(rte_mbuf* mbuf) {
+    if (getPayloadOffset(mbuf) != kCommonTCPPSize) { return; }
+    struct rte_tcp_hdr* tcp_hdr = rte_pktmbuf_mtod_offset(
+        mbuf, struct rte_tcp_hdr*, kL3HeaderSize);
+
+    const FlowKey key = getFlowKey(mbuf);
+    const uint8_t flags = tcp_hdr->tcp_flags;
+    const bool is_syn = (flags & RTE_TCP_SYN_FLAG);
+
+    // Compute the segment's PSN range: [start, end)
+    const uint32_t start = rte_be_to_cpu_32(tcp_hdr->sent_seq);
+    const uint32_t end = (start + (is_syn ? 1 : 0) +
+                          (mbuf->pkt_len - kCommonTCPPSize));
+
+    // FIN/RST flags are set, terminate the flow
+    if (flags & (RTE_TCP_FIN_FLAG | RTE_TCP_RST_FLAG)) {
+        flows_.erase(key);
+        return;
+    }
+    FlowState& flow = flows_[key];
+
+    // SYN packet (or equivalent)
+    if (is_syn || (flow.next_psn == 0)) {
+        if (flow.ooo_list.empty()) { flow.next_psn = end; }
+    }
+    // The flow is in-order, and this segment keeps it so
+    else if (flow.ooo_list.empty() && (flow.next_psn >= start)) {
+        flow.next_psn = std::max(flow.next_psn, end);
+    }
+    // Drop segments past the reassembly window, and duplicates
+    else if ((start > (flow.next_psn + kReassemblyWindowSizeInBytes)) ||
+             (flow.next_psn >= end)) {}
+
+    // Out-of-order segment
+    else { sink_ += insert(flow, start, end); }
+}
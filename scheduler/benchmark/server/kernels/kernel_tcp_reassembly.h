@@ -0,0 +1,74 @@
+#ifndef SCHEDULER_BENCHMARK_SERVER_KERNELS_KERNEL_TCP_REASSEMBLY_H
+#define SCHEDULER_BENCHMARK_SERVER_KERNELS_KERNEL_TCP_REASSEMBLY_H
+
+// Library headers
+#include "benchmark/packet.h"
+#include "nf_kernel.h"
+
+// STD headers
+#include <list>
+#include <string.h>
+#include <string>
+#include <unordered_map>
+
+// DPDK headers
+#include <rte_hash_crc.h>
+
+/**
+ * TCP reassembly over real TCP segments. Mirrors the TCPReassembly
+ * application in the simulator: each flow maintains a linked list
+ * of out-of-order PSN intervals, so the cost of processing a segment
+ * grows with the number of (adversarially-induced) holes in a flow.
+ */
+class KernelTCPReassembly final : public NFKernel {
+private:
+    typedef std::list<std::pair<uint32_t, uint32_t>> OOOList;
+
+    // Reassembly window
+    static constexpr uint32_t kReassemblyWindowSizeInBytes = (1 << 16);
+
+    /**
+     * Per-flow TCP state.
+     */
+    struct FlowState {
+        OOOList ooo_list; // Out-of-order list
+        uint32_t next_psn = 0; // Next sequence number
+    };
+
+    // Hash and equality functors for flow keys
+    struct HashFlowKey {
+        size_t operator()(const FlowKey& key) const {
+            return rte_hash_crc(&key, sizeof(key), 0);
+        }
+    };
+    struct EqualToFlowKey {
+        bool operator()(const FlowKey& a, const FlowKey& b) const {
+            return (memcmp(&a, &b, sizeof(FlowKey)) == 0);
+        }
+    };
+    std::unordered_map<FlowKey, FlowState, HashFlowKey,
+                       EqualToFlowKey> flows_; // Flow key -> State
+
+    /**
+     * Internal helper method. Inserts the PSN range [start, end) into
+     * the flow's OOO list, releasing any in-order intervals. Returns
+     * the number of linked-list traversals performed.
+     */
+    static uint32_t insert(FlowState& flow, uint32_t start, uint32_t end);
+
+public:
+    explicit KernelTCPReassembly() : NFKernel(name()) {}
+    virtual ~KernelTCPReassembly() {}
+
+    /**
+     * Kernel name.
+     */
+    static std::string name() { return "tcp_reassembly"; }
+
+    /**
+     * Reassembles the given TCP segment (non-TCP packets are ignored).
+     */
+    virtual void process(rte_mbuf* mbuf) override;
+};
+
+#endif // SCHEDULER_BENCHMARK_SERVER_KERNELS_KERNEL_TCP_REASSEMBLY_H
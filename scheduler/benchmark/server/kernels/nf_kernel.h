@@ -0,0 +1,45 @@
+#ifndef SCHEDULER_BENCHMARK_SERVER_KERNELS_NF_KERNEL_H
+#define SCHEDULER_BENCHMARK_SERVER_KERNELS_NF_KERNEL_H
+
+// Library headers
+#include "common/macros.h"
+
+// STD headers
+#include <stdint.h>
+#include <string>
+
+// DPDK headers
+#include <rte_mbuf.h>
+
+/**
+ * Base class representing a network function (NF) kernel that
+ * performs real work on packets in the processing lcore. The
+ * job size of a packet is the measured cost of process().
+ */
+class NFKernel {
+public:
+    // Kernel parameters
+    struct Parameters {
+        double collision_rate = 0; // Hash collision rate (hash_lookup)
+    };
+
+protected:
+    const std::string kName; // Kernel type
+    uint64_t sink_ = 0; // Accumulates results (defeats dead-code elimination)
+    explicit NFKernel(const std::string& name) : kName(name) {}
+
+public:
+    virtual ~NFKernel() {}
+    DISALLOW_COPY_AND_ASSIGN(NFKernel);
+
+    // Accessors
+    const std::string& type() const { return kName; }
+    uint64_t getSink() const { return sink_; }
+
+    /**
+     * Processes the given packet.
+     */
+    virtual void process(rte_mbuf* mbuf) = 0;
+};
+
+#endif // SCHEDULER_BENCHMARK_SERVER_KERNELS_NF_KERNEL_H
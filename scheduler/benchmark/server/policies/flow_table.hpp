@@ -0,0 +1,221 @@
+#ifndef SCHEDULER_BENCHMARK_SERVER_POLICIES_FLOW_TABLE_HPP
+#define SCHEDULER_BENCHMARK_SERVER_POLICIES_FLOW_TABLE_HPP
+
+// Library headers
+#include "benchmark/packet.h"
+#include "common/macros.h"
+
+// STD headers
+#include <stdint.h>
+#include <vector>
+
+// DPDK headers
+#include <rte_hash.h>
+#include <rte_hash_crc.h>
+#include <rte_lcore.h>
+#include <rte_mbuf.h>
+
+/**
+ * Represents a table of active flows. Packets are classified
+ * by 5-tuple (using an rte_hash), and each active flow holds
+ * a FIFO of mbufs. FIFO entries are allocated from a shared,
+ * fixed-size pool of nodes, so the table never allocates on
+ * the datapath. Flows are evicted once their FIFO drains, so
+ * the number of active flows never exceeds the capacity.
+ *
+ * The State template parameter is opaque, per-flow policy
+ * state (e.g., cumulative sizes, virtual times, or credit).
+ */
+template<class State> class FlowTable {
+public:
+    // Sentinel index
+    static constexpr uint32_t kInvalidIdx = UINT32_MAX;
+
+    /**
+     * Per-flow metadata.
+     */
+    struct Flow {
+        FlowKey key{}; // 5-tuple
+        uint32_t head = kInvalidIdx; // Head node index
+        uint32_t tail = kInvalidIdx; // Tail node index
+        uint32_t size = 0; // Number of queued packets
+        State state{}; // Policy-specific state
+    };
+
+private:
+    /**
+     * Represents a single FIFO entry.
+     */
+    struct Node {
+        rte_mbuf* mbuf = nullptr; // Packet mbuf
+        uint32_t jsize_ns = 0; // Job size (in ns)
+        uint32_t prev = kInvalidIdx; // Previous node index
+        uint32_t next = kInvalidIdx; // Next node index
+    };
+
+    const uint32_t kCapacity; // Maximum number of queued packets
+    struct rte_hash* hash_ = nullptr; // 5-tuple -> Flow index
+    std::vector<Flow> flows_; // Flow index -> Metadata
+    std::vector<Node> nodes_; // Node pool
+    std::vector<uint32_t> free_nodes_; // Free-list (stack)
+    size_t size_ = 0; // Total number of queued packets
+
+public:
+    explicit FlowTable(const char* name, const uint32_t capacity) :
+        kCapacity(capacity), flows_(capacity), nodes_(capacity) {
+        struct rte_hash_parameters params = {};
+        params.name = name;
+        params.entries = capacity;
+        params.key_len = sizeof(FlowKey);
+        params.hash_func = rte_hash_crc;
+        params.hash_func_init_val = 0;
+        params.socket_id = rte_socket_id();
+        params.extra_flag = RTE_HASH_EXTRA_FLAGS_EXT_TABLE;
+
+        hash_ = rte_hash_create(&params);
+        if (hash_ == NULL) {
+            rte_exit(EXIT_FAILURE, "Failed to create flow table\n");
+        }
+        // Initialize the free-list
+        free_nodes_.reserve(capacity);
+        for (uint32_t idx = 0; idx < capacity; idx++) {
+            free_nodes_.push_back(capacity - idx - 1);
+        }
+    }
+    ~FlowTable() { rte_hash_free(hash_); }
+
+    /**
+     * Returns the total number of queued packets.
+     */
+    size_t size() const { return size_; }
+
+    /**
+     * Returns whether the table is empty.
+     */
+    bool empty() const { return (size_ == 0); }
+
+    /**
+     * Returns whether the node pool is exhausted.
+     */
+    bool full() const { return free_nodes_.empty(); }
+
+    /**
+     * Returns the flow corresponding to the given index.
+     */
+    Flow& flow(const uint32_t flow_idx) { return flows_[flow_idx]; }
+    const Flow& flow(const uint32_t flow_idx) const {
+        return flows_[flow_idx];
+    }
+
+    /**
+     * Returns the index of the flow corresponding to the given key,
+     * inserting a new (empty) flow if required. Returns kInvalidIdx
+     * if the flow table is full.
+     */
+    uint32_t lookup(const FlowKey& key) {
+        int32_t ret = rte_hash_lookup(hash_, &key);
+        if (LIKELY(ret >= 0)) { return static_cast<uint32_t>(ret); }
+
+        // Insert a new flow
+        ret = rte_hash_add_key(hash_, &key);
+        if (UNLIKELY(ret < 0)) { return kInvalidIdx; }
+        SP_ASSERT(LIKELY(static_cast<uint32_t>(ret) < kCapacity));
+
+        Flow& flow = flows_[ret];
+        flow = Flow();
+        flow.key = key;
+        return static_cast<uint32_t>(ret);
+    }
+
+    /**
+     * Evicts the given (empty) flow from the table.
+     */
+    void release(const uint32_t flow_idx) {
+        SP_ASSERT(LIKELY(flows_[flow_idx].size == 0));
+        rte_hash_del_key(hash_, &flows_[flow_idx].key);
+    }
+
+    /**
+     * Returns the mbuf at the head of the given flow's FIFO.
+     */
+    rte_mbuf* front(const uint32_t flow_idx) const {
+        SP_ASSERT(LIKELY(flows_[flow_idx].size != 0));
+        return nodes_[flows_[flow_idx].head].mbuf;
+    }
+
+    /**
+     * Returns the job size of the HoL packet in the given flow's FIFO.
+     */
+    uint32_t frontJobSize(const uint32_t flow_idx) const {
+        SP_ASSERT(LIKELY(flows_[flow_idx].size != 0));
+        return nodes_[flows_[flow_idx].head].jsize_ns;
+    }
+
+    /**
+     * Appends a packet to the given flow's FIFO. The
+     * caller must ensure that the table is not full.
+     */
+    void pushBack(const uint32_t flow_idx, rte_mbuf* mbuf,
+                  const uint32_t jsize_ns) {
+        SP_ASSERT(LIKELY(!full()));
+        const uint32_t node_idx = free_nodes_.back();
+        free_nodes_.pop_back();
+
+        Flow& flow = flows_[flow_idx];
+        Node& node = nodes_[node_idx];
+        node.mbuf = mbuf;
+        node.jsize_ns = jsize_ns;
+        node.prev = flow.tail;
+        node.next = kInvalidIdx;
+
+        if (flow.size == 0) { flow.head = node_idx; }
+        else { nodes_[flow.tail].next = node_idx; }
+        flow.tail = node_idx;
+        flow.size++;
+        size_++;
+    }
+
+    /**
+     * Pops (and returns) the mbuf at the head of the given
+     * flow's FIFO. Also returns the corresponding job size.
+     */
+    rte_mbuf* popFront(const uint32_t flow_idx, uint32_t& jsize_ns) {
+        Flow& flow = flows_[flow_idx];
+        SP_ASSERT(LIKELY(flow.size != 0));
+        const uint32_t node_idx = flow.head;
+        const Node& node = nodes_[node_idx];
+
+        flow.head = node.next;
+        if (flow.head != kInvalidIdx) { nodes_[flow.head].prev = kInvalidIdx; }
+        else { flow.tail = kInvalidIdx; }
+
+        jsize_ns = node.jsize_ns;
+        free_nodes_.push_back(node_idx);
+        flow.size--;
+        size_--;
+        return node.mbuf;
+    }
+
+    /**
+     * Pops (and returns) the mbuf at the tail of the given
+     * flow's FIFO. Also returns the corresponding job size.
+     */
+    rte_mbuf* popBack(const uint32_t flow_idx, uint32_t& jsize_ns) {
+        Flow& flow = flows_[flow_idx];
+        SP_ASSERT(LIKELY(flow.size != 0));
+        const uint32_t node_idx = flow.tail;
+        const Node& node = nodes_[node_idx];
+
+        flow.tail = node.prev;
+        if (flow.tail != kInvalidIdx) { nodes_[flow.tail].next = kInvalidIdx; }
+        else { flow.head = kInvalidIdx; }
+
+        jsize_ns = node.jsize_ns;
+        free_nodes_.push_back(node_idx);
+        flow.size--;
+        size_--;
+        return node.mbuf;
+    }
+};
+
+#endif // SCHEDULER_BENCHMARK_SERVER_POLICIES_FLOW_TABLE_HPP
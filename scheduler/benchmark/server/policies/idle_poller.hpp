@@ -0,0 +1,180 @@
+#ifndef SCHEDULER_BENCHMARK_SERVER_POLICIES_IDLE_POLLER_HPP
+#define SCHEDULER_BENCHMARK_SERVER_POLICIES_IDLE_POLLER_HPP
+
+// Library headers
+#include "common/macros.h"
+#include "common/tsc_clock.h"
+
+// STD headers
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <stdint.h>
+#include <string>
+
+// DPDK headers
+#include <rte_cpuflags.h>
+#include <rte_pause.h>
+#include <rte_power_intrinsics.h>
+#include <rte_version.h>
+
+/**
+ * Polling modes for idle lcores.
+ */
+enum class PollMode {
+    SPIN = 0, // Busy-poll (default)
+    BACKOFF, // Exponential rte_pause() backoff
+    MONITOR, // UMWAIT/TPAUSE (falls back to BACKOFF)
+};
+
+/**
+ * Parses the given poll mode. Returns false if invalid.
+ */
+inline bool parsePollMode(const std::string& name, PollMode& mode) {
+    if (name == "spin") { mode = PollMode::SPIN; }
+    else if (name == "backoff") { mode = PollMode::BACKOFF; }
+    else if (name == "monitor") { mode = PollMode::MONITOR; }
+    else { return false; }
+    return true;
+}
+
+/**
+ * Implements adaptive polling for an lcore. On every empty poll, the
+ * lcore backs off exponentially (up to a bound) using rte_pause(), or,
+ * in MONITOR mode, parks in an optimized power state (UMWAIT) until a
+ * monitored address (e.g., a ring's producer tail) is written or a
+ * short timeout elapses. Any useful work resets the backoff. Also
+ * tracks the number of empty polls and the cycles spent busy.
+ */
+class IdlePoller {
+private:
+    // Backoff configuration
+    static constexpr uint32_t kMaxPauses = 256;
+    static constexpr uint64_t kMonitorTimeoutNs = 10000;
+
+    PollMode mode_; // Polling mode
+    uint32_t num_pauses_ = 1; // Current backoff
+    uint64_t monitor_timeout_ticks_ = 0; // UMWAIT/TPAUSE timeout
+
+    // Housekeeping
+    uint64_t num_polls_ = 0; // Total polls
+    uint64_t num_empty_polls_ = 0; // Polls that found no work
+    uint64_t num_busy_ticks_ = 0; // Cycles spent doing useful work
+    uint64_t start_tick_ = 0; // Cycle count at first poll
+
+    #if RTE_VERSION >= RTE_VERSION_NUM(21, 8, 0, 0)
+    /**
+     * Monitor condition callback (DPDK 21.08+). Always enters
+     * the power-optimized state (i.e., waits for any write).
+     */
+    static int alwaysSleep(const uint64_t,
+                           const uint64_t[RTE_POWER_MONITOR_OPAQUE_SZ]) {
+        return 0;
+    }
+    #endif
+
+public:
+    explicit IdlePoller(const PollMode mode) : mode_(mode) {
+        if ((mode_ == PollMode::MONITOR) &&
+            !rte_cpu_get_flag_enabled(RTE_CPUFLAG_WAITPKG)) {
+            mode_ = PollMode::BACKOFF;
+        }
+        monitor_timeout_ticks_ = (
+            (kMonitorTimeoutNs * clock_scale()) / 1000);
+    }
+
+    // Accessors
+    PollMode getMode() const { return mode_; }
+    uint64_t getNumPolls() const { return num_polls_; }
+    uint64_t getNumEmptyPolls() const { return num_empty_polls_; }
+    uint64_t getNumBusyTicks() const { return num_busy_ticks_; }
+
+    /**
+     * Records a poll that found work to do, which
+     * was completed during [start_tick, now).
+     */
+    inline void busy(const uint64_t start_tick) {
+        if (UNLIKELY(num_polls_ == 0)) { start_tick_ = start_tick; }
+        num_busy_ticks_ += (TscClock::now() - start_tick);
+        num_pauses_ = 1;
+        num_polls_++;
+    }
+
+    /**
+     * Records an empty poll, then backs off. If non-null, the given
+     * 32-bit word is monitored for writes (in MONITOR mode).
+     */
+    inline void idle(volatile void* monitor_addr = nullptr) {
+        if (UNLIKELY(num_polls_ == 0)) { start_tick_ = TscClock::now(); }
+        num_empty_polls_++;
+        num_polls_++;
+
+        switch (mode_) {
+        case PollMode::SPIN: { break; }
+        case PollMode::BACKOFF: {
+            for (uint32_t idx = 0; idx < num_pauses_; idx++) { rte_pause(); }
+            num_pauses_ = std::min(kMaxPauses, (num_pauses_ * 2));
+            break;
+        }
+        case PollMode::MONITOR: {
+            const uint64_t deadline = (TscClock::now() +
+                                       monitor_timeout_ticks_);
+            // Park until the address is written or the deadline passes.
+            // Note: No expected value is specified, so a write between
+            // the caller's check and arming the monitor costs (at most)
+            // a single timeout. If the monitor can't be armed, TPAUSE.
+            bool is_monitored = false;
+            if (monitor_addr != nullptr) {
+                #if RTE_VERSION >= RTE_VERSION_NUM(21, 8, 0, 0)
+                struct rte_power_monitor_cond pmc = {};
+                pmc.addr = monitor_addr;
+                pmc.fn = alwaysSleep;
+                pmc.size = sizeof(uint32_t);
+                is_monitored = (rte_power_monitor(&pmc, deadline) == 0);
+                #elif RTE_VERSION >= RTE_VERSION_NUM(21, 2, 0, 0)
+                struct rte_power_monitor_cond pmc = {};
+                pmc.addr = monitor_addr;
+                pmc.val = 0;
+                pmc.mask = 0; // Don't compare against the value
+                pmc.size = sizeof(uint32_t);
+                is_monitored = (rte_power_monitor(&pmc, deadline) == 0);
+                #else
+                rte_power_monitor(monitor_addr, 0, 0, deadline,
+                                  sizeof(uint32_t));
+                is_monitored = true;
+                #endif
+            }
+            if (!is_monitored) { rte_power_pause(deadline); }
+            break;
+        }
+        }
+    }
+
+    /**
+     * Waits until the given TSC deadline (e.g., to emulate service).
+     * In MONITOR mode, uses TPAUSE rather than spinning.
+     */
+    inline void waitUntil(const uint64_t deadline) {
+        if (mode_ == PollMode::MONITOR) {
+            while (TscClock::now() < deadline) { rte_power_pause(deadline); }
+        }
+        else { while (TscClock::now() < deadline) {} }
+    }
+
+    /**
+     * Prints the polling statistics.
+     */
+    void printStats(const std::string& lcore_name) const {
+        const uint64_t elapsed_ticks = (TscClock::now() - start_tick_);
+        const double busy_percent = (elapsed_ticks == 0) ? 0 :
+            ((100.0 * num_busy_ticks_) / elapsed_ticks);
+
+        std::cout << "[" << lcore_name << "] "
+                  << "Empty polls: " << num_empty_polls_ << "/"
+                  << num_polls_ << ", busy cycles: " << num_busy_ticks_
+                  << " (" << std::fixed << std::setprecision(2)
+                  << busy_percent << "%)" << std::endl;
+    }
+};
+
+#endif // SCHEDULER_BENCHMARK_SERVER_POLICIES_IDLE_POLLER_HPP
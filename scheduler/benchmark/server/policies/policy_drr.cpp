@@ -0,0 +1,97 @@
+#include "policy_drr.h"
+
+// Library headers
+#include "benchmark/packet.h"
+#include "scheduler.hpp"
+
+// Flow table capacity (at most one flow per queued packet)
+constexpr uint32_t kFlowTableCapacity = SCHEDULER_QUEUE_SIZE;
+
+// Per-round quantum (the attack job size). Flows whose HoL job is
+// larger (e.g., innocent jobs exceeding the attack job size) carry
+// their deficit over, and are served in a later round.
+constexpr uint32_t kQuantumInNs = kAttackJSizeInNs;
+
+/**
+ * Returns the name of this scheduling policy.
+ */
+std::string PolicyDRR::name() {
+    return "drr";
+}
+
+PolicyDRR::PolicyDRR(struct rte_mempool* mbuf_pool,
+                     struct rte_ring* process_ring) :
+                     process_ring_(process_ring), mbuf_pool_(mbuf_pool),
+                     flows_("drr_flows", kFlowTableCapacity) {}
+
+/**
+ * Dequeues a burst of packets from the packet
+ * queue and pushes them onto the process ring.
+ * Returns the number of packets scheduled.
+ */
+uint32_t PolicyDRR::scheduleBurst() {
+    // Enque packets into the process ring until either the
+    // packet queue becomes empty or the ring becomes full.
+    int free_slots = rte_ring_free_count(process_ring_);
+    uint32_t num_scheduled = 0;
+    while (!active_flows_.empty() && (free_slots > 0)) {
+        const uint32_t flow_idx = active_flows_.front();
+        FlowState& state = flows_.flow(flow_idx).state;
+        if (!state.has_quantum) {
+            state.deficit_ns += kQuantumInNs;
+            state.has_quantum = true;
+        }
+        // Insufficient deficit, move on to the next flow
+        if (flows_.frontJobSize(flow_idx) > state.deficit_ns) {
+            state.has_quantum = false;
+            active_flows_.pop_front();
+            active_flows_.push_back(flow_idx);
+            continue;
+        }
+        // Dequeue the flow's HoL packet
+        uint32_t jsize_ns = 0;
+        rte_mbuf* mbuf = flows_.popFront(flow_idx, jsize_ns);
+        state.deficit_ns -= jsize_ns;
+        rte_ring_enqueue(process_ring_, mbuf);
+        num_scheduled++;
+        free_slots--;
+
+        // If the flow drains, evict it (forfeiting its deficit)
+        if (flows_.flow(flow_idx).size == 0) {
+            active_flows_.pop_front();
+            flows_.release(flow_idx);
+        }
+    }
+    return num_scheduled;
+}
+
+/**
+ * Enqueues a burst of packets in to the RX packet queue.
+ * If the queue becomes full, also deallocates the mbufs
+ * corresponding to the dropped packets.
+ *
+ * @param mbufs Pointer to an array of mbufs to enqueue.
+ * @param num_mbufs Number of mbufs to enqueue.
+ */
+void PolicyDRR::enqueueBurst(struct rte_mbuf** mbufs,
+                             const uint16_t num_mbufs) {
+    uint16_t num_enqueued = 0;
+    while ((num_enqueued < num_mbufs) &&
+           (flows_.size() < SCHEDULER_QUEUE_SIZE)) {
+        rte_mbuf* mbuf = mbufs[num_enqueued];
+        const uint32_t flow_idx = flows_.lookup(getFlowKey(mbuf));
+        if (unlikely(flow_idx == FlowTable<FlowState>::kInvalidIdx)) {
+            break;
+        }
+        // Newly-active flows join the tail of the round
+        const bool is_idle = (flows_.flow(flow_idx).size == 0);
+        flows_.pushBack(flow_idx, mbuf, getPacketParams(mbuf).jsize_ns);
+        if (is_idle) { active_flows_.push_back(flow_idx); }
+        num_enqueued++;
+    }
+    // Deallocate the mbufs corresponding to dropped packets
+    for (auto idx = num_enqueued; idx < num_mbufs; idx++) {
+        rte_pktmbuf_free(mbufs[idx]);
+    }
+    num_rx_ += num_enqueued;
+}
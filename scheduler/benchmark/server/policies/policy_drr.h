@@ -0,0 +1,48 @@
+#ifndef SCHEDULER_BENCHMARK_SERVER_POLICIES_POLICY_DRR_H
+#define SCHEDULER_BENCHMARK_SERVER_POLICIES_POLICY_DRR_H
+
+// Library headers
+#include "flow_table.hpp"
+
+// STD headers
+#include <deque>
+#include <stdint.h>
+#include <string>
+
+// DPDK headers
+#include <rte_mempool.h>
+#include <rte_mbuf.h>
+#include <rte_ring.h>
+
+/**
+ * Implements Deficit Round Robin (DRR) over flows, using job sizes
+ * as the service metric. Each active flow receives a fixed quantum
+ * of service (in ns) per round. Drops packets at the tail when the
+ * queue is full.
+ */
+class PolicyDRR {
+private:
+    /**
+     * Per-flow scheduling state.
+     */
+    struct FlowState {
+        uint64_t deficit_ns = 0; // Deficit counter
+        bool has_quantum = false; // Quantum granted in the current round?
+    };
+
+    uint64_t num_rx_ = 0;
+    struct rte_ring* process_ring_;
+    struct rte_mempool* mbuf_pool_;
+    FlowTable<FlowState> flows_;
+    std::deque<uint32_t> active_flows_;
+
+public:
+    static std::string name();
+    PolicyDRR(struct rte_mempool* mbuf_pool,
+              struct rte_ring* process_ring);
+    uint32_t scheduleBurst();
+    void enqueueBurst(struct rte_mbuf** mbufs,
+                      const uint16_t num_mbufs);
+};
+
+#endif // SCHEDULER_BENCHMARK_SERVER_POLICIES_POLICY_DRR_H
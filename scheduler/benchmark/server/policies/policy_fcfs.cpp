@@ -15,8 +15,9 @@ std::string PolicyFCFS::name() { return "fcfs"; }
 /**
  * Dequeues a burst of packets from the packet
  * queue and pushes them onto the process ring.
+ * Returns the number of packets scheduled.
  */
-void PolicyFCFS::scheduleBurst() {}
+uint32_t PolicyFCFS::scheduleBurst() { return 0; }
 
 /**
  * Enqueues a burst of packets in to the RX packet queue.
@@ -26,7 +26,7 @@ public:
 
     static std::string name();
 
-    void scheduleBurst();
+    uint32_t scheduleBurst();
     void enqueueBurst(struct rte_mbuf** mbufs,
                       const uint16_t num_mbufs);
 };
@@ -0,0 +1,90 @@
+#include "policy_sfq.h"
+
+// Library headers
+#include "benchmark/packet.h"
+#include "scheduler.hpp"
+
+// Flow table capacity (at most one flow per queued packet)
+constexpr uint32_t kFlowTableCapacity = SCHEDULER_QUEUE_SIZE;
+
+/**
+ * Returns the name of this scheduling policy.
+ */
+std::string PolicySFQ::name() {
+    return "sfq";
+}
+
+PolicySFQ::PolicySFQ(struct rte_mempool* mbuf_pool,
+                     struct rte_ring* process_ring) :
+                     process_ring_(process_ring), mbuf_pool_(mbuf_pool),
+                     flows_("sfq_flows", kFlowTableCapacity) {}
+
+/**
+ * Dequeues a burst of packets from the packet
+ * queue and pushes them onto the process ring.
+ * Returns the number of packets scheduled.
+ */
+uint32_t PolicySFQ::scheduleBurst() {
+    // Enque packets into the process ring until either the
+    // packet queue becomes empty or the ring becomes full.
+    int free_slots = rte_ring_free_count(process_ring_);
+    uint32_t num_scheduled = 0;
+    while (!queue_.empty() && (free_slots > 0)) {
+        const uint32_t flow_idx = queue_.pop();
+        FlowState& state = flows_.flow(flow_idx).state;
+
+        // Dequeue the flow's HoL packet. Its start tag is the
+        // flow's previous finish tag (the flow is backlogged).
+        uint32_t jsize_ns = 0;
+        rte_mbuf* mbuf = flows_.popFront(flow_idx, jsize_ns);
+        virtual_time_ = state.finish_tag;
+        state.finish_tag += jsize_ns;
+        rte_ring_enqueue(process_ring_, mbuf);
+        num_scheduled++;
+        free_slots--;
+
+        // Reinsert the flow keyed on the next start tag, or evict it
+        if (flows_.flow(flow_idx).size != 0) {
+            queue_.push(flow_idx, state.finish_tag);
+        }
+        else { flows_.release(flow_idx); }
+    }
+    return num_scheduled;
+}
+
+/**
+ * Enqueues a burst of packets in to the RX packet queue.
+ * If the queue becomes full, also deallocates the mbufs
+ * corresponding to the dropped packets.
+ *
+ * @param mbufs Pointer to an array of mbufs to enqueue.
+ * @param num_mbufs Number of mbufs to enqueue.
+ */
+void PolicySFQ::enqueueBurst(struct rte_mbuf** mbufs,
+                             const uint16_t num_mbufs) {
+    uint16_t num_enqueued = 0;
+    while ((num_enqueued < num_mbufs) &&
+           (flows_.size() < SCHEDULER_QUEUE_SIZE)) {
+        rte_mbuf* mbuf = mbufs[num_enqueued];
+        const uint32_t flow_idx = flows_.lookup(getFlowKey(mbuf));
+        if (unlikely(flow_idx == FlowTable<FlowState>::kInvalidIdx)) {
+            break;
+        }
+        auto& flow = flows_.flow(flow_idx);
+        const bool is_idle = (flow.size == 0);
+        flows_.pushBack(flow_idx, mbuf, getPacketParams(mbuf).jsize_ns);
+
+        // If the flow was idle, its start tag is the current virtual
+        // time (the finish tag is not retained once a flow drains).
+        if (is_idle) {
+            flow.state.finish_tag = virtual_time_;
+            queue_.push(flow_idx, flow.state.finish_tag);
+        }
+        num_enqueued++;
+    }
+    // Deallocate the mbufs corresponding to dropped packets
+    for (auto idx = num_enqueued; idx < num_mbufs; idx++) {
+        rte_pktmbuf_free(mbufs[idx]);
+    }
+    num_rx_ += num_enqueued;
+}
@@ -0,0 +1,49 @@
+#ifndef SCHEDULER_BENCHMARK_SERVER_POLICIES_POLICY_SFQ_H
+#define SCHEDULER_BENCHMARK_SERVER_POLICIES_POLICY_SFQ_H
+
+// Library headers
+#include "flow_table.hpp"
+#include "heaps/priority_queue.hpp"
+
+// STD headers
+#include <stdint.h>
+#include <string>
+
+// DPDK headers
+#include <rte_mempool.h>
+#include <rte_mbuf.h>
+#include <rte_ring.h>
+
+/**
+ * Implements Start-time Fair Queueing (SFQ) over flows, using job
+ * sizes as the service metric (mirroring FQQueue in the simulator).
+ * Flows are ordered by the start tag of their HoL packet, and the
+ * virtual time is the start tag of the last dequeued packet. Drops
+ * packets at the tail when the queue is full.
+ */
+class PolicySFQ {
+private:
+    /**
+     * Per-flow scheduling state.
+     */
+    struct FlowState {
+        double finish_tag = 0; // Finish tag of the last dequeued packet
+    };
+
+    uint64_t num_rx_ = 0;
+    double virtual_time_ = 0;
+    struct rte_ring* process_ring_;
+    struct rte_mempool* mbuf_pool_;
+    FlowTable<FlowState> flows_;
+    PriorityQueue<uint32_t> queue_;
+
+public:
+    static std::string name();
+    PolicySFQ(struct rte_mempool* mbuf_pool,
+              struct rte_ring* process_ring);
+    uint32_t scheduleBurst();
+    void enqueueBurst(struct rte_mbuf** mbufs,
+                      const uint16_t num_mbufs);
+};
+
+#endif // SCHEDULER_BENCHMARK_SERVER_POLICIES_POLICY_SFQ_H
@@ -28,7 +28,7 @@ public:
     static std::string name();
     PolicyWSJFFibonacciDropTail(struct rte_mempool* mbuf_pool,
                                 struct rte_ring* process_ring);
-    void scheduleBurst();
+    uint32_t scheduleBurst();
     void enqueueBurst(struct rte_mbuf** mbufs,
                       const uint16_t num_mbufs);
 };
@@ -25,15 +25,19 @@ PolicyWSJFFHierarchicalFFS::PolicyWSJFFHierarchicalFFS(
 /**
  * Dequeues a burst of packets from the packet
  * queue and pushes them onto the process ring.
+ * Returns the number of packets scheduled.
  */
-void PolicyWSJFFHierarchicalFFS::scheduleBurst() {
+uint32_t PolicyWSJFFHierarchicalFFS::scheduleBurst() {
     // Enque packets into the process ring until either the
     // packet queue becomes empty or the ring becomes full.
     int free_slots = rte_ring_free_count(process_ring_);
+    uint32_t num_scheduled = 0;
     while (!queue_.empty() && (free_slots > 0)) {
         rte_ring_enqueue(process_ring_, queue_.popMin());
+        num_scheduled++;
         free_slots--;
     }
+    return num_scheduled;
 }
 
 /**
@@ -0,0 +1,119 @@
+#include "policy_wsjf_inorder.h"
+
+// Library headers
+#include "benchmark/packet.h"
+#include "scheduler.hpp"
+
+// Queue configuration. Since a flow's weight is a weighted
+// average of its packets' weights, the same bounds apply.
+constexpr uint32_t kNumTotalPriorityBuckets = (32 * 32 * 32 * 32);
+constexpr uint32_t kMaxWeight = (
+    (kAttackJSizeInNs + kAttackPSizeInBytes - 1) / kAttackPSizeInBytes);
+constexpr uint32_t kScaleFactor = (kNumTotalPriorityBuckets / kMaxWeight);
+
+// Flow table capacity. Each burst is enqueued before dropping
+// packets, so the table must accommodate one additional burst.
+constexpr uint32_t kFlowTableCapacity = (SCHEDULER_QUEUE_SIZE + BURST_SIZE);
+
+/**
+ * Returns the name of this scheduling policy.
+ */
+std::string PolicyWSJFInorder::name() {
+    return "wsjf_inorder";
+}
+
+PolicyWSJFInorder::PolicyWSJFInorder(
+    struct rte_mempool* mbuf_pool, struct rte_ring* process_ring) :
+    process_ring_(process_ring), mbuf_pool_(mbuf_pool),
+    flows_("wsjf_inorder_flows", kFlowTableCapacity),
+    queue_(kNumTotalPriorityBuckets, kScaleFactor) {}
+
+/**
+ * Inserts the given (non-empty) flow into the queue
+ * based on the current cumulative job/packet sizes.
+ */
+void PolicyWSJFInorder::schedule(const uint32_t flow_idx) {
+    FlowState& state = flows_.flow(flow_idx).state;
+    state.handle = queue_.push(flow_idx, FlowQueue::UnscaledWeight{
+        state.total_jsize_ns, state.total_psize_bytes});
+}
+
+/**
+ * Drops the tail packet of the flow with the max weight.
+ */
+void PolicyWSJFInorder::dropMaxWeight() {
+    const uint32_t flow_idx = queue_.popMax();
+    FlowState& state = flows_.flow(flow_idx).state;
+
+    uint32_t jsize_ns = 0;
+    rte_mbuf* mbuf = flows_.popBack(flow_idx, jsize_ns);
+    state.total_jsize_ns -= jsize_ns;
+    state.total_psize_bytes -= mbuf->pkt_len;
+    rte_pktmbuf_free(mbuf);
+    num_rx_--;
+
+    // Update the flow's position, or evict it
+    if (flows_.flow(flow_idx).size != 0) { schedule(flow_idx); }
+    else { flows_.release(flow_idx); }
+}
+
+/**
+ * Dequeues a burst of packets from the packet
+ * queue and pushes them onto the process ring.
+ * Returns the number of packets scheduled.
+ */
+uint32_t PolicyWSJFInorder::scheduleBurst() {
+    // Enque packets into the process ring until either the
+    // packet queue becomes empty or the ring becomes full.
+    int free_slots = rte_ring_free_count(process_ring_);
+    uint32_t num_scheduled = 0;
+    while (!queue_.empty() && (free_slots > 0)) {
+        const uint32_t flow_idx = queue_.popMin();
+        FlowState& state = flows_.flow(flow_idx).state;
+
+        // Dequeue the flow's HoL packet
+        uint32_t jsize_ns = 0;
+        rte_mbuf* mbuf = flows_.popFront(flow_idx, jsize_ns);
+        state.total_jsize_ns -= jsize_ns;
+        state.total_psize_bytes -= mbuf->pkt_len;
+        rte_ring_enqueue(process_ring_, mbuf);
+        num_scheduled++;
+        free_slots--;
+
+        // Update the flow's position, or evict it
+        if (flows_.flow(flow_idx).size != 0) { schedule(flow_idx); }
+        else { flows_.release(flow_idx); }
+    }
+    return num_scheduled;
+}
+
+/**
+ * Enqueues a burst of packets in to the RX packet queue.
+ * If the queue becomes full, also deallocates the mbufs
+ * corresponding to the dropped packets.
+ *
+ * @param mbufs Pointer to an array of mbufs to enqueue.
+ * @param num_mbufs Number of mbufs to enqueue.
+ */
+void PolicyWSJFInorder::enqueueBurst(
+    struct rte_mbuf** mbufs, const uint16_t num_mbufs) {
+    for (uint16_t idx = 0; idx < num_mbufs; idx++) {
+        const uint32_t flow_idx = flows_.lookup(getFlowKey(mbufs[idx]));
+        if (unlikely(flow_idx == FlowTable<FlowState>::kInvalidIdx)) {
+            rte_pktmbuf_free(mbufs[idx]);
+            continue;
+        }
+        auto p = getPacketParams(mbufs[idx]);
+        auto& flow = flows_.flow(flow_idx);
+
+        // If the flow is already queued, remove its stale entry
+        if (flow.size != 0) { queue_.erase(flow.state.handle); }
+        flows_.pushBack(flow_idx, mbufs[idx], p.jsize_ns);
+        flow.state.total_jsize_ns += p.jsize_ns;
+        flow.state.total_psize_bytes += p.psize_bytes;
+        schedule(flow_idx);
+        num_rx_++;
+    }
+    // Deallocate the mbufs corresponding to dropped packets
+    while (flows_.size() > SCHEDULER_QUEUE_SIZE) { dropMaxWeight(); }
+}
@@ -0,0 +1,57 @@
+#ifndef SCHEDULER_BENCHMARK_SERVER_POLICIES_POLICY_WSJF_INORDER_H
+#define SCHEDULER_BENCHMARK_SERVER_POLICIES_POLICY_WSJF_INORDER_H
+
+// Library headers
+#include "flow_table.hpp"
+#include "heaps/hffs_queue/software/hffs_queue.hpp"
+
+// STD headers
+#include <stdint.h>
+#include <string>
+
+// DPDK headers
+#include <rte_mempool.h>
+#include <rte_mbuf.h>
+#include <rte_ring.h>
+
+/**
+ * Implements a flow-based, in-order WSJF scheduling policy, which
+ * schedules flows in increasing order of (Sigma(J_{i}) / Sigma(P_{i}))
+ * over the queued packets in each flow, using a Hierarchical FFS queue.
+ * Packets within a flow are always served in FIFO order. If the queue
+ * becomes full, drops the tail packet of the max-weight flow.
+ */
+class PolicyWSJFInorder {
+private:
+    // Typedefs
+    typedef HierarchicalFindFirstSetQueue<uint32_t, uint64_t> FlowQueue;
+
+    /**
+     * Per-flow scheduling state.
+     */
+    struct FlowState {
+        uint64_t total_jsize_ns = 0; // Cumulative job size (numerator)
+        uint64_t total_psize_bytes = 0; // Cumulative packet size (denominator)
+        FlowQueue::Handle handle; // Handle to the flow's queue entry
+    };
+
+    uint64_t num_rx_ = 0;
+    struct rte_ring* process_ring_;
+    struct rte_mempool* mbuf_pool_;
+    FlowTable<FlowState> flows_;
+    FlowQueue queue_;
+
+    // Internal helper methods
+    void dropMaxWeight();
+    void schedule(const uint32_t flow_idx);
+
+public:
+    static std::string name();
+    PolicyWSJFInorder(struct rte_mempool* mbuf_pool,
+                      struct rte_ring* process_ring);
+    uint32_t scheduleBurst();
+    void enqueueBurst(struct rte_mbuf** mbufs,
+                      const uint16_t num_mbufs);
+};
+
+#endif // SCHEDULER_BENCHMARK_SERVER_POLICIES_POLICY_WSJF_INORDER_H
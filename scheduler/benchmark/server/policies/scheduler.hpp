@@ -1,6 +1,10 @@
 #ifndef SCHEDULER_BENCHMARK_SERVER_POLICIES_SCHEDULER_HPP
 #define SCHEDULER_BENCHMARK_SERVER_POLICIES_SCHEDULER_HPP
 
+// Library headers
+#include "common/tsc_clock.h"
+#include "idle_poller.hpp"
+
 // STD headers
 #include <iostream>
 #include <stdint.h>
@@ -36,7 +40,7 @@ public:
     Scheduler(struct rte_mempool* pool, struct rte_ring* pr) :
               policy_(pool, pr), mbuf_pool_(pool) {}
 
-    void run(volatile bool *quit) {
+    void run(volatile bool *quit, const PollMode poll_mode) {
         if (rte_eth_dev_socket_id(0) > 0 &&
             rte_eth_dev_socket_id(0) != (int) rte_socket_id()) {
                 std::cout << "[Scheduler] WARNING, port 0 is on remote "
@@ -46,10 +50,13 @@ public:
         std::cout << "[Scheduler] Policy: "
                   << policy_.name() << std::endl;
 
+        IdlePoller poller(poll_mode);
         struct rte_mbuf *bufs[BURST_SIZE];
         while (likely(!(*quit))) {
+            const uint64_t start_tick = TscClock::now();
+
             // Schedule a burst of packets
-            policy_.scheduleBurst();
+            const uint32_t num_scheduled = policy_.scheduleBurst();
 
             // Fetch a burst of RX packets and push them onto the packet queue
             const uint16_t num_rx = rte_eth_rx_burst(0, 0, bufs, BURST_SIZE);
@@ -57,7 +64,15 @@ public:
                 num_total_rx_ += num_rx;
                 policy_.enqueueBurst(bufs, num_rx);
             }
+            // If neither RX nor scheduling made progress, back off. Note:
+            // there is no portable way to monitor the NIC's RX descriptors,
+            // so the scheduler never parks on an address.
+            if ((num_rx != 0) || (num_scheduled != 0)) {
+                poller.busy(start_tick);
+            }
+            else { poller.idle(); }
         }
+        poller.printStats("Scheduler");
     }
 };
 
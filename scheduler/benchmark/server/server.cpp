@@ -2,13 +2,18 @@
 #include "benchmark/packet.h"
 #include "common/macros.h"
 #include "common/tsc_clock.h"
+#include "kernels/kernel_factory.h"
+#include "policies/policy_drr.h"
 #include "policies/policy_fcfs.h"
+#include "policies/policy_sfq.h"
 #include "policies/policy_wsjf_dropmax.h"
 #include "policies/policy_wsjf_droptail.h"
 #include "policies/policy_wsjf_hffs.h"
+#include "policies/policy_wsjf_inorder.h"
 #include "policies/scheduler.hpp"
 
 // STD headers
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <signal.h>
@@ -36,21 +41,37 @@ static void signal_handler(int signum) {
 
 #define CMD_OPT_HELP "help"
 #define CMD_OPT_POLICY "policy"
+#define CMD_OPT_POLL_MODE "poll-mode"
+#define CMD_OPT_NF "nf"
+#define CMD_OPT_COLLISION_RATE "collision-rate"
 enum {
     /* long options mapped to short options: first long only option value must
     * be >= 256, so that it does not conflict with short options.
     */
     CMD_OPT_HELP_NUM = 256,
-    CMD_OPT_POLICY_NUM
+    CMD_OPT_POLICY_NUM,
+    CMD_OPT_POLL_MODE_NUM,
+    CMD_OPT_NF_NUM,
+    CMD_OPT_COLLISION_RATE_NUM
 };
 
 static void print_usage(const char* program_name) {
     printf("%s [EAL options] --"
         " [--help] |\n"
-        " [--policy POLICY]\n\n"
+        " [--policy POLICY]\n"
+        " [--poll-mode POLL_MODE]\n"
+        " [--nf NF]\n"
+        " [--collision-rate COLLISION_RATE]\n\n"
 
         "  --help: Show this help and exit\n"
-        "  --policy POLICY: Scheduling policy to use\n",
+        "  --policy POLICY: Scheduling policy to use\n"
+        "  --poll-mode POLL_MODE: Idle polling mode for lcores (spin, backoff,\n"
+        "                         or monitor; default: spin)\n"
+        "  --nf NF: NF kernel to run per packet (none, string_match,\n"
+        "           hash_lookup, or tcp_reassembly; default: none, which\n"
+        "           emulates the packet-encoded job size)\n"
+        "  --collision-rate COLLISION_RATE: Hash collision rate for the\n"
+        "                                   hash_lookup NF (default: 0)\n",
         program_name);
 }
 
@@ -60,6 +81,9 @@ static const char short_options[] = "";
 static const struct option long_options[] = {
     {CMD_OPT_HELP, no_argument, NULL, CMD_OPT_HELP_NUM},
     {CMD_OPT_POLICY, required_argument, NULL, CMD_OPT_POLICY_NUM},
+    {CMD_OPT_POLL_MODE, required_argument, NULL, CMD_OPT_POLL_MODE_NUM},
+    {CMD_OPT_NF, required_argument, NULL, CMD_OPT_NF_NUM},
+    {CMD_OPT_COLLISION_RATE, required_argument, NULL, CMD_OPT_COLLISION_RATE_NUM},
     {0, 0, 0, 0}
 };
 
@@ -72,16 +96,27 @@ enum WorkerIdx : uint8_t {
 struct worker_conf {
     struct rte_ring* process_ring;
     struct rte_ring* profile_ring;
+    PollMode poll_mode;
+    NFKernel* kernel;
 
-    worker_conf(struct rte_ring* process_ring, struct rte_ring* profile_ring) :
-                process_ring(process_ring), profile_ring(profile_ring) {}
+    worker_conf(struct rte_ring* process_ring, struct rte_ring* profile_ring,
+                PollMode poll_mode, NFKernel* kernel) :
+                process_ring(process_ring), profile_ring(profile_ring),
+                poll_mode(poll_mode), kernel(kernel) {}
+};
+
+// Command-line arguments
+struct cl_arguments {
+    std::string policy;
+    PollMode poll_mode = PollMode::SPIN;
+    std::string nf = "none";
+    NFKernel::Parameters nf_params;
 };
 
 /**
- * Returns (by reference) a string corresponding to the scheduling
- * policy to use.
+ * Parses the command-line arguments (by reference).
  */
-int get_policy_name(int argc, char** argv, std::string& policy) {
+int parse_cl_arguments(int argc, char** argv, cl_arguments& cl_args) {
     int opt;
     int long_index;
 
@@ -92,7 +127,20 @@ int get_policy_name(int argc, char** argv, std::string& policy) {
                 return 1;
             }
             case CMD_OPT_POLICY_NUM: {
-                policy = std::string(optarg);
+                cl_args.policy = std::string(optarg);
+                break;
+            }
+            case CMD_OPT_POLL_MODE_NUM: {
+                if (!parsePollMode(std::string(optarg),
+                                   cl_args.poll_mode)) { return -1; }
+                break;
+            }
+            case CMD_OPT_NF_NUM: {
+                cl_args.nf = std::string(optarg);
+                break;
+            }
+            case CMD_OPT_COLLISION_RATE_NUM: {
+                cl_args.nf_params.collision_rate = atof(optarg);
                 break;
             }
             default: {
@@ -202,21 +250,29 @@ lcore_profile(void* arg) {
     uint64_t ticks_per_us = clock_scale();
     uint64_t ticks_per_s = (ticks_per_us * 1000000);
 
+    // Job sizes (estimated vs. actual)
+    uint64_t total_jsize_estimated[2]{0, 0};
+    uint64_t total_jsize_actual[2]{0, 0};
+    uint64_t total_jsize_abs_error[2]{0, 0};
+
     // Instantaneous throughput
     uint64_t first_tick = 0;
     uint64_t current_tick = 0;
     uint64_t period_start_tick = TscClock::now();
     uint64_t period_end_tick = (period_start_tick + ticks_per_s);
+    IdlePoller poller(conf->poll_mode);
 
     // Run until the application is killed
     while (likely(!quit)) {
         if (likely(!rte_ring_empty(conf->profile_ring))) {
+            const uint64_t start_tick = TscClock::now();
             if (unlikely(num_processed_all == 0)) {
-                first_tick = TscClock::now();
+                first_tick = start_tick;
             }
             // Deque a packet from the profile ring
             rte_ring_sc_dequeue(conf->profile_ring, (void**) &mbuf);
             auto params = getPacketParams(mbuf); // Fetch parameters
+            const uint32_t jsize_actual = getActualJobSize(mbuf);
 
             // Deallocate the packet
             rte_pktmbuf_free(mbuf);
@@ -227,7 +283,16 @@ lcore_profile(void* arg) {
             total_psize_all += (params.psize_bytes * 8);
             total_psize[params.class_tag] += (params.psize_bytes * 8);
             period_psize[params.class_tag] += (params.psize_bytes * 8);
+            total_jsize_estimated[params.class_tag] += params.jsize_ns;
+            total_jsize_actual[params.class_tag] += jsize_actual;
+            total_jsize_abs_error[params.class_tag] += (
+                (jsize_actual > params.jsize_ns) ?
+                (jsize_actual - params.jsize_ns) :
+                (params.jsize_ns - jsize_actual));
+
+            poller.busy(start_tick);
         }
+        else { poller.idle(&conf->profile_ring->prod.tail); }
 
         // Display instantaneous goodput every 1s
         if ((current_tick = TscClock::now()) >= period_end_tick) {
@@ -276,6 +341,19 @@ lcore_profile(void* arg) {
               << std::fixed << std::setprecision(2)
               << goodput_gbps << " Gbps" << std::endl;
 
+    for (auto tag : {PacketClass::INNOCENT, PacketClass::ATTACK}) {
+        const double n = std::max<uint64_t>(1, num_processed[tag]);
+        std::cout << ((tag == PacketClass::INNOCENT) ? "Innocent" : "Attack")
+                  << " job size (estimated/actual/MAE): "
+                  << std::fixed << std::setprecision(2)
+                  << (total_jsize_estimated[tag] / n) << "/"
+                  << (total_jsize_actual[tag] / n) << "/"
+                  << (total_jsize_abs_error[tag] / n) << " ns"
+                  << std::endl;
+    }
+
+    poller.printStats("Profile");
+
     std::cout << std::endl;
     return 0;
 }
@@ -292,20 +370,40 @@ lcore_process(void* arg) {
     uint64_t period_end_tick;
     uint64_t period_start_tick = 0;
     uint64_t ticks_per_us = clock_scale();
+    IdlePoller poller(conf->poll_mode);
 
     // Run until the application is killed
     while (likely(!quit)) {
         if (unlikely(rte_ring_empty(conf->process_ring))) {
+            poller.idle(&conf->process_ring->prod.tail);
             continue;
         }
         else if (unlikely(period_start_tick == 0)) {
             period_start_tick = TscClock::now();
         }
+        const uint64_t start_tick = TscClock::now();
         // Deque a packet from the process ring
         rte_ring_sc_dequeue(conf->process_ring, (void**) &mbuf);
         auto params = getPacketParams(mbuf); // Fetch parameters
 
-        // Compute the end of the period
+        // If an NF kernel is specified, run it on the packet and
+        // record its measured cost as the packet's job size.
+        if (conf->kernel != nullptr) {
+            const uint64_t kernel_start_tick = TscClock::now();
+            conf->kernel->process(mbuf);
+            period_start_tick = TscClock::now();
+            setActualJobSize(mbuf, ((period_start_tick - kernel_start_tick)
+                                    * 1000) / ticks_per_us);
+
+            if (rte_ring_sp_enqueue(conf->profile_ring, mbuf) != 0) {
+                rte_pktmbuf_free(mbuf);
+            };
+            poller.busy(start_tick);
+            continue;
+        }
+        // Else, emulate the packet-encoded job size. Compute
+        // the end of the period.
+        setActualJobSize(mbuf, params.jsize_ns);
         period_end_tick = (period_start_tick +
                            (params.jsize_ns * ticks_per_us) / 1000);
         #ifdef DEBUG
@@ -317,10 +415,18 @@ lcore_process(void* arg) {
         }
         #endif
         // Stall for the required amount of time, then handoff to profiling
-        while ((period_start_tick = TscClock::now()) < period_end_tick) {}
+        poller.waitUntil(period_end_tick);
+        period_start_tick = TscClock::now();
         if (rte_ring_sp_enqueue(conf->profile_ring, mbuf) != 0) {
             rte_pktmbuf_free(mbuf);
         };
+        poller.busy(start_tick);
+    }
+    poller.printStats("Process");
+    if (conf->kernel != nullptr) {
+        std::cout << "[Process] NF kernel: " << conf->kernel->type()
+                  << " (result: " << conf->kernel->getSink() << ")"
+                  << std::endl;
     }
     return 0;
 }
@@ -329,15 +435,16 @@ lcore_process(void* arg) {
  * Scheduler dispatch routine.
  */
 template<typename Policy> void run_scheduler(
-    struct rte_mempool* pool, struct rte_ring* process_ring) {
-    Scheduler<Policy>(pool, process_ring).run(&quit); // Run scheduler
+    struct rte_mempool* pool, struct rte_ring* process_ring,
+    const PollMode poll_mode) {
+    Scheduler<Policy>(pool, process_ring).run(&quit, poll_mode); // Run scheduler
 }
 
 int main(int argc, char *argv[]) {
     struct rte_ring *process_ring = NULL;
     struct rte_ring *profile_ring = NULL;
     struct rte_mempool *mbuf_pool = NULL;
-    std::string policy;
+    cl_arguments cl_args;
 
     quit = false;
     signal(SIGINT, signal_handler);
@@ -352,7 +459,7 @@ int main(int argc, char *argv[]) {
     argv += ret;
 
     // Parse the scheduling policy from the CL arguments
-    if (get_policy_name(argc, argv, policy) != 0) {
+    if (parse_cl_arguments(argc, argv, cl_args) != 0) {
         print_usage(argv[0]);
         if (ret == 1) { return 0; }
         rte_exit(EXIT_FAILURE, "Invalid CLI options\n");
@@ -390,7 +497,7 @@ int main(int argc, char *argv[]) {
             // If using an FCFS scheduler, the scheduler queue and
             // process ring are one and the same. In this case, we
             // use the queue length to size the process ringbuffer.
-            const bool is_fcfs = (policy == PolicyFCFS::name());
+            const bool is_fcfs = (cl_args.policy == PolicyFCFS::name());
             unsigned int pr_size = is_fcfs ? SCHEDULER_QUEUE_SIZE :
                                              PROCESS_RING_SIZE;
 
@@ -414,32 +521,56 @@ int main(int argc, char *argv[]) {
         worker_idx++;
     }
 
+    // Instantiate the NF kernel
+    NFKernel* kernel = nullptr;
+    try { kernel = NFKernelFactory::generate(cl_args.nf, cl_args.nf_params); }
+    catch (const std::exception& e) {
+        rte_exit(EXIT_FAILURE, "%s\n", e.what());
+    }
     // Run the worker process
     worker_idx = 0;
     RTE_LCORE_FOREACH_WORKER(lcore_id) {
         if (worker_idx == WorkerIdx::PROCESS) {
             rte_eal_remote_launch(lcore_process, (void*) (
-                new worker_conf(process_ring, profile_ring)), lcore_id);
+                new worker_conf(process_ring, profile_ring,
+                                cl_args.poll_mode, kernel)), lcore_id);
         }
         else if (worker_idx == WorkerIdx::PROFILE) {
             rte_eal_remote_launch(lcore_profile, (void*) (
-                new worker_conf(process_ring, profile_ring)), lcore_id);
+                new worker_conf(process_ring, profile_ring,
+                                cl_args.poll_mode, kernel)), lcore_id);
         }
         else { rte_exit(EXIT_FAILURE, "Too many lcores\n"); }
         worker_idx++;
     }
     // Run the scheduler process
-    if (policy == PolicyFCFS::name()) {
-        run_scheduler<PolicyFCFS>(mbuf_pool, process_ring);
+    if (cl_args.policy == PolicyFCFS::name()) {
+        run_scheduler<PolicyFCFS>(mbuf_pool, process_ring,
+                          cl_args.poll_mode);
+    }
+    else if (cl_args.policy == PolicyWSJFFibonacciDropMax::name()) {
+        run_scheduler<PolicyWSJFFibonacciDropMax>(mbuf_pool, process_ring,
+                          cl_args.poll_mode);
+    }
+    else if (cl_args.policy == PolicyWSJFFibonacciDropTail::name()) {
+        run_scheduler<PolicyWSJFFibonacciDropTail>(mbuf_pool, process_ring,
+                          cl_args.poll_mode);
+    }
+    else if (cl_args.policy == PolicyWSJFFHierarchicalFFS::name()) {
+        run_scheduler<PolicyWSJFFHierarchicalFFS>(mbuf_pool, process_ring,
+                          cl_args.poll_mode);
     }
-    else if (policy == PolicyWSJFFibonacciDropMax::name()) {
-        run_scheduler<PolicyWSJFFibonacciDropMax>(mbuf_pool, process_ring);
+    else if (cl_args.policy == PolicyWSJFInorder::name()) {
+        run_scheduler<PolicyWSJFInorder>(mbuf_pool, process_ring,
+                          cl_args.poll_mode);
     }
-    else if (policy == PolicyWSJFFibonacciDropTail::name()) {
-        run_scheduler<PolicyWSJFFibonacciDropTail>(mbuf_pool, process_ring);
+    else if (cl_args.policy == PolicySFQ::name()) {
+        run_scheduler<PolicySFQ>(mbuf_pool, process_ring,
+                          cl_args.poll_mode);
     }
-    else if (policy == PolicyWSJFFHierarchicalFFS::name()) {
-        run_scheduler<PolicyWSJFFHierarchicalFFS>(mbuf_pool, process_ring);
+    else if (cl_args.policy == PolicyDRR::name()) {
+        run_scheduler<PolicyDRR>(mbuf_pool, process_ring,
+                          cl_args.poll_mode);
     }
     else {
         quit = true;
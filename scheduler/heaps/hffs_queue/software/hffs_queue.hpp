@@ -6,6 +6,7 @@
 #include "common/utils.h"
 
 // STD headers
+#include <iterator>
 #include <list>
 #include <stdexcept>
 #include <vector>
@@ -76,6 +77,15 @@ public:
         Weight denominator;
     };
 
+    /**
+     * Handle to a queued entry (invalidated once
+     * the entry is either popped or erased).
+     */
+    struct Handle {
+        uint32_t bucket_idx = 0;
+        typename std::list<Tag>::iterator iter;
+    };
+
     /**
      * Returns the current queue size.
      */
@@ -137,6 +147,28 @@ public:
         return entry;
     }
 
+    /**
+     * Internal helper method. Clears the bitmap sub-tree
+     * corresponding to the given (now-empty) bucket.
+     */
+    void clearBucket_(const uint32_t bucket_idx) {
+        int bit_idx = (bucket_idx & 0x1F);
+        uint32_t intralevel_bitmap_idx = (bucket_idx / 32);
+        bool update = true;
+        for (int idx = (kNumLevels - 1); idx >= 0 && update; idx--) {
+            uint32_t bitmap_idx = (level_offsets_[idx] +
+                                   intralevel_bitmap_idx);
+            // Apply the mask
+            uint32_t mask = ~(1UL << bit_idx);
+            bitmaps_[bitmap_idx] &= mask;
+            update = (bitmaps_[bitmap_idx] == 0);
+
+            // Compute the indices for the next level
+            bit_idx = (intralevel_bitmap_idx & 0x1F);
+            intralevel_bitmap_idx /= 32;
+        }
+    }
+
     /**
      * Pops (and returns) the tag corresponding to the min element.
      * @throw runtime error if the queue is currently empty.
@@ -150,9 +182,10 @@ public:
     inline Tag popMax() { return pop_<false>(); }
 
     /**
-     * Pushes a new entry onto the queue.
+     * Pushes a new entry onto the queue. Returns a handle
+     * that may be used to erase the entry in O(1).
      */
-    void push(const Tag tag, const UnscaledWeight weight) {
+    Handle push(const Tag tag, const UnscaledWeight weight) {
         // Insert the given entry into the corresponding bucket
         uint32_t bucket_idx = uint32_t(
             (weight.numerator * kScaleFactor) / weight.denominator);
@@ -179,6 +212,30 @@ public:
         }
         // Update queue size
         size_++;
+        return Handle{bucket_idx, std::prev(buckets_[bucket_idx].end())};
+    }
+
+    /**
+     * Erases the entry corresponding to the given handle.
+     */
+    void erase(const Handle& handle) {
+        SP_ASSERT(LIKELY(handle.bucket_idx < kNumBuckets));
+        std::list<Tag>& bucket = buckets_[handle.bucket_idx];
+        bucket.erase(handle.iter);
+
+        // If this bucket becomes empty, update the bitmap tree
+        if (bucket.empty()) { clearBucket_(handle.bucket_idx); }
+        size_--; // Update queue size
+    }
+
+    /**
+     * Updates the weight of the entry corresponding to the given
+     * handle. Returns a new handle (the old one is invalidated).
+     */
+    Handle update(const Handle& handle, const UnscaledWeight weight) {
+        Tag tag = *handle.iter;
+        erase(handle);
+        return push(tag, weight);
     }
 };
 
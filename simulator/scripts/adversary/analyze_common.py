@@ -1,6 +1,8 @@
 from __future__ import annotations
 from abc import ABC, abstractmethod
 import io, libconf
+import numpy as np
+import packet_log
 
 class SchedulingMetrics:
     """Metrics used for scheduling."""
@@ -26,17 +28,14 @@ class Packet:
         self.metrics = SchedulingMetrics(psize, jsize)
 
     @staticmethod
-    def from_log(line: str) -> Packet:
-        """Parse a line of packet log (simulator output)."""
-        values = [x.strip() for x in line.split(";")]
-        assert len(values) >= 6 # Sanity check
-
-        return Packet(float(values[0]), # Arrival clk
-                      float(values[1]), # Depart clk
-                      values[2],        # Flow ID
-                      values[3],        # Class tag
-                      int(values[4]),   # Packet size
-                      float(values[5])) # Job size (estimate)
+    def from_log(record: packet_log.PacketLogRecord) -> Packet:
+        """Parse a packet log record (simulator output)."""
+        return Packet(record.arrive_clk,        # Arrival clk
+                      record.depart_clk,        # Depart clk
+                      record.flow_id,           # Flow ID
+                      record.class_tag,         # Class tag
+                      record.psize,             # Packet size
+                      record.jsize_estimate)    # Job size (estimate)
 
 class AttackStrategy:
     """Represents an adversary's attack strategy."""
@@ -74,6 +73,14 @@ class BaseAnalyzer(ABC):
         """Implementation-specific packet analysis."""
         raise NotImplementedError
 
+    def _analyze_log_columns(self, columns: dict) -> None:
+        """Implementation-specific analysis of a columnar log (see
+        packet_log.load_columns). By default, falls back to per-packet
+        analysis; implementations may override this with vectorized
+        equivalents of _analyze_log_packet."""
+        for record in packet_log.iter_columns(columns):
+            self._analyze_log_packet(Packet.from_log(record))
+
     @abstractmethod
     def get_optimal_strategy(
         self, r_I_gbps: float, r_A_gbps: float) -> AttackStrategy:
@@ -81,26 +88,49 @@ class BaseAnalyzer(ABC):
            the adversary's optimal strategy for the policy."""
         raise NotImplementedError
 
+    def _analyze_record_log(self, log_fp: str) -> None:
+        """Analyzes the given (binary or text) log file."""
+        for record in packet_log.read(log_fp):
+            packet = Packet.from_log(record)
+            psize = packet.metrics.psize
+            jsize = packet.metrics.jsize
+
+            # Update statistics
+            self.num_total_packets += 1
+            self.average_innocent_psize += psize
+            self.average_innocent_jsize += jsize
+            self.maximum_innocent_psize = max(
+                self.maximum_innocent_psize, psize)
+
+            self.maximum_innocent_jsize = max(
+                self.maximum_innocent_jsize, jsize)
+
+            # Invoke the specific parsing functionality
+            self._analyze_log_packet(packet)
+
+    def _analyze_columnar_log(self, log_fp: str) -> None:
+        """Analyzes the given columnar log file."""
+        columns = packet_log.load_columns(log_fp)
+        psizes = columns["psize"]
+        jsizes = columns["jsize_est"]
+
+        # Update statistics
+        self.num_total_packets = len(psizes)
+        if self.num_total_packets > 0:
+            self.average_innocent_psize = int(psizes.sum(dtype=np.uint64))
+            self.average_innocent_jsize = float(jsizes.sum())
+            self.maximum_innocent_psize = max(0, int(psizes.max()))
+            self.maximum_innocent_jsize = max(0, float(jsizes.max()))
+
+        # Invoke the specific parsing functionality
+        self._analyze_log_columns(columns)
+
     def _analyze_log(self, log_fp: str) -> None:
         """Analyzes the given log file."""
-        with open(log_fp, 'r') as lines:
-            for line in lines:
-                packet = Packet.from_log(line)
-                psize = packet.metrics.psize
-                jsize = packet.metrics.jsize
-
-                # Update statistics
-                self.num_total_packets += 1
-                self.average_innocent_psize += psize
-                self.average_innocent_jsize += jsize
-                self.maximum_innocent_psize = max(
-                    self.maximum_innocent_psize, psize)
-
-                self.maximum_innocent_jsize = max(
-                    self.maximum_innocent_jsize, jsize)
-
-                # Invoke the specific parsing functionality
-                self._analyze_log_packet(packet)
+        if packet_log.is_columnar(log_fp):
+            self._analyze_columnar_log(log_fp)
+        else:
+            self._analyze_record_log(log_fp)
 
         # Compute the average packet and job size, and r_Max
         self.average_innocent_psize /= self.num_total_packets
@@ -16,6 +16,10 @@ class FCFSAnalyzer(common.BaseAnalyzer):
         """Implementation-specific parsing."""
         return
 
+    def _analyze_log_columns(self, columns: dict) -> None:
+        """Implementation-specific parsing (columnar)."""
+        return
+
     def get_optimal_strategy(
         self, r_I_gbps: float, r_A_gbps: float) -> common.AttackStrategy:
         """Given a configuration, returns a tuple representing
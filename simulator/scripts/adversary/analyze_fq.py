@@ -1,4 +1,7 @@
 import adversary.analyze_common as common
+import packet_log
+
+import numpy as np
 
 class FQAnalyzer(common.BaseAnalyzer):
     """Performs analysis for FQ scheduling."""
@@ -18,6 +21,13 @@ class FQAnalyzer(common.BaseAnalyzer):
         """Implementation-specific parsing."""
         self.flows.add(packet.flow_id)
 
+    def _analyze_log_columns(self, columns: dict) -> None:
+        """Implementation-specific parsing (columnar)."""
+        for flow in np.unique(columns["flow"]):
+            self.flows.add(packet_log.flow_id_str(
+                int(flow["src_ip"]), int(flow["dst_ip"]),
+                int(flow["src_port"]), int(flow["dst_port"])))
+
     def get_optimal_strategy(
         self, r_I_gbps: float, r_A_gbps: float) -> common.AttackStrategy:
         """Given a configuration, returns a tuple representing
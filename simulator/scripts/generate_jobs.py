@@ -52,10 +52,17 @@ def generate_jobs() -> None:
         help="Whether to save packet logs for each simulation run"
     )
 
+    parser.add_argument(
+        "--sweep", action="store_true",
+        help="Whether to run all simulations in a single (multi-threaded) simulator " +
+             "process, instead of generating one simulator process per configuration"
+    )
+
     # Parse arguments
     args = parser.parse_args()
     output_dir = args.output_dir
     keep_packets = args.keep_packets
+    use_sweep = args.sweep
     template_cfg_fp = args.template_cfg
     simulator_path = args.simulator_path
 
@@ -97,7 +104,8 @@ def generate_jobs() -> None:
     log_fp = os.path.join(output_dir, "log.packets")
     subprocess.run(["{}".format(simulator_path),
                     "--config={}".format(template_cfg_fp),
-                    "--packets={}".format(log_fp), "--dry"])
+                    "--packets={}".format(log_fp),
+                    "--packets_format=columnar", "--dry"])
 
     # If the dry-run failed, return immediately
     if not os.path.isfile(log_fp):
@@ -123,6 +131,7 @@ def generate_jobs() -> None:
     # If the log was successfully created, perform analysis
     # for each specified policy and generate jobs for them.
     jobs = ""
+    sweep_points = []
     for policy in policies:
         analyzer = None
 
@@ -181,6 +190,30 @@ def generate_jobs() -> None:
 
                 print("\t\t{}".format(output))
 
+                # Output summary
+                summary_fp = os.path.join(output_dir, "outputs", policy,
+                                          "{}.out".format(filename))
+                # Packets file path
+                packets_fp = os.path.join(output_dir, "packets", policy,
+                                          "{}.packets".format(filename))
+
+                # In sweep mode, simply record the grid point
+                if use_sweep:
+                    point = {
+                        "name": "{}_{}".format(policy, filename),
+                        "policy": policy,
+                        "innocent_rate_bps": float(r_I),
+                        "average_packet_size_bits": float(analyzer.average_innocent_psize),
+                        "attack_rate_bps": float(r_A),
+                        "attack_num_flows": 1000000,
+                        "attack_packet_size_bits": int(strategy.psize),
+                        "attack_job_size_ns": float(strategy.estimated_jsize),
+                        "output_fp": summary_fp,
+                    }
+                    if keep_packets: point["packets_fp"] = packets_fp
+                    sweep_points.append(point)
+                    continue
+
                 # Open and edit the template configuration
                 with io.open(template_cfg_fp) as in_cfg:
                     config = libconf.load(in_cfg)
@@ -200,13 +233,6 @@ def generate_jobs() -> None:
                     with open(out_config_fp, 'w') as out_cfg:
                         libconf.dump(config, out_cfg)
 
-                # Output summary
-                summary_fp = os.path.join(output_dir, "outputs", policy,
-                                          "{}.out".format(filename))
-                # Packets file path
-                packets_fp = os.path.join(output_dir, "packets", policy,
-                                          "{}.packets".format(filename))
-
                 # Create a new simulation job
                 jobs += (
                     "{} --config={} ".format(simulator_path, out_config_fp) +
@@ -217,6 +243,21 @@ def generate_jobs() -> None:
             print()
         print()
 
+    # In sweep mode, write the grid specification and
+    # create a single job that simulates every point.
+    if use_sweep:
+        sweep_fp = os.path.join(output_dir, "sweep.cfg")
+        with open(sweep_fp, 'w') as sweep_cfg:
+            libconf.dump({"points": tuple(sweep_points)}, sweep_cfg)
+
+        jobs = (
+            "{} --config={} ".format(simulator_path,
+                os.path.join(output_dir, "template.cfg")) +
+            "--sweep={} ".format(sweep_fp) +
+            "--results={}".format(os.path.join(output_dir, "results.csv")) +
+            "\n"
+        )
+
     # Write the jobs shell script and make it executable
     jobs_fp = os.path.join(output_dir, "jobs.sh")
     with open(jobs_fp, 'w') as jobs_f: jobs_f.write(jobs)
@@ -0,0 +1,155 @@
+from __future__ import annotations
+
+import os
+import struct
+from typing import Dict, Iterator, NamedTuple
+
+class PacketLogRecord(NamedTuple):
+    """Represents a single packet log record (see
+    simulator/src/logging/packet_log.h)."""
+    arrive_clk: float # Arrival clock (ns)
+    depart_clk: float # Departure clock (ns)
+    flow_id: str # Flow ID (hex string)
+    class_tag: str # Traffic class ('I' or 'A')
+    psize: int # Packet size (bits)
+    jsize_estimate: float # Estimated job size (ns)
+    jsize_actual: float # Actual job size (ns)
+
+# Binary format parameters (must match packet_log.h)
+MAGIC = b"SPPKTLOG"
+VERSION = 1
+HEADER = struct.Struct("<8sIIQQ") # Magic, version, record size, count, reserved
+RECORD = struct.Struct("<ddddQIIHHIB7x") # Times, job sizes, idx, flow ID, psize, class
+RECORDS_PER_READ = (1 << 14)
+
+# Columnar format parameters (must match packet_log.h)
+COLUMNAR_MAGIC = b"SPPKTCOL"
+COLUMNAR_VERSION = 1
+COLUMNAR_HEADER = struct.Struct("<8sIIQQ") # Magic, version, columns, count, reserved
+COLUMN = struct.Struct("<16s8sQQ") # Name, dtype, element size, offset
+COLUMNS = ["arrive", "depart", "flow", "class",
+           "psize", "jsize_est", "jsize_act"]
+
+def _read_magic(log_fp: str) -> bytes:
+    """Returns the magic string of the given packet log."""
+    with open(log_fp, 'rb') as log:
+        return log.read(len(MAGIC))
+
+def is_binary(log_fp: str) -> bool:
+    """Returns whether the given packet log is in the binary format."""
+    return _read_magic(log_fp) == MAGIC
+
+def is_columnar(log_fp: str) -> bool:
+    """Returns whether the given packet log is in the columnar format."""
+    return _read_magic(log_fp) == COLUMNAR_MAGIC
+
+def flow_id_str(src_ip: int, dst_ip: int, src_port: int, dst_port: int) -> str:
+    """Returns the (hex string) representation of the given flow ID."""
+    return "{:08x}{:08x}{:04x}{:04x}".format(src_ip, dst_ip, src_port, dst_port)
+
+def load_columns(log_fp: str) -> Dict[str, "numpy.ndarray"]:
+    """Maps the columns of the given columnar packet log into memory
+    (zero-copy, read-only), returning a dict of column name to array.
+    The "flow" column is a structured array with fields src_ip, dst_ip,
+    src_port, and dst_port; "class" is 0 (innocent) or 1 (attack)."""
+    import numpy as np
+    with open(log_fp, 'rb') as log:
+        magic, version, num_columns, num_records, _ = COLUMNAR_HEADER.unpack(
+            log.read(COLUMNAR_HEADER.size))
+
+        if magic != COLUMNAR_MAGIC or version != COLUMNAR_VERSION:
+            raise ValueError("{} is not a valid (v{}) columnar packet log".format(
+                log_fp, COLUMNAR_VERSION))
+
+        descriptors = [COLUMN.unpack(log.read(COLUMN.size))
+                       for _ in range(num_columns)]
+
+    flow_dtype = np.dtype([("src_ip", "<u4"), ("dst_ip", "<u4"),
+                           ("src_port", "<u2"), ("dst_port", "<u2")])
+    columns = dict()
+    for name, dtype, elem_size, offset in descriptors:
+        name = name.rstrip(b"\0").decode()
+        dtype = (flow_dtype if name == "flow" else
+                 np.dtype(dtype.rstrip(b"\0").decode()))
+
+        assert dtype.itemsize == elem_size # Sanity check
+        columns[name] = (np.memmap(log_fp, dtype=dtype, mode='r',
+                                   offset=offset, shape=(num_records,))
+                         if num_records > 0 else np.empty(0, dtype=dtype))
+    return columns
+
+def _read_binary(log_fp: str) -> Iterator[PacketLogRecord]:
+    """Yields the records in the given binary packet log."""
+    with open(log_fp, 'rb') as log:
+        magic, version, record_size, num_records, _ = HEADER.unpack(
+            log.read(HEADER.size))
+
+        if magic != MAGIC or version != VERSION or record_size != RECORD.size:
+            raise ValueError("{} is not a valid (v{}) packet log".format(
+                log_fp, VERSION))
+
+        # If the record count is unset (e.g., the log was truncated),
+        # infer the number of (complete) records from the file size.
+        if num_records == 0:
+            num_records = (os.path.getsize(log_fp) - HEADER.size) // RECORD.size
+
+        while num_records > 0:
+            count = min(num_records, RECORDS_PER_READ)
+            data = log.read(count * RECORD.size)
+            count = len(data) // RECORD.size
+            if count == 0: break
+
+            for (arrive_clk, depart_clk, jsize_estimate, jsize_actual, _,
+                 src_ip, dst_ip, src_port, dst_port, psize, traffic_class) in \
+                RECORD.iter_unpack(data[:count * RECORD.size]):
+
+                yield PacketLogRecord(
+                    arrive_clk, depart_clk,
+                    flow_id_str(src_ip, dst_ip, src_port, dst_port),
+                    'A' if traffic_class == 1 else 'I',
+                    psize, jsize_estimate, jsize_actual)
+
+            num_records -= count
+
+def iter_columns(columns: Dict[str, "numpy.ndarray"]) -> Iterator[PacketLogRecord]:
+    """Yields the records in the given (loaded) columns. Note: This is
+    convenient, but slow; prefer operating on the columns directly."""
+    num_records = len(columns["arrive"])
+    for start in range(0, num_records, RECORDS_PER_READ):
+        chunk = {name: column[start:start + RECORDS_PER_READ].tolist()
+                 for name, column in columns.items()}
+
+        for (arrive_clk, depart_clk, flow, traffic_class, psize,
+             jsize_estimate, jsize_actual) in zip(*[chunk[name]
+                                                    for name in COLUMNS]):
+            yield PacketLogRecord(
+                arrive_clk, depart_clk, flow_id_str(*flow),
+                'A' if traffic_class == 1 else 'I',
+                psize, jsize_estimate, jsize_actual)
+
+def _read_columnar(log_fp: str) -> Iterator[PacketLogRecord]:
+    """Yields the records in the given columnar packet log."""
+    return iter_columns(load_columns(log_fp))
+
+def _read_text(log_fp: str) -> Iterator[PacketLogRecord]:
+    """Yields the records in the given text packet log."""
+    with open(log_fp, 'r') as lines:
+        for line in lines:
+            values = [x.strip() for x in line.split(";")]
+            assert len(values) >= 7 # Sanity check
+
+            yield PacketLogRecord(float(values[0]), # Arrival clk
+                                  float(values[1]), # Depart clk
+                                  values[2],        # Flow ID
+                                  values[3],        # Class tag
+                                  int(values[4]),   # Packet size
+                                  float(values[5]), # Job size (estimate)
+                                  float(values[6])) # Job size (actual)
+
+def read(log_fp: str) -> Iterator[PacketLogRecord]:
+    """Yields the records in the given packet log (in departure
+    order), automatically detecting the log format."""
+    magic = _read_magic(log_fp)
+    if magic == MAGIC: return _read_binary(log_fp)
+    elif magic == COLUMNAR_MAGIC: return _read_columnar(log_fp)
+    return _read_text(log_fp)
@@ -84,6 +84,18 @@ public:
      * Returns the estimated time (in ns) to process the packet.
      */
     virtual double getJobSizeEstimate(const Packet& packet) = 0;
+
+    /**
+     * Resets any (per-flow) application state. Stateless
+     * applications need not override this method.
+     */
+    virtual void reset() {}
+
+    /**
+     * Seeds the application's random streams (if any).
+     * Deterministic applications need not override this.
+     */
+    virtual void seed(const uint64_t /* seed */) {}
 };
 
 #endif // SIMULATOR_APPLICATIONS_APPLICATION_H
@@ -2,9 +2,6 @@
 
 // Library headers
 #include "common/distributions/distribution_factory.h"
-#include "echo.h"
-#include "iid_job_sizes.h"
-#include "tcp_reassembly.h"
 
 // STD headers
 #include <stdexcept>
@@ -3,6 +3,10 @@
 
 // Library headers
 #include "application.h"
+#include "common/type_dispatch.h"
+#include "echo.h"
+#include "iid_job_sizes.h"
+#include "tcp_reassembly.h"
 
 // Libconfig
 #include <libconfig.h++>
@@ -12,6 +16,10 @@
  */
 class ApplicationFactory final {
 public:
+    // Built-in application types (see Simulator::run)
+    typedef TypeDispatcher<Application, Echo, IIDJobSizes,
+                           TCPReassembly> Types;
+
     /**
      * Returns an application corresponding
      * to the parameterized configuration.
@@ -42,6 +42,13 @@ public:
      * Returns the estimated time (in ns) to process the packet.
      */
     virtual double getJobSizeEstimate(const Packet& packet) override;
+
+    /**
+     * Seeds the job size distribution.
+     */
+    virtual void seed(const uint64_t seed) override {
+        jsize_dist_->seed(seed);
+    }
 };
 
 #endif // SIMULATOR_APPLICATIONS_IID_JOB_SIZES_H
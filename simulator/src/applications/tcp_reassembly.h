@@ -95,6 +95,11 @@ public:
      * Returns the expected job size (in ns) to process the packet.
      */
     virtual double getJobSizeEstimate(const Packet& packet) override;
+
+    /**
+     * Resets the per-flow reassembly state.
+     */
+    virtual void reset() override { flows_.clear(); }
 };
 
 #endif // SIMULATOR_APPLICATIONS_TCP_REASSEMBLY_H
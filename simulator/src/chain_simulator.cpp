@@ -0,0 +1,520 @@
+#include "chain_simulator.h"
+
+// Library headers
+#include "applications/application_factory.h"
+#include "common/histogram.h"
+#include "common/philox.h"
+#include "common/utils.h"
+#include "queueing/queue_factory.h"
+#include "simulator.h"
+#include "traffic/synthetic_trafficgen.h"
+#include "traffic/trafficgen_factory.h"
+
+// STD headers
+#include <algorithm>
+#include <assert.h>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * ChainResults implementation.
+ */
+void ChainResults::print(std::ostream& out) const {
+    out << "==========================================" << std::endl
+        << "         Chain Simulation Results         " << std::endl
+        << "==========================================" << std::endl;
+
+    // Display per-stage metrics
+    const bool has_attack = (num_arrivals != num_innocent_arrivals);
+    for (size_t idx = 0; idx < stages.size(); idx++) {
+        const StageResults& stage = stages[idx];
+        out << std::fixed << std::setprecision(2);
+        out << "Stage " << idx << " (" << stage.application << ", "
+            << stage.policy << ")" << std::endl;
+        out << "Arrivals: " << stage.num_arrivals << std::endl;
+        if (stage.num_filtered != 0) {
+            out << "Filtered: " << stage.num_filtered << std::endl;
+        }
+        if ((stage.num_drops_i != 0) || (stage.num_drops_a != 0)) {
+            out << "Drops (innocent/attack): " << stage.num_drops_i << " / "
+                << stage.num_drops_a << std::endl;
+        }
+        out << "Server utilization:";
+        for (size_t s = 0; s < stage.server_utilizations.size(); s++) {
+            out << ((s == 0) ? " " : ", ") << (stage.server_utilizations[s] * 100);
+        }
+        out << " %" << std::endl;
+        out << "Innocent sojourn time (p50/p99): " << stage.latency_p50_ns_i
+            << " / " << stage.latency_p99_ns_i << " ns" << std::endl;
+        if (has_attack) {
+            out << "Attack sojourn time (p50/p99): " << stage.latency_p50_ns_a
+                << " / " << stage.latency_p99_ns_a << " ns" << std::endl;
+        }
+        out << std::setprecision(4) << "Innocent goodput: "
+            << stage.goodput_gbps << " Gbps" << std::endl;
+        out << std::endl;
+    }
+
+    // Display end-to-end metrics
+    out << std::fixed << std::setprecision(2);
+    out << "End-to-end" << std::endl;
+    out << "Innocent packet rate: " << input_rate_gbps_i << " Gbps" << std::endl;
+    out << "Innocent arrivals: " << num_innocent_arrivals << std::endl;
+    out << "Total arrivals: " << num_arrivals << std::endl;
+    out << "Innocent latency (p50/p99/p99.9): " << latency_p50_ns_i << " / "
+        << latency_p99_ns_i << " / " << latency_p999_ns_i << " ns" << std::endl;
+    if (has_attack) {
+        out << "Attack latency (p50/p99/p99.9): " << latency_p50_ns_a << " / "
+            << latency_p99_ns_a << " / " << latency_p999_ns_a << " ns" << std::endl;
+    }
+    out << std::setprecision(4);
+    out << "Average goodput: " << goodput_gbps << " Gbps" << std::endl;
+    out << "Displacement factor: " << displacement_factor << std::endl;
+    out << std::endl;
+}
+
+/**
+ * ChainSimulator implementation.
+ */
+ChainSimulator::ChainSimulator(const libconfig::Setting& config) :
+    kSeed(Simulator::getRandomSeed()) { parseChainConfig(config); }
+
+void ChainSimulator::printConfig() const {
+    std::cout << "==========================================" << std::endl
+              << "               Input Config               " << std::endl
+              << "==========================================" << std::endl;
+
+    std::cout << "Seed: " << kSeed << std::endl;
+    std::cout << "Chain: " << stages_.size() << " stage(s)" << std::endl;
+    for (size_t idx = 0; idx < stages_.size(); idx++) {
+        const Stage& stage = stages_[idx];
+        std::cout << "Stage " << idx << ": " << stage.queue->type()
+                  << " (servers: " << stage.server->getNumServers();
+        if (stage.capacity.isBounded()) {
+            std::cout << ", queue capacity:";
+            stage.capacity.print(std::cout);
+        }
+        std::cout << "), application: ";
+        stage.application->printConfiguration();
+        std::cout << std::endl;
+    }
+    for (const std::unique_ptr<TrafficGenerator>& tg : tg_innocents_) {
+        std::cout << std::endl << "Innocent traffic-gen: ";
+        tg->printConfiguration();
+    }
+    for (const std::unique_ptr<TrafficGenerator>& tg : tg_attacks_) {
+        std::cout << std::endl << "Attack traffic-gen: ";
+        tg->printConfiguration();
+    }
+    std::cout << std::endl;
+}
+
+void ChainSimulator::parseChainConfig(const libconfig::Setting& config) {
+    // Reject (top-level) settings that chains do not support. Note:
+    // Per-stage settings are specified within each stage instead.
+    static const std::vector<std::string> kUnsupportedKeys = {
+        "policy", "policies", "application", "num_servers",
+        "server_speeds", "topology", "rss_hash", "queue_capacity_packets",
+        "queue_capacity_bytes", "drop_policy", "preemptive",
+        "context_switch_ns", "batching", "scheduler_cost",
+        "per_flow_latency", "batch_size", "ci_width"};
+
+    for (const std::string& key : kUnsupportedKeys) {
+        if (config.exists(key)) {
+            throw std::runtime_error("'" + key + "' is not supported " +
+                                     "for NF chains (at the top level).");
+        }
+    }
+    // Parse the maximum arrival count
+    kMaxNumArrivals = std::numeric_limits<uint64_t>::max();
+    if (config.exists("max_num_arrivals")) {
+        kMaxNumArrivals = static_cast<unsigned
+            long long>(config.lookup("max_num_arrivals"));
+    }
+    // Parse the RNG seed (if any)
+    unsigned long long seed;
+    if (config.lookupValue("seed", seed)) { kSeed = seed; }
+
+    // Parse the stages. Every stage specifies its own policy,
+    // application, server pool, and (optionally) queue capacity.
+    if (!config.exists("chain") || !config["chain"].isList() ||
+        (config["chain"].getLength() == 0)) {
+        throw std::runtime_error("'chain' must be a non-empty list of stages.");
+    }
+    const libconfig::Setting& chain = config["chain"];
+    for (int idx = 0; idx < chain.getLength(); idx++) {
+        const libconfig::Setting& stage_config = chain[idx];
+        Stage stage;
+
+        std::string policy;
+        if (!stage_config.lookupValue("policy", policy)) {
+            throw std::runtime_error("Must specify 'policy' for every stage.");
+        }
+        if (!stage_config.exists("application")) {
+            throw std::runtime_error(
+                "Must specify 'application' for every stage.");
+        }
+        stage.capacity = parseQueueCapacity(stage_config);
+        stage.queue.reset(QueueFactory::generate(policy));
+        stage.queue->setDoubleEnded(stage.capacity.isBounded() &&
+            (stage.capacity.drop_policy == DropPolicy::MAX));
+        stage.application.reset(ApplicationFactory::generate(
+            stage_config["application"]));
+
+        stage.server.reset(new Server(stage.application.get(),
+            stage.queue.get(), &arena_, parseServerSpeeds(stage_config)));
+        stages_.push_back(std::move(stage));
+    }
+
+    // Generate the traffic-gens. Note: Synthetic traffic-gens
+    // are assigned disjoint ranges of flow IDs.
+    uint32_t fid_offset = 0;
+    if (!config.exists("innocent_traffic")) {
+        throw std::runtime_error("Must specify 'innocent_traffic'.");
+    }
+    for (const libconfig::Setting* tg_config :
+         getConfigList(config["innocent_traffic"])) {
+        tg_innocents_.emplace_back(TrafficGeneratorFactory::generate(
+            false, TrafficClass::INNOCENT, *tg_config, fid_offset));
+
+        fid_offset += tg_innocents_.back()->getNumFlows();
+    }
+    if (!config.exists("attack_traffic")) {
+        AttackTrafficGenerator* tg_attack = new AttackTrafficGenerator(
+            0, 0, new ConstantDistribution(kDblPosInfty), 0, kInvalidJobSize);
+
+        tg_attack->calibrate(0);
+        tg_attacks_.emplace_back(tg_attack);
+    }
+    else {
+        for (const libconfig::Setting* tg_config :
+             getConfigList(config["attack_traffic"])) {
+            tg_attacks_.emplace_back(TrafficGeneratorFactory::generate(
+                false, TrafficClass::ATTACK, *tg_config, fid_offset));
+
+            fid_offset += tg_attacks_.back()->getNumFlows();
+        }
+    }
+    if (tg_innocents_.empty() || tg_attacks_.empty()) {
+        throw std::runtime_error("Traffic lists must not be empty.");
+    }
+
+    // Maximum arrival count should be set iff not using a trace
+    validateMaxNumArrivals(kMaxNumArrivals, tg_innocents_);
+}
+
+void ChainSimulator::reset() {
+    arena_.reset();
+    for (Stage& stage : stages_) {
+        stage.queue->setPacketArena(&arena_);
+        stage.queue->reset();
+        stage.server->reset(); // Also resets the application
+    }
+    for (std::unique_ptr<TrafficGenerator>& tg : tg_innocents_) { tg->reset(); }
+    for (std::unique_ptr<TrafficGenerator>& tg : tg_attacks_) { tg->reset(); }
+
+    // Seed the RNG streams (as in the Simulator). Note: The
+    // first stage's application uses the same stream as the
+    // Simulator's, so single-stage chains are equivalent.
+    const uint64_t seed = deriveSeed(kSeed, num_runs_);
+    for (uint32_t idx = 0; idx < stages_.size(); idx++) {
+        stages_[idx].application->seed(
+            deriveSeed(seed, kApplicationStreamsStart + idx));
+    }
+    for (uint32_t idx = 0; idx < tg_innocents_.size(); idx++) {
+        tg_innocents_[idx]->seed(deriveSeed(seed, kInnocentStreamsStart + idx));
+    }
+    for (uint32_t idx = 0; idx < tg_attacks_.size(); idx++) {
+        tg_attacks_[idx]->seed(deriveSeed(seed, kAttackStreamsStart + idx));
+    }
+}
+
+ChainResults ChainSimulator::run(const bool verbose) {
+    reset();
+    if (verbose) { printConfig(); }
+
+    // Event IDs. Note: Simultaneous events are processed in ID
+    // order, so departures precede arrivals, and upstream stages
+    // precede downstream ones.
+    const uint32_t num_stages = stages_.size();
+    const uint32_t kInnocentEventsStart = num_stages;
+    const uint32_t kAttackEventsStart = (kInnocentEventsStart +
+                                         tg_innocents_.size());
+    calendar_.reset(kAttackEventsStart + tg_attacks_.size());
+
+    // Housekeeping
+    uint64_t num_arrivals = 0; // Total number of arrivals
+    uint64_t num_innocent_arrivals = 0; // Number of innocent arrivals
+    uint64_t num_exits = 0; // Packets that left the chain (served,
+                            // filtered, or dropped by any stage)
+    uint64_t total_psize_i = 0; // Cumulative packet size (class I traffic)
+    double last_arrive_time_i = 0; // End arrival time (class I traffic)
+    std::vector<double> chain_arrive_times; // Arrival time into the
+                                            // chain (by packet handle)
+    std::vector<std::pair<double, double>> encoded_jsizes; // Encoded job
+                          // size estimate and actual (by packet handle)
+    /**
+     * Profiling for an individual stage (or the chain as a whole).
+     */
+    struct Profile {
+        uint64_t num_arrivals = 0;      // Arrival count (all traffic)
+        uint64_t num_filtered = 0;      // Packets consumed by the NF
+        uint64_t num_drops_i = 0;       // Drop count (class I)
+        uint64_t num_drops_a = 0;       // Drop count (class A)
+        uint64_t queue_psize = 0;       // Queued packet size (if bounded)
+        uint64_t total_psize_i = 0;     // Cumulative packet size served
+        double last_depart_time_i = 0;  // End depart time (class I traffic)
+        double last_depart_time = 0;    // End depart time (all traffic)
+        LogLinearHistogram latency_i, latency_a; // Per-class latencies
+    };
+    std::vector<Profile> profiles(num_stages);
+    Profile chain_profile; // End-to-end
+
+    // Schedule the initial arrivals
+    uint32_t num_active_innocents = 0; // Innocent traffic-gens with arrivals
+    for (uint32_t idx = 0; idx < tg_innocents_.size(); idx++) {
+        if (tg_innocents_[idx]->hasNewArrival()) {
+            calendar_.schedule(kInnocentEventsStart + idx,
+                               tg_innocents_[idx]->getNextArrivalTime());
+            num_active_innocents++;
+        }
+    }
+    for (uint32_t idx = 0; idx < tg_attacks_.size(); idx++) {
+        calendar_.schedule(kAttackEventsStart + idx,
+                           tg_attacks_[idx]->getNextArrivalTime());
+    }
+    // More innocent arrivals possible?
+    bool more_arrivals = (
+        (num_active_innocents > 0) &&
+        (num_innocent_arrivals < kMaxNumArrivals));
+
+    // Helper function. Drops the given packet at the idx'th stage.
+    auto drop = [&](const uint32_t idx, const PacketHandle handle) {
+        if (arena_[handle].getClass() == TrafficClass::INNOCENT) {
+            profiles[idx].num_drops_i++;
+        }
+        else { profiles[idx].num_drops_a++; }
+        arena_.release(handle);
+        num_exits++;
+    };
+
+    // Helper function. Admits the given (sized) packet into the
+    // idx'th stage at the given time. If one of the stage's servers
+    // is unoccupied, the packet is scheduled immediately; else, it
+    // is queued, dropping packets (per the drop policy) if required.
+    auto admit = [&](const uint32_t idx, const PacketHandle handle,
+                     const double time) {
+        Stage& stage = stages_[idx];
+        Packet& packet = arena_[handle];
+        packet.setArriveTime(time);
+        profiles[idx].num_arrivals++;
+
+        // If the estimated jsize is invalid, reset it to zero
+        if (packet.getJobSizeEstimate() == kInvalidJobSize) {
+            packet.setJobSizeEstimate(0);
+        }
+        BaseQueue* const queue = stage.queue.get();
+        if (stage.server->hasIdleServer()) {
+            assert(queue->empty());
+            stage.server->schedule(time, handle);
+            calendar_.schedule(idx, stage.server->getDepartureTime());
+            return;
+        }
+        if (!stage.capacity.isBounded()) { queue->push(handle); return; }
+        admitPacket(*queue, arena_, handle, stage.capacity,
+                    profiles[idx].queue_psize,
+                    [&](const PacketHandle victim) { drop(idx, victim); },
+                    [](const bool) {});
+    };
+
+    while (more_arrivals || (num_exits != num_arrivals)) {
+        // Fetch the next event
+        const uint32_t event = calendar_.getNextId();
+        const double event_time = calendar_.getNextTime();
+
+        // Simulate an arrival into the chain
+        if (event >= kInnocentEventsStart) {
+            const bool is_attack_arrival = (event >= kAttackEventsStart);
+            TrafficGenerator* const tg = is_attack_arrival ?
+                tg_attacks_[event - kAttackEventsStart].get() :
+                tg_innocents_[event - kInnocentEventsStart].get();
+
+            // Fetch the arrival and compute its job size (at the
+            // first stage). Note: Every stage sizes the packet from
+            // the job sizes encoded by the traffic-gen, so these are
+            // retained until the packet leaves the chain.
+            Packet arrival = tg->getNextArrival(num_arrivals);
+            const std::pair<double, double> encoded_jsize(
+                arrival.getJobSizeEstimate(), arrival.getJobSizeActual());
+
+            stages_[0].server->setJobSizeEstimateAndActual(arrival);
+            tg->updateArrivalTime();
+
+            if (arrival.getClass() == TrafficClass::INNOCENT) {
+                total_psize_i += arrival.getPacketSize();
+                last_arrive_time_i = event_time;
+                num_innocent_arrivals++;
+            }
+            num_arrivals++;
+
+            // Packets with invalid job sizes are consumed by the stage
+            if (arrival.getJobSizeActual() == kInvalidJobSize) {
+                profiles[0].num_arrivals++;
+                profiles[0].num_filtered++;
+                num_exits++;
+            }
+            else {
+                const PacketHandle handle = arena_.allocate(arrival);
+                if (handle >= chain_arrive_times.size()) {
+                    chain_arrive_times.resize(handle + 1);
+                    encoded_jsizes.resize(handle + 1);
+                }
+                chain_arrive_times[handle] = event_time;
+                encoded_jsizes[handle] = encoded_jsize;
+                admit(0, handle, event_time);
+            }
+            // Reschedule the traffic-gen's next arrival
+            if (is_attack_arrival) {
+                calendar_.schedule(event, tg->getNextArrivalTime());
+            }
+            else if (tg->hasNewArrival()) {
+                calendar_.schedule(event, tg->getNextArrivalTime());
+            }
+            else {
+                calendar_.cancel(event);
+                num_active_innocents--;
+            }
+        }
+        // Simulate a departure from a stage
+        else {
+            const uint32_t idx = event;
+            Stage& stage = stages_[idx];
+            Profile& profile = profiles[idx];
+            const PacketHandle handle = stage.server->recordDeparture();
+            Packet& packet = arena_[handle];
+            const bool is_innocent = (packet.getClass() ==
+                                      TrafficClass::INNOCENT);
+            // Update profiling data (per-stage)
+            profile.last_depart_time = event_time;
+            if (!is_innocent) { profile.latency_a.record(packet.getLatency()); }
+            else {
+                profile.latency_i.record(packet.getLatency());
+                profile.total_psize_i += packet.getPacketSize();
+                profile.last_depart_time_i = event_time;
+            }
+
+            // If the queue isn't empty, schedule the next packet
+            // (on the server that was just freed up).
+            if (!stage.queue->empty()) {
+                const PacketHandle next = stage.queue->pop();
+                if (stage.capacity.isBounded()) {
+                    profile.queue_psize -= arena_[next].getPacketSize();
+                }
+                stage.server->schedule(event_time, next);
+            }
+            if (stage.server->hasBusyServer()) {
+                calendar_.schedule(event, stage.server->getDepartureTime());
+            }
+            else { calendar_.cancel(event); }
+
+            // Forward the packet to the next stage (which may
+            // consume it), or record its departure from the chain.
+            if ((idx + 1) < num_stages) {
+                packet.setJobSizeEstimate(encoded_jsizes[handle].first);
+                packet.setJobSizeActual(encoded_jsizes[handle].second);
+                stages_[idx + 1].server->setJobSizeEstimateAndActual(packet);
+                if (packet.getJobSizeActual() != kInvalidJobSize) {
+                    admit(idx + 1, handle, event_time);
+                }
+                else {
+                    profiles[idx + 1].num_arrivals++;
+                    profiles[idx + 1].num_filtered++;
+                    arena_.release(handle);
+                    num_exits++;
+                }
+            }
+            else {
+                const double latency = (event_time - chain_arrive_times[handle]);
+                chain_profile.last_depart_time = event_time;
+                if (!is_innocent) { chain_profile.latency_a.record(latency); }
+                else {
+                    chain_profile.latency_i.record(latency);
+                    chain_profile.total_psize_i += packet.getPacketSize();
+                    chain_profile.last_depart_time_i = event_time;
+                }
+                arena_.release(handle);
+                num_exits++;
+            }
+        }
+
+        // More innocent arrivals possible (and required)? If
+        // not, stop all arrivals.
+        if (more_arrivals && ((num_active_innocents == 0) ||
+                              (num_innocent_arrivals >= kMaxNumArrivals))) {
+            for (uint32_t id = kInnocentEventsStart;
+                 id < (kAttackEventsStart + tg_attacks_.size()); id++) {
+                calendar_.cancel(id);
+            }
+            more_arrivals = false;
+        }
+    }
+    // Sanity checks
+    for (uint32_t idx = 0; idx < stages_.size(); idx++) {
+        assert(stages_[idx].queue->empty());
+        assert(!stages_[idx].server->hasBusyServer());
+    }
+
+    // Summarize the results
+    ChainResults results;
+    for (const std::unique_ptr<TrafficGenerator>& tg : tg_attacks_) {
+        results.input_rate_gbps_a += (tg->getCalibratedRateInBitsPerSecond() /
+                                      kBitsPerGb);
+    }
+    results.input_rate_gbps_i = (last_arrive_time_i > 0) ?
+        (total_psize_i / last_arrive_time_i) : 0;
+    results.num_innocent_arrivals = num_innocent_arrivals;
+    results.num_arrivals = num_arrivals;
+    results.goodput_gbps = (chain_profile.last_depart_time_i > 0) ?
+        (chain_profile.total_psize_i / chain_profile.last_depart_time_i) : 0;
+
+    results.displacement_factor = computeDisplacementFactor(
+        results.input_rate_gbps_i, results.goodput_gbps,
+        results.input_rate_gbps_a);
+    results.latency_p50_ns_i = chain_profile.latency_i.getQuantile(0.5);
+    results.latency_p99_ns_i = chain_profile.latency_i.getQuantile(0.99);
+    results.latency_p999_ns_i = chain_profile.latency_i.getQuantile(0.999);
+    results.latency_p50_ns_a = chain_profile.latency_a.getQuantile(0.5);
+    results.latency_p99_ns_a = chain_profile.latency_a.getQuantile(0.99);
+    results.latency_p999_ns_a = chain_profile.latency_a.getQuantile(0.999);
+
+    for (uint32_t idx = 0; idx < num_stages; idx++) {
+        const Stage& stage = stages_[idx];
+        const Profile& profile = profiles[idx];
+
+        StageResults stage_results;
+        stage_results.policy = stage.queue->type();
+        stage_results.application = stage.application->type();
+        stage_results.num_arrivals = profile.num_arrivals;
+        stage_results.num_filtered = profile.num_filtered;
+        stage_results.num_drops_i = profile.num_drops_i;
+        stage_results.num_drops_a = profile.num_drops_a;
+        stage_results.goodput_gbps = (profile.last_depart_time_i > 0) ?
+            (profile.total_psize_i / profile.last_depart_time_i) : 0;
+
+        for (uint32_t s = 0; s < stage.server->getNumServers(); s++) {
+            stage_results.server_utilizations.push_back(
+                stage.server->getUtilization(s, profile.last_depart_time));
+        }
+        stage_results.latency_p50_ns_i = profile.latency_i.getQuantile(0.5);
+        stage_results.latency_p99_ns_i = profile.latency_i.getQuantile(0.99);
+        stage_results.latency_p50_ns_a = profile.latency_a.getQuantile(0.5);
+        stage_results.latency_p99_ns_a = profile.latency_a.getQuantile(0.99);
+        results.stages.push_back(stage_results);
+    }
+    if (verbose) { results.print(std::cout); }
+    num_runs_++;
+    return results;
+}
@@ -0,0 +1,137 @@
+#ifndef SIMULATOR_CHAIN_SIMULATOR_H
+#define SIMULATOR_CHAIN_SIMULATOR_H
+
+// Library headers
+#include "applications/application.h"
+#include "packet/packet_arena.h"
+#include "queueing/base_queue.h"
+#include "queueing/queue_capacity.h"
+#include "server/server.h"
+#include "event_calendar.h"
+#include "traffic/trafficgen.h"
+
+// STD headers
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Libconfig
+#include <libconfig.h++>
+
+/**
+ * Represents the summary statistics of an individual NF in a chain.
+ */
+struct StageResults final {
+    std::string policy;                 // Scheduling policy
+    std::string application;            // Application type
+    uint64_t num_arrivals = 0;          // Arrival count (all traffic)
+    uint64_t num_filtered = 0;          // Packets consumed by the NF (i.e.,
+                                        // with invalid job sizes)
+    uint64_t num_drops_i = 0;           // Drop count (class I)
+    uint64_t num_drops_a = 0;           // Drop count (class A)
+    double goodput_gbps = 0;            // Output rate (class I)
+    std::vector<double> server_utilizations; // Per-server utilization
+    double latency_p50_ns_i = 0;        // Median sojourn time (class I)
+    double latency_p99_ns_i = 0;        // 99th-percentile sojourn time (class I)
+    double latency_p50_ns_a = 0;        // Median sojourn time (class A)
+    double latency_p99_ns_a = 0;        // 99th-percentile sojourn time (class A)
+};
+
+/**
+ * Represents the summary statistics of a chain simulation run.
+ */
+struct ChainResults final {
+    double input_rate_gbps_i = 0;       // Input rate (class I)
+    double input_rate_gbps_a = 0;       // Input rate (class A)
+    uint64_t num_innocent_arrivals = 0; // Innocent arrival count
+    uint64_t num_arrivals = 0;          // Total arrival count
+    double goodput_gbps = 0;            // End-to-end goodput (class I)
+    double displacement_factor = 0;     // End-to-end DF
+    double latency_p50_ns_i = 0;        // Median latency (class I)
+    double latency_p99_ns_i = 0;        // 99th-percentile latency (class I)
+    double latency_p999_ns_i = 0;       // 99.9th-percentile latency (class I)
+    double latency_p50_ns_a = 0;        // Median latency (class A)
+    double latency_p99_ns_a = 0;        // 99th-percentile latency (class A)
+    double latency_p999_ns_a = 0;       // 99.9th-percentile latency (class A)
+    std::vector<StageResults> stages;   // Per-stage results
+
+    /**
+     * Print the results in a human-readable format.
+     */
+    void print(std::ostream& out) const;
+};
+
+/**
+ * Simulates a chain of NFs (e.g., firewall -> TCP reassembly -> IDS).
+ * Every stage has its own queue (policy), application, and server pool
+ * (optionally, with a bounded queue); packets that depart a stage arrive
+ * at the next one, and leave the chain once served by the last stage.
+ * Job sizes are determined upon arrival at each stage, by that stage's
+ * application; packets with invalid job sizes are consumed by the stage
+ * (e.g., filtered by a firewall). As such, an attack that targets one
+ * stage may back up (or starve) the others. Reports per-stage as well
+ * as end-to-end metrics. Note: Unlike the Simulator, this supports a
+ * single policy per stage, and does not devirtualize its components.
+ */
+class ChainSimulator final {
+private:
+    // RNG stream IDs of the simulation components (see reset)
+    static constexpr uint64_t kApplicationStreamsStart = 0;
+    static constexpr uint64_t kInnocentStreamsStart = (1ULL << 32);
+    static constexpr uint64_t kAttackStreamsStart = (2ULL << 32);
+
+    /**
+     * An individual NF in the chain.
+     */
+    struct Stage {
+        std::unique_ptr<BaseQueue> queue; // Packet queue
+        std::unique_ptr<Application> application; // NF implementation
+        std::unique_ptr<Server> server; // Server pool
+        QueueCapacity capacity; // Queue capacity and drop policy
+    };
+
+    // Simulation config
+    uint64_t kMaxNumArrivals; // Max arrival count
+    uint64_t kSeed = 0; // Base RNG seed
+    uint32_t num_runs_ = 0; // Runs since seeding (selects the RNG streams)
+    PacketArena arena_; // Storage for in-flight packets (all stages)
+    std::vector<Stage> stages_; // NFs, in chain order
+    std::vector<std::unique_ptr<TrafficGenerator>> tg_innocents_; // Innocent
+    std::vector<std::unique_ptr<TrafficGenerator>> tg_attacks_; // Adversarial
+    EventCalendar calendar_; // Pending events
+
+    // Helper method to parse configs
+    void parseChainConfig(const libconfig::Setting& config);
+
+public:
+    explicit ChainSimulator(const libconfig::Setting& config);
+
+    /**
+     * Print the simulation configuration.
+     */
+    void printConfig() const;
+
+    // Accessors
+    uint64_t getSeed() const { return kSeed; }
+    uint32_t getNumStages() const { return stages_.size(); }
+
+    /**
+     * Sets the base RNG seed (see Simulator::setSeed).
+     */
+    void setSeed(const uint64_t seed) { kSeed = seed; num_runs_ = 0; }
+
+    /**
+     * Resets the simulation components to their initial states,
+     * and seeds their RNG streams for the next run.
+     */
+    void reset();
+
+    /**
+     * Run simulation. If verbose, prints the configuration
+     * and results to stdout. Returns the summary results.
+     */
+    ChainResults run(const bool verbose);
+};
+
+#endif // SIMULATOR_CHAIN_SIMULATOR_H
@@ -0,0 +1,136 @@
+#ifndef SIMULATOR_EVENT_CALENDAR_H
+#define SIMULATOR_EVENT_CALENDAR_H
+
+// STD headers
+#include <algorithm>
+#include <limits>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Discrete-event calendar. Every event source (e.g., a traffic-gen,
+ * a server, or a timer) is assigned a fixed event ID upfront, and at
+ * most one pending event per ID is tracked; scheduling an ID that is
+ * already pending simply moves it. Pending events are kept in an
+ * indexed d-ary min-heap ordered by (time, ID), so every operation
+ * is O(log n) in the number of sources, and simultaneous events are
+ * always processed in ID order (callers use this to break ties).
+ */
+class EventCalendar final {
+public:
+    // Heap arity
+    static constexpr uint32_t kArity = 4;
+
+private:
+    // Sentinel position for events that are not pending
+    static constexpr uint32_t kNotPending = (
+        std::numeric_limits<uint32_t>::max());
+
+    struct Entry {
+        double time; // Event time (ns)
+        uint32_t id; // Event ID
+    };
+    std::vector<Entry> heap_; // Pending events
+    std::vector<uint32_t> positions_; // Event ID -> heap position
+
+    // Internal helper methods
+    static bool isBefore(const Entry& a, const Entry& b) {
+        return (a.time < b.time) || ((a.time == b.time) && (a.id < b.id));
+    }
+    void place(const uint32_t position, const Entry& entry) {
+        heap_[position] = entry;
+        positions_[entry.id] = position;
+    }
+    void siftUp(uint32_t position) {
+        const Entry entry = heap_[position];
+        while (position > 0) {
+            const uint32_t parent = (position - 1) / kArity;
+            if (!isBefore(entry, heap_[parent])) { break; }
+            place(position, heap_[parent]);
+            position = parent;
+        }
+        place(position, entry);
+    }
+    void siftDown(uint32_t position) {
+        const Entry entry = heap_[position];
+        const uint32_t size = heap_.size();
+        while (true) {
+            const uint32_t first = (position * kArity) + 1;
+            if (first >= size) { break; }
+
+            // Find the earliest child
+            uint32_t child = first;
+            const uint32_t last = std::min(first + kArity, size);
+            for (uint32_t idx = first + 1; idx < last; idx++) {
+                if (isBefore(heap_[idx], heap_[child])) { child = idx; }
+            }
+            if (!isBefore(heap_[child], entry)) { break; }
+            place(position, heap_[child]);
+            position = child;
+        }
+        place(position, entry);
+    }
+
+public:
+    /**
+     * Clears the calendar, and sets the number of event IDs.
+     */
+    void reset(const uint32_t num_ids) {
+        heap_.clear();
+        heap_.reserve(num_ids);
+        positions_.assign(num_ids, kNotPending);
+    }
+
+    // Accessors
+    bool empty() const { return heap_.empty(); }
+    uint32_t getNextId() const { return heap_[0].id; }
+    double getNextTime() const { return heap_[0].time; }
+    bool isPending(const uint32_t id) const {
+        return (positions_[id] != kNotPending);
+    }
+
+    /**
+     * Schedules the given event at the given time (moving it
+     * if it is already pending).
+     */
+    void schedule(const uint32_t id, const double time) {
+        uint32_t position = positions_[id];
+        if (position == kNotPending) {
+            position = heap_.size();
+            heap_.push_back(Entry{time, id});
+            siftUp(position);
+        }
+        else {
+            const Entry entry{time, id};
+            if (isBefore(entry, heap_[position])) {
+                heap_[position] = entry;
+                siftUp(position);
+            }
+            else {
+                heap_[position] = entry;
+                siftDown(position);
+            }
+        }
+    }
+
+    /**
+     * Cancels the given event (if it is pending).
+     */
+    void cancel(const uint32_t id) {
+        const uint32_t position = positions_[id];
+        if (position == kNotPending) { return; }
+        positions_[id] = kNotPending;
+
+        // Fill the hole with the last entry
+        const Entry last = heap_.back();
+        heap_.pop_back();
+        if (position == heap_.size()) { return; }
+        heap_[position] = last;
+        if ((position > 0) && isBefore(last, heap_[(position - 1) / kArity])) {
+            siftUp(position);
+        }
+        else { siftDown(position); }
+    }
+};
+
+#endif // SIMULATOR_EVENT_CALENDAR_H
@@ -0,0 +1,85 @@
+#include "packet_log.h"
+
+// STD headers
+#include <stdexcept>
+#include <string.h>
+
+PacketLogFormat parsePacketLogFormat(const std::string& name) {
+    if (name == "binary") { return PacketLogFormat::BINARY; }
+    else if (name == "columnar") { return PacketLogFormat::COLUMNAR; }
+    else if (name == "text") { return PacketLogFormat::TEXT; }
+    throw std::invalid_argument("Unknown packet log format: " + name + ".");
+}
+
+/**
+ * PacketLogRecord implementation.
+ */
+void PacketLogRecord::set(const Packet& packet) {
+    arrive_time = packet.getArriveTime();
+    depart_time = packet.getDepartTime();
+    jsize_estimate = packet.getJobSizeEstimate();
+    jsize_actual = packet.getJobSizeActual();
+    packet_idx = packet.getPacketIdx();
+    src_ip = packet.getFlowId().getSrcIP();
+    dst_ip = packet.getFlowId().getDstIP();
+    src_port = packet.getFlowId().getSrcPort();
+    dst_port = packet.getFlowId().getDstPort();
+    packet_size = packet.getPacketSize();
+    traffic_class = static_cast<uint8_t>(packet.getClass());
+    memset(reserved, 0, sizeof(reserved));
+}
+
+/**
+ * Columnar helpers.
+ */
+template<typename T, typename Getter>
+static void appendColumn(const std::vector<PacketLogRecord>& records,
+                         std::vector<char>& out, Getter getter) {
+    const size_t offset = out.size();
+    out.resize(offset + (records.size() * sizeof(T)));
+    char* dst = out.data() + offset;
+    for (const PacketLogRecord& record : records) {
+        const T value = getter(record);
+        memcpy(dst, &value, sizeof(T));
+        dst += sizeof(T);
+    }
+}
+
+void appendPacketLogColumn(const PacketLogColumnId column,
+                           const std::vector<PacketLogRecord>& records,
+                           std::vector<char>& out) {
+    using R = PacketLogRecord;
+    switch (column) {
+    case PacketLogColumnId::ARRIVE:
+        appendColumn<double>(records, out, [](const R& r) {
+            return r.arrive_time; });
+        break;
+    case PacketLogColumnId::DEPART:
+        appendColumn<double>(records, out, [](const R& r) {
+            return r.depart_time; });
+        break;
+    case PacketLogColumnId::FLOW:
+        appendColumn<PacketLogFlow>(records, out, [](const R& r) {
+            return PacketLogFlow{r.src_ip, r.dst_ip, r.src_port,
+                                 r.dst_port}; });
+        break;
+    case PacketLogColumnId::CLASS:
+        appendColumn<uint8_t>(records, out, [](const R& r) {
+            return r.traffic_class; });
+        break;
+    case PacketLogColumnId::PSIZE:
+        appendColumn<uint32_t>(records, out, [](const R& r) {
+            return r.packet_size; });
+        break;
+    case PacketLogColumnId::JSIZE_ESTIMATE:
+        appendColumn<double>(records, out, [](const R& r) {
+            return r.jsize_estimate; });
+        break;
+    case PacketLogColumnId::JSIZE_ACTUAL:
+        appendColumn<double>(records, out, [](const R& r) {
+            return r.jsize_actual; });
+        break;
+    default:
+        throw std::invalid_argument("Invalid packet log column.");
+    }
+}
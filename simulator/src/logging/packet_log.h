@@ -0,0 +1,159 @@
+#ifndef SIMULATOR_LOGGING_PACKET_LOG_H
+#define SIMULATOR_LOGGING_PACKET_LOG_H
+
+// Library headers
+#include "packet/packet.h"
+
+// STD headers
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * Packet log formats. Binary logs are a fixed-size header followed by
+ * a sequence of fixed-width records (see PacketLogRecord). Columnar
+ * logs store each field contiguously (see PacketLogColumnarHeader),
+ * such that individual columns can be memory-mapped zero-copy. Text
+ * logs contain one ';'-separated line per packet, in the following
+ * order: arrive time, depart time, flow ID, class tag, packet size,
+ * and the estimated and actual job sizes.
+ */
+enum class PacketLogFormat { BINARY = 0, COLUMNAR, TEXT };
+
+/**
+ * Returns the packet log format corresponding to the given name ("binary",
+ * "columnar", or "text"). @throw invalid argument if it is unknown.
+ */
+PacketLogFormat parsePacketLogFormat(const std::string& name);
+
+/**
+ * Binary packet log header. Note: The record count is written
+ * when the log is closed. If it is zero, readers should infer
+ * the count from the file size (e.g., for truncated logs).
+ */
+struct PacketLogHeader {
+    char magic[8];          // Magic string ("SPPKTLOG")
+    uint32_t version;       // Format version
+    uint32_t record_size;   // Record size (in bytes)
+    uint64_t num_records;   // Number of records
+    uint64_t reserved;      // Reserved (zero)
+};
+static_assert(sizeof(PacketLogHeader) == 32, "Bad PacketLogHeader packing");
+
+/**
+ * Binary packet log record (native, i.e. little-endian, byte order).
+ */
+struct PacketLogRecord {
+    double arrive_time;     // Arrival time (ns)
+    double depart_time;     // Departure time (ns)
+    double jsize_estimate;  // Estimated job size (ns)
+    double jsize_actual;    // Actual job size (ns)
+    uint64_t packet_idx;    // Packet index
+    uint32_t src_ip;        // Flow ID: Source IP
+    uint32_t dst_ip;        // Flow ID: Destination IP
+    uint16_t src_port;      // Flow ID: Source port
+    uint16_t dst_port;      // Flow ID: Destination port
+    uint32_t packet_size;   // Packet size (bits)
+    uint8_t traffic_class;  // Traffic class (0: Innocent, 1: Attack)
+    uint8_t reserved[7];    // Padding (zero)
+
+    /**
+     * Populates the record from the given packet.
+     */
+    void set(const Packet& packet);
+};
+static_assert(sizeof(PacketLogRecord) == 64, "Bad PacketLogRecord packing");
+
+// Binary format parameters
+constexpr char kPacketLogMagic[8] = {'S', 'P', 'P', 'K', 'T', 'L', 'O', 'G'};
+constexpr uint32_t kPacketLogVersion = 1;
+
+/**
+ * Columnar packet log header. The header is followed by a table
+ * of column descriptors (one per column, see PacketLogColumn),
+ * then by the column data. Each column is a contiguous array of
+ * num_records elements (native byte order), starting at a 64B-
+ * aligned offset; as such, it can be mapped directly into (for
+ * instance) a numpy.memmap of the given dtype.
+ */
+struct PacketLogColumnarHeader {
+    char magic[8];          // Magic string ("SPPKTCOL")
+    uint32_t version;       // Format version
+    uint32_t num_columns;   // Number of columns
+    uint64_t num_records;   // Number of records
+    uint64_t reserved;      // Reserved (zero)
+};
+static_assert(sizeof(PacketLogColumnarHeader) == 32,
+              "Bad PacketLogColumnarHeader packing");
+
+/**
+ * Columnar packet log column descriptor.
+ */
+struct PacketLogColumn {
+    char name[16];          // Column name (NUL-padded)
+    char dtype[8];          // NumPy type string (NUL-padded)
+    uint64_t elem_size;     // Element size (in bytes)
+    uint64_t offset;        // Offset of the column data (in bytes)
+};
+static_assert(sizeof(PacketLogColumn) == 40, "Bad PacketLogColumn packing");
+
+/**
+ * Packed flow ID, as stored in the "flow" column.
+ */
+struct __attribute__((packed)) PacketLogFlow {
+    uint32_t src_ip;        // Source IP
+    uint32_t dst_ip;        // Destination IP
+    uint16_t src_port;      // Source port
+    uint16_t dst_port;      // Destination port
+};
+static_assert(sizeof(PacketLogFlow) == 12, "Bad PacketLogFlow packing");
+
+/**
+ * Columns in a columnar packet log (in on-disk order).
+ */
+enum class PacketLogColumnId {
+    ARRIVE = 0,             // Arrival time (ns), f64
+    DEPART,                 // Departure time (ns), f64
+    FLOW,                   // Flow ID, PacketLogFlow
+    CLASS,                  // Traffic class (0: Innocent, 1: Attack), u8
+    PSIZE,                  // Packet size (bits), u32
+    JSIZE_ESTIMATE,         // Estimated job size (ns), f64
+    JSIZE_ACTUAL,           // Actual job size (ns), f64
+    COUNT,
+};
+
+/**
+ * Static column metadata.
+ */
+struct PacketLogColumnSpec {
+    const char* name;       // Column name
+    const char* dtype;      // NumPy type string
+    size_t elem_size;       // Element size (in bytes)
+};
+constexpr size_t kPacketLogNumColumns = static_cast<size_t>(
+    PacketLogColumnId::COUNT);
+
+constexpr PacketLogColumnSpec kPacketLogColumns[kPacketLogNumColumns] = {
+    {"arrive",      "<f8",  sizeof(double)},
+    {"depart",      "<f8",  sizeof(double)},
+    {"flow",        "|V12", sizeof(PacketLogFlow)},
+    {"class",       "|u1",  sizeof(uint8_t)},
+    {"psize",       "<u4",  sizeof(uint32_t)},
+    {"jsize_est",   "<f8",  sizeof(double)},
+    {"jsize_act",   "<f8",  sizeof(double)},
+};
+
+/**
+ * Appends the values of the given column for each record to out.
+ */
+void appendPacketLogColumn(const PacketLogColumnId column,
+                           const std::vector<PacketLogRecord>& records,
+                           std::vector<char>& out);
+
+// Columnar format parameters
+constexpr char kPacketLogColumnarMagic[8] = {'S', 'P', 'P', 'K',
+                                             'T', 'C', 'O', 'L'};
+constexpr uint32_t kPacketLogColumnarVersion = 1;
+constexpr size_t kPacketLogColumnAlignment = 64;
+
+#endif // SIMULATOR_LOGGING_PACKET_LOG_H
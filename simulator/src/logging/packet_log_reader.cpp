@@ -0,0 +1,74 @@
+#include "packet_log_reader.h"
+
+// STD headers
+#include <fcntl.h>
+#include <stdexcept>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * PacketLogColumnarReader implementation.
+ */
+PacketLogColumnarReader::PacketLogColumnarReader(const std::string& fp) {
+    const int fd = open(fp.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open packet log: " + fp + ".");
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to stat packet log: " + fp + ".");
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ < sizeof(PacketLogColumnarHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Invalid columnar packet log: " + fp + ".");
+    }
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // The mapping remains valid
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("Failed to mmap packet log: " + fp + ".");
+    }
+    data_ = static_cast<const uint8_t*>(data);
+
+    // Validate the header
+    const auto header = reinterpret_cast<
+        const PacketLogColumnarHeader*>(data_);
+
+    const size_t table_end = sizeof(PacketLogColumnarHeader) + (
+        kPacketLogNumColumns * sizeof(PacketLogColumn));
+
+    if ((memcmp(header->magic, kPacketLogColumnarMagic,
+                sizeof(header->magic)) != 0) ||
+        (header->version != kPacketLogColumnarVersion) ||
+        (header->num_columns != kPacketLogNumColumns) ||
+        (size_ < table_end)) {
+        munmap(data, size_);
+        throw std::runtime_error("Invalid columnar packet log: " + fp + ".");
+    }
+    num_records_ = header->num_records;
+
+    // Validate and map the columns
+    const auto columns = reinterpret_cast<const PacketLogColumn*>(
+        data_ + sizeof(PacketLogColumnarHeader));
+
+    for (size_t idx = 0; idx < kPacketLogNumColumns; idx++) {
+        const PacketLogColumn& column = columns[idx];
+        const PacketLogColumnSpec& spec = kPacketLogColumns[idx];
+        if ((strncmp(column.name, spec.name, sizeof(column.name)) != 0) ||
+            (column.elem_size != spec.elem_size) ||
+            (column.offset > size_) ||
+            ((size_ - column.offset) / spec.elem_size < num_records_)) {
+            munmap(data, size_);
+            throw std::runtime_error(
+                "Invalid columnar packet log: " + fp + ".");
+        }
+        columns_[idx] = (data_ + column.offset);
+    }
+}
+
+PacketLogColumnarReader::~PacketLogColumnarReader() {
+    munmap(const_cast<uint8_t*>(data_), size_);
+}
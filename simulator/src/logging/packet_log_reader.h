@@ -0,0 +1,65 @@
+#ifndef SIMULATOR_LOGGING_PACKET_LOG_READER_H
+#define SIMULATOR_LOGGING_PACKET_LOG_READER_H
+
+// Library headers
+#include "common/macros.h"
+#include "packet_log.h"
+
+// STD headers
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+/**
+ * Zero-copy reader for columnar packet logs. The log is memory-
+ * mapped (read-only) in its entirety, and each column is exposed
+ * as a typed pointer into the mapping; as such, opening a log is
+ * O(1) regardless of the number of records, and pages are only
+ * faulted in as the corresponding columns are accessed.
+ */
+class PacketLogColumnarReader final {
+private:
+    const uint8_t* data_ = nullptr; // Mapped file contents
+    size_t size_ = 0; // Mapping size (in bytes)
+    uint64_t num_records_ = 0; // Number of records
+    const void* columns_[kPacketLogNumColumns]{}; // Column data
+
+    /**
+     * Returns a pointer to the data for the given column.
+     */
+    template<typename T>
+    const T* getColumn(const PacketLogColumnId column) const {
+        return static_cast<const T*>(columns_[static_cast<size_t>(column)]);
+    }
+
+public:
+    explicit PacketLogColumnarReader(const std::string& fp);
+    ~PacketLogColumnarReader();
+    DISALLOW_COPY_AND_ASSIGN(PacketLogColumnarReader);
+
+    // Accessors
+    uint64_t getNumRecords() const { return num_records_; }
+    const double* getArriveTimes() const {
+        return getColumn<double>(PacketLogColumnId::ARRIVE);
+    }
+    const double* getDepartTimes() const {
+        return getColumn<double>(PacketLogColumnId::DEPART);
+    }
+    const PacketLogFlow* getFlows() const {
+        return getColumn<PacketLogFlow>(PacketLogColumnId::FLOW);
+    }
+    const uint8_t* getClasses() const {
+        return getColumn<uint8_t>(PacketLogColumnId::CLASS);
+    }
+    const uint32_t* getPacketSizes() const {
+        return getColumn<uint32_t>(PacketLogColumnId::PSIZE);
+    }
+    const double* getJobSizeEstimates() const {
+        return getColumn<double>(PacketLogColumnId::JSIZE_ESTIMATE);
+    }
+    const double* getJobSizeActuals() const {
+        return getColumn<double>(PacketLogColumnId::JSIZE_ACTUAL);
+    }
+};
+
+#endif // SIMULATOR_LOGGING_PACKET_LOG_READER_H
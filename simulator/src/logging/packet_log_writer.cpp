@@ -0,0 +1,195 @@
+#include "packet_log_writer.h"
+
+// STD headers
+#include <cstddef>
+#include <cstdio>
+#include <iomanip>
+#include <stdexcept>
+#include <string.h>
+
+/**
+ * PacketLogWriter implementation.
+ */
+PacketLogWriter::PacketLogWriter(const std::string& fp,
+    const PacketLogFormat format, const size_t buffer_size) :
+    kFormat(format), kBufferSize(buffer_size), kFilePath(fp) {
+    if (buffer_size == 0) {
+        throw std::invalid_argument("Buffer size must be positive.");
+    }
+    ofs_.open(fp, std::ios::trunc | std::ios::binary);
+    if (!ofs_) {
+        throw std::runtime_error("Failed to open packet log: " + fp + ".");
+    }
+    // Write a placeholder header (patched on close)
+    if (kFormat == PacketLogFormat::BINARY) {
+        PacketLogHeader header{};
+        memcpy(header.magic, kPacketLogMagic, sizeof(header.magic));
+        header.version = kPacketLogVersion;
+        header.record_size = sizeof(PacketLogRecord);
+        ofs_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    // Open the per-column staging files
+    else if (kFormat == PacketLogFormat::COLUMNAR) {
+        for (size_t column = 0; column < kPacketLogNumColumns; column++) {
+            const std::string column_fp = getColumnPath(column);
+            column_ofs_[column].open(column_fp,
+                                     std::ios::trunc | std::ios::binary);
+            if (!column_ofs_[column]) {
+                throw std::runtime_error(
+                    "Failed to open packet log column: " + column_fp + ".");
+            }
+        }
+    }
+    else { ofs_ << std::fixed << std::setprecision(2); }
+
+    // Allocate the buffers upfront and start the flusher
+    buffers_[0].reserve(kBufferSize);
+    buffers_[1].reserve(kBufferSize);
+    flusher_ = std::thread(&PacketLogWriter::flusherLoop, this);
+}
+
+PacketLogWriter::~PacketLogWriter() {
+    try { close(); } catch(const std::exception&) {}
+}
+
+std::string PacketLogWriter::getColumnPath(const size_t column) const {
+    return kFilePath + "." + kPacketLogColumns[column].name + ".tmp";
+}
+
+void PacketLogWriter::writeRecords(
+    const std::vector<PacketLogRecord>& records) {
+    if (kFormat == PacketLogFormat::BINARY) {
+        ofs_.write(reinterpret_cast<const char*>(records.data()),
+                   records.size() * sizeof(PacketLogRecord));
+        return;
+    }
+    else if (kFormat == PacketLogFormat::COLUMNAR) {
+        for (size_t column = 0; column < kPacketLogNumColumns; column++) {
+            column_buffer_.clear();
+            appendPacketLogColumn(static_cast<PacketLogColumnId>(column),
+                                  records, column_buffer_);
+
+            column_ofs_[column].write(column_buffer_.data(),
+                                      column_buffer_.size());
+        }
+        return;
+    }
+    for (const PacketLogRecord& r : records) {
+        FlowId flow_id(r.src_ip, r.dst_ip, r.src_port, r.dst_port);
+        ofs_ << r.arrive_time                                   << ";"
+             << r.depart_time                                   << ";"
+             << flow_id                                         << ";"
+             << ((r.traffic_class == static_cast<uint8_t>(
+                  TrafficClass::ATTACK)) ? "A" : "I")           << ";"
+             << r.packet_size                                   << ";"
+             << r.jsize_estimate                                << ";"
+             << r.jsize_actual                                  << "\n";
+    }
+}
+
+void PacketLogWriter::assembleColumns() {
+    // Compute the column layout
+    PacketLogColumnarHeader header{};
+    memcpy(header.magic, kPacketLogColumnarMagic, sizeof(header.magic));
+    header.version = kPacketLogColumnarVersion;
+    header.num_columns = kPacketLogNumColumns;
+    header.num_records = num_records_;
+
+    PacketLogColumn columns[kPacketLogNumColumns]{};
+    uint64_t offset = sizeof(header) + sizeof(columns);
+    for (size_t column = 0; column < kPacketLogNumColumns; column++) {
+        const PacketLogColumnSpec& spec = kPacketLogColumns[column];
+        strncpy(columns[column].name, spec.name, sizeof(columns[column].name));
+        strncpy(columns[column].dtype, spec.dtype,
+                sizeof(columns[column].dtype));
+
+        offset = ((offset + kPacketLogColumnAlignment - 1) /
+                  kPacketLogColumnAlignment) * kPacketLogColumnAlignment;
+
+        columns[column].elem_size = spec.elem_size;
+        columns[column].offset = offset;
+        offset += (spec.elem_size * num_records_);
+    }
+    ofs_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    ofs_.write(reinterpret_cast<const char*>(columns), sizeof(columns));
+
+    // Append the staged column data (with padding)
+    const char padding[kPacketLogColumnAlignment]{};
+    for (size_t column = 0; column < kPacketLogNumColumns; column++) {
+        const uint64_t position = ofs_.tellp();
+        ofs_.write(padding, columns[column].offset - position);
+
+        column_ofs_[column].close();
+        if (column_ofs_[column].fail()) {
+            throw std::runtime_error("Failed to write packet log column.");
+        }
+        const std::string column_fp = getColumnPath(column);
+        std::ifstream column_ifs(column_fp, std::ios::binary);
+        if (num_records_ != 0) { ofs_ << column_ifs.rdbuf(); }
+        column_ifs.close();
+        std::remove(column_fp.c_str());
+    }
+}
+
+void PacketLogWriter::flusherLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return is_flush_pending_ || is_closing_; });
+        if (!is_flush_pending_) { break; } // Closing, nothing to flush
+
+        // Write out the inactive buffer (outside the lock)
+        std::vector<PacketLogRecord>& buffer = buffers_[active_idx_ ^ 1];
+        lock.unlock();
+        writeRecords(buffer);
+        buffer.clear();
+        lock.lock();
+
+        is_flush_pending_ = false;
+        cv_.notify_all();
+    }
+}
+
+void PacketLogWriter::swapBuffers() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return !is_flush_pending_; });
+    active_idx_ ^= 1;
+    is_flush_pending_ = true;
+    cv_.notify_all();
+}
+
+void PacketLogWriter::write(const Packet& packet) {
+    std::vector<PacketLogRecord>& buffer = buffers_[active_idx_];
+    buffer.emplace_back();
+    buffer.back().set(packet);
+    num_records_++;
+
+    // Hand off full buffers to the flusher
+    if (buffer.size() == kBufferSize) { swapBuffers(); }
+}
+
+void PacketLogWriter::close() {
+    if (is_closed_) { return; }
+    is_closed_ = true;
+
+    // Flush the partially-filled buffer, then stop the flusher
+    if (!buffers_[active_idx_].empty()) { swapBuffers(); }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        is_closing_ = true;
+        cv_.notify_all();
+    }
+    flusher_.join();
+
+    // Patch the record count in the header
+    if (kFormat == PacketLogFormat::BINARY) {
+        ofs_.seekp(offsetof(PacketLogHeader, num_records));
+        ofs_.write(reinterpret_cast<const char*>(&num_records_),
+                   sizeof(num_records_));
+    }
+    // Assemble the columnar log
+    else if (kFormat == PacketLogFormat::COLUMNAR) { assembleColumns(); }
+    ofs_.close();
+    if (ofs_.fail()) {
+        throw std::runtime_error("Failed to write packet log.");
+    }
+}
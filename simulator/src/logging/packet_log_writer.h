@@ -0,0 +1,81 @@
+#ifndef SIMULATOR_LOGGING_PACKET_LOG_WRITER_H
+#define SIMULATOR_LOGGING_PACKET_LOG_WRITER_H
+
+// Library headers
+#include "common/macros.h"
+#include "packet_log.h"
+
+// STD headers
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Streams packet records to a log file. Records are appended to
+ * one of two fixed-size buffers; once the active buffer fills up,
+ * it is handed off to a background thread (which serializes and
+ * writes it out), and the other buffer becomes active. As such,
+ * memory usage is bounded regardless of the number of packets,
+ * and the simulation thread never performs I/O or formatting.
+ *
+ * Since the record count is unknown upfront, columnar logs are
+ * staged as one temporary file per column, which are assembled
+ * into the final log (header first) when the log is closed.
+ */
+class PacketLogWriter final {
+public:
+    // Default buffer capacity (in records)
+    static constexpr size_t kDefaultBufferSize = (1 << 16);
+
+private:
+    const PacketLogFormat kFormat; // Output format
+    const size_t kBufferSize; // Buffer capacity (in records)
+    const std::string kFilePath; // Output file path
+    std::ofstream ofs_; // Output filestream
+    uint64_t num_records_ = 0; // Total records written
+
+    // Double-buffering
+    std::vector<PacketLogRecord> buffers_[2]; // Record buffers
+    size_t active_idx_ = 0; // Index of the buffer being filled
+    bool is_flush_pending_ = false; // Is a buffer awaiting flush?
+    bool is_closing_ = false; // Has close() been invoked?
+    bool is_closed_ = false; // Is the log closed?
+
+    // Background flushing
+    std::mutex mutex_; // Guards the flush state
+    std::condition_variable cv_; // Signals flush state changes
+    std::thread flusher_; // Background flush thread
+
+    // Columnar staging
+    std::ofstream column_ofs_[kPacketLogNumColumns]; // Per-column files
+    std::vector<char> column_buffer_; // Column serialization buffer
+
+    // Internal helper methods
+    void swapBuffers();
+    void flusherLoop();
+    void writeRecords(const std::vector<PacketLogRecord>& records);
+    std::string getColumnPath(const size_t column) const;
+    void assembleColumns();
+
+public:
+    explicit PacketLogWriter(const std::string& fp,
+                             const PacketLogFormat format,
+                             const size_t buffer_size=kDefaultBufferSize);
+    ~PacketLogWriter();
+    DISALLOW_COPY_AND_ASSIGN(PacketLogWriter);
+
+    /**
+     * Appends the given packet to the log.
+     */
+    void write(const Packet& packet);
+
+    /**
+     * Flushes any buffered records and closes the log.
+     */
+    void close();
+};
+
+#endif // SIMULATOR_LOGGING_PACKET_LOG_WRITER_H
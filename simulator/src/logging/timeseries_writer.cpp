@@ -0,0 +1,41 @@
+#include "timeseries_writer.h"
+
+// STD headers
+#include <iomanip>
+#include <stdexcept>
+
+/**
+ * TimeSeriesWriter implementation.
+ */
+TimeSeriesWriter::TimeSeriesWriter(const std::string& fp) {
+    ofs_.open(fp, std::ios::trunc);
+    if (!ofs_.is_open()) {
+        throw std::runtime_error("Failed to open time-series file: " + fp + ".");
+    }
+    ofs_ << "run,time_ns,policy,input_gbps_i,input_gbps_a,goodput_gbps_i,"
+         << "goodput_gbps_a,queue_packets,queue_bytes,utilization,"
+         << "num_drops_i,num_drops_a" << std::endl;
+}
+
+void TimeSeriesWriter::write(const TimeSeriesSample& sample) {
+    ofs_ << sample.run << ","
+         << std::fixed << std::setprecision(0) << sample.time_ns << ","
+         << sample.policy << ","
+         << std::setprecision(4)
+         << sample.input_gbps_i << ","
+         << sample.input_gbps_a << ","
+         << sample.goodput_gbps_i << ","
+         << sample.goodput_gbps_a << ","
+         << sample.queue_packets << ","
+         << sample.queue_bytes << ","
+         << sample.utilization << ","
+         << sample.num_drops_i << ","
+         << sample.num_drops_a << "\n";
+    if (!ofs_) {
+        throw std::runtime_error("Failed to write time-series file.");
+    }
+}
+
+void TimeSeriesWriter::close() {
+    if (ofs_.is_open()) { ofs_.close(); }
+}
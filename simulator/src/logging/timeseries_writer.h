@@ -0,0 +1,58 @@
+#ifndef SIMULATOR_LOGGING_TIMESERIES_WRITER_H
+#define SIMULATOR_LOGGING_TIMESERIES_WRITER_H
+
+// Library headers
+#include "common/macros.h"
+
+// STD headers
+#include <fstream>
+#include <stdint.h>
+#include <string>
+
+/**
+ * Represents a single time-series sample, which summarizes the state
+ * of one policy's cores over a window of simulated time. Rates, drops,
+ * and utilization are averaged over the window; queue occupancies are
+ * sampled at the end of the window (and summed across cores).
+ */
+struct TimeSeriesSample final {
+    uint32_t run = 0;               // Run index (e.g., replication)
+    double time_ns = 0;             // End of the window
+    std::string policy;             // Scheduling policy
+    double input_gbps_i = 0;        // Input rate (class I)
+    double input_gbps_a = 0;        // Input rate (class A)
+    double goodput_gbps_i = 0;      // Output rate (class I)
+    double goodput_gbps_a = 0;      // Output rate (class A)
+    uint64_t queue_packets = 0;     // Queue length (packets)
+    uint64_t queue_bytes = 0;       // Queue length (bytes)
+    double utilization = 0;         // Mean server utilization
+    uint64_t num_drops_i = 0;       // Drop count (class I)
+    uint64_t num_drops_a = 0;       // Drop count (class A)
+};
+
+/**
+ * Writes time-series samples to a CSV file (one row per sample). Since
+ * samples are taken at a coarse, fixed interval of simulated time, the
+ * output is small, and writes are simply buffered by the filestream.
+ */
+class TimeSeriesWriter final {
+private:
+    std::ofstream ofs_; // Output filestream
+
+public:
+    explicit TimeSeriesWriter(const std::string& fp);
+    ~TimeSeriesWriter() { close(); }
+    DISALLOW_COPY_AND_ASSIGN(TimeSeriesWriter);
+
+    /**
+     * Appends the given sample to the file.
+     */
+    void write(const TimeSeriesSample& sample);
+
+    /**
+     * Flushes any buffered samples and closes the file.
+     */
+    void close();
+};
+
+#endif // SIMULATOR_LOGGING_TIMESERIES_WRITER_H
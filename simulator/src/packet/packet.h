@@ -2,6 +2,7 @@
 #define SIMULATOR_PACKET_PACKET_H
 
 // STD headers
+#include <algorithm>
 #include <stdlib.h>
 #include <stdexcept>
 
@@ -113,6 +114,7 @@ protected:
     // Housekeeping
     double arrive_time_ = 0; // Time of arrival
     double depart_time_ = 0; // Time of departure
+    double attained_service_ = 0; // Work completed (if preempted)
 
 public:
     explicit Packet();
@@ -128,6 +130,20 @@ public:
     double getJobSizeActual() const { return job_size_actual_; }
     const TCPHeader& getTCPHeader() const { return tcp_header_; }
     double getJobSizeEstimate() const { return job_size_estimate_; }
+    double getAttainedService() const { return attained_service_; }
+
+    // Remaining work (if the packet was preempted mid-service)
+    double getRemainingJobSizeActual() const {
+        return (job_size_actual_ - attained_service_);
+    }
+    double getRemainingJobSizeEstimate() const {
+        return getRemainingJobSizeEstimate(attained_service_);
+    }
+    // Remaining work, given the service attained so far (e.g.,
+    // including the work done since the packet was scheduled)
+    double getRemainingJobSizeEstimate(const double attained) const {
+        return std::max(0.0, job_size_estimate_ - attained);
+    }
 
     std::string getClassTag() const {
         return (class_ == TrafficClass::ATTACK) ? "A" : "I";
@@ -140,11 +156,13 @@ public:
         return (depart_time_ - arrive_time_);
     }
     // Mutators
+    void setPacketIdx(const uint64_t idx) { idx_ = idx; }
     void setDepartTime(const double time) { depart_time_ = time; }
     void setArriveTime(const double time) { arrive_time_ = time; }
     void setTCPHeader(const TCPHeader& header) { tcp_header_ = header; }
     void setJobSizeActual(const double jsize) { job_size_actual_ = jsize; }
     void setJobSizeEstimate(const double jsize) { job_size_estimate_ = jsize; }
+    void setAttainedService(const double work) { attained_service_ = work; }
 };
 
 #endif // SIMULATOR_PACKET_PACKET_H
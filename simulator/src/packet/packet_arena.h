@@ -0,0 +1,109 @@
+#ifndef SIMULATOR_PACKET_PACKET_ARENA_H
+#define SIMULATOR_PACKET_PACKET_ARENA_H
+
+// Library headers
+#include "common/macros.h"
+#include "packet.h"
+
+// STD headers
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <stdint.h>
+#include <type_traits>
+#include <vector>
+
+// Handle to a packet stored in a PacketArena
+typedef uint32_t PacketHandle;
+
+/**
+ * Slab of packets addressed by 32-bit handles. This allows queues
+ * (and the server) to operate on handles instead of copying packets
+ * around. Packets are stored in fixed-size blocks that are allocated
+ * on demand and never moved (so growing the slab is cheap, and both
+ * handles and references remain valid until released). Released
+ * slots are recycled via a free-list, so the slab only grows up to
+ * the maximum number of in-flight (queued or in-service) packets.
+ */
+class PacketArena final {
+private:
+    // Packets per block (log2)
+    static constexpr uint32_t kBlockBits = 12;
+    static constexpr uint32_t kBlockSize = (1u << kBlockBits);
+    static constexpr uint32_t kBlockMask = (kBlockSize - 1);
+
+    // Uninitialized packet storage (slots are copy-constructed
+    // in allocate; packets are trivially destructible).
+    typedef std::aligned_storage<sizeof(Packet), alignof(Packet)>::type Slot;
+    static_assert(std::is_trivially_destructible<Packet>::value,
+                  "Packet must be trivially destructible");
+
+    std::vector<std::unique_ptr<Slot[]>> blocks_; // Packet blocks
+    std::vector<PacketHandle> free_handles_; // Free-list
+    uint64_t num_slots_ = 0; // Number of slots ever used
+
+    // Internal helper method. Returns the slot for the given handle.
+    Slot& getSlot(const PacketHandle handle) const {
+        return blocks_[handle >> kBlockBits][handle & kBlockMask];
+    }
+
+public:
+    explicit PacketArena() {}
+    DISALLOW_COPY_AND_ASSIGN(PacketArena);
+
+    /**
+     * Returns the number of live (allocated) packets.
+     */
+    size_t size() const { return (num_slots_ - free_handles_.size()); }
+
+    /**
+     * Stores a copy of the given packet, returning its handle.
+     * @throw runtime error if the handle space is exhausted.
+     */
+    PacketHandle allocate(const Packet& packet) {
+        PacketHandle handle;
+        if (!free_handles_.empty()) {
+            handle = free_handles_.back();
+            free_handles_.pop_back();
+        }
+        else {
+            if (num_slots_ > std::numeric_limits<PacketHandle>::max()) {
+                throw std::runtime_error("Packet arena is full.");
+            }
+            handle = static_cast<PacketHandle>(num_slots_++);
+            if ((handle >> kBlockBits) == blocks_.size()) {
+                blocks_.emplace_back(new Slot[kBlockSize]);
+            }
+        }
+        new (&getSlot(handle)) Packet(packet);
+        return handle;
+    }
+
+    /**
+     * Releases the given handle (and the corresponding slot).
+     */
+    void release(const PacketHandle handle) {
+        free_handles_.push_back(handle);
+    }
+
+    /**
+     * Returns the packet corresponding to the given handle.
+     */
+    Packet& operator[](const PacketHandle handle) {
+        return *reinterpret_cast<Packet*>(&getSlot(handle));
+    }
+    const Packet& operator[](const PacketHandle handle) const {
+        return *reinterpret_cast<const Packet*>(&getSlot(handle));
+    }
+
+    /**
+     * Releases all packets. Note: Retains the allocated blocks.
+     */
+    void reset() {
+        num_slots_ = 0;
+        free_handles_.clear();
+    }
+};
+
+#endif // SIMULATOR_PACKET_PACKET_ARENA_H
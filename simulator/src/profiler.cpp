@@ -0,0 +1,74 @@
+#include "profiler.h"
+
+// STD headers
+#include <algorithm>
+#include <iomanip>
+#include <string>
+#include <sys/resource.h>
+
+void Profiler::start() {
+    if (!is_enabled_) { return; }
+    start_time_ = std::chrono::steady_clock::now();
+    start_ticks_ = TscClock::counter();
+}
+
+void Profiler::stop() {
+    if (!is_enabled_) { return; }
+    total_ticks_ += (TscClock::counter() - start_ticks_);
+    total_seconds_ += std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start_time_).count();
+    num_runs_++;
+}
+
+void Profiler::print(std::ostream& out) const {
+    static const std::string kPhaseNames[kNumPhases] = {
+        "Traffic generation",
+        "Application",
+        "Scheduling (queues and servers)",
+        "Accounting (statistics and logging)",
+    };
+    uint64_t num_events = 0;
+    for (const uint64_t count : num_events_) { num_events += count; }
+
+    // Peak RSS (in KB on Linux)
+    struct rusage usage;
+    const long peak_rss_kb = (getrusage(RUSAGE_SELF, &usage) == 0) ?
+                             usage.ru_maxrss : 0;
+
+    out << "==========================================" << std::endl
+        << "            Simulator Profile             " << std::endl
+        << "==========================================" << std::endl;
+
+    out << std::fixed << std::setprecision(2);
+    out << "Profiled runs: " << num_runs_ << std::endl;
+    out << "Simulation time: " << total_seconds_ << " s" << std::endl;
+    out << "Events: " << num_events << " (arrivals: " << num_events_[ARRIVAL]
+        << ", departures: " << num_events_[DEPARTURE] << ", deadlines: "
+        << num_events_[DEADLINE] << ", timers: " << num_events_[TIMER]
+        << ")" << std::endl;
+
+    if (total_seconds_ > 0) {
+        out << "Event rate: " << (num_events / total_seconds_ / 1e6)
+            << " M events/s" << std::endl;
+    }
+    out << "Peak queue length: " << max_queue_size_ << " packets" << std::endl;
+    out << "Peak RSS: " << (peak_rss_kb / 1024.0) << " MB" << std::endl;
+    out << std::endl;
+
+    // Time breakdown (as fractions of the loop's TSC ticks)
+    if (total_ticks_ != 0) {
+        uint64_t other_ticks = total_ticks_;
+        for (uint32_t phase = 0; phase < kNumPhases; phase++) {
+            const double fraction = (static_cast<double>(phase_ticks_[phase]) /
+                                     total_ticks_);
+            out << kPhaseNames[phase] << ": " << (fraction * 100) << " % ("
+                << (fraction * total_seconds_) << " s)" << std::endl;
+            other_ticks -= std::min(other_ticks, phase_ticks_[phase]);
+        }
+        const double fraction = (static_cast<double>(other_ticks) /
+                                 total_ticks_);
+        out << "Other (event calendar, bookkeeping): " << (fraction * 100)
+            << " % (" << (fraction * total_seconds_) << " s)" << std::endl;
+    }
+    out << std::endl;
+}
@@ -0,0 +1,112 @@
+#ifndef SIMULATOR_PROFILER_H
+#define SIMULATOR_PROFILER_H
+
+// Library headers
+#include "common/tsc_clock.h"
+
+// STD headers
+#include <array>
+#include <chrono>
+#include <ostream>
+
+/**
+ * Self-profiling instrumentation of the simulation loop. Counts events
+ * (by type), and attributes the loop's wall-clock time to its phases
+ * using TSC-based scoped timers. Phase times are reported as fractions
+ * of the total TSC ticks, scaled by the (steady-clock) wall time, so
+ * the TSC never needs calibrating. If disabled, the timers only cost
+ * a (well-predicted) branch.
+ */
+class Profiler final {
+public:
+    // Phases of the simulation loop
+    enum Phase {
+        TRAFFIC_GENERATION = 0, // Fetching arrivals from the traffic-gens
+        APPLICATION,            // Computing job sizes
+        SCHEDULING,             // Queue operations and server scheduling
+        ACCOUNTING,             // Departure statistics and packet logging
+        kNumPhases,
+    };
+
+    // Event types
+    enum Event {
+        ARRIVAL = 0,            // Packet arrivals
+        DEPARTURE,              // Packet (or batch) departures
+        DEADLINE,               // Batch formation deadlines
+        TIMER,                  // Timers and time-series samples
+        kNumEvents,
+    };
+
+    /**
+     * Attributes the TSC ticks elapsed during its lifetime (or
+     * until it is explicitly stopped) to a phase.
+     */
+    class ScopedTimer final {
+    private:
+        Profiler& profiler_;
+        const Phase kPhase;
+        const uint64_t kStart;
+        bool is_running_;
+
+    public:
+        explicit ScopedTimer(Profiler& profiler, const Phase phase) :
+            profiler_(profiler), kPhase(phase),
+            kStart(profiler.isEnabled() ? TscClock::counter() : 0),
+            is_running_(profiler.isEnabled()) {}
+        ~ScopedTimer() { stop(); }
+
+        void stop() {
+            if (is_running_) {
+                profiler_.phase_ticks_[kPhase] += (
+                    TscClock::counter() - kStart);
+                is_running_ = false;
+            }
+        }
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    };
+
+private:
+    bool is_enabled_ = false; // Profiling enabled?
+    uint32_t num_runs_ = 0; // Number of profiled runs
+    std::chrono::steady_clock::time_point start_time_; // Run start time
+    uint64_t start_ticks_ = 0; // Run start TSC
+    double total_seconds_ = 0; // Wall time (all profiled runs)
+    uint64_t total_ticks_ = 0; // TSC ticks (all profiled runs)
+    std::array<uint64_t, kNumPhases> phase_ticks_{}; // Ticks per phase
+    std::array<uint64_t, kNumEvents> num_events_{}; // Count per event type
+    uint64_t max_queue_size_ = 0; // Peak queue length (packets)
+
+public:
+    // Accessors
+    bool isEnabled() const { return is_enabled_; }
+    void setEnabled(const bool is_enabled) { is_enabled_ = is_enabled; }
+
+    /**
+     * Marks the start (end) of the simulation loop.
+     */
+    void start();
+    void stop();
+
+    /**
+     * Counts an event of the given type.
+     */
+    void recordEvent(const Event event) {
+        if (is_enabled_) { num_events_[event]++; }
+    }
+
+    /**
+     * Records a queue's current length (for the peak).
+     */
+    void recordQueueSize(const uint64_t size) {
+        if (is_enabled_ && (size > max_queue_size_)) { max_queue_size_ = size; }
+    }
+
+    /**
+     * Print the profile (accumulated over all runs so far), along
+     * with the peak resident set size (RSS) of this process.
+     */
+    void print(std::ostream& out) const;
+};
+
+#endif // SIMULATOR_PROFILER_H
@@ -0,0 +1,14 @@
+#include "base_queue.h"
+
+DropPolicy parseDropPolicy(const std::string& name) {
+    if (name == "drop_tail") { return DropPolicy::TAIL; }
+    else if (name == "drop_head") { return DropPolicy::HEAD; }
+    else if (name == "drop_max") { return DropPolicy::MAX; }
+    throw std::invalid_argument("Unknown drop policy: " + name + ".");
+}
+
+std::string toString(const DropPolicy policy) {
+    if (policy == DropPolicy::HEAD) { return "drop_head"; }
+    else if (policy == DropPolicy::MAX) { return "drop_max"; }
+    return "drop_tail";
+}
@@ -2,20 +2,49 @@
 #define SIMULATOR_QUEUEING_BASE_QUEUE_H
 
 // Library headers
-#include "packet/packet.h"
+#include "packet/packet_arena.h"
 
 // STD headers
 #include <string>
-#include <exception>
+#include <stdexcept>
 
 /**
- * Base class representing a generic queue.
+ * Policies for admitting packets into a full (bounded) queue. TAIL
+ * drops the arriving packet, HEAD evicts the packet at the front of
+ * the queue, and MAX evicts the packet with the lowest priority (as
+ * in drop-max-weight), which may be the arriving packet itself.
+ */
+enum class DropPolicy { TAIL = 0, HEAD, MAX };
+
+/**
+ * Returns the drop policy corresponding to the given name ("drop_tail",
+ * "drop_head", or "drop_max"). @throw invalid argument if it is unknown.
+ */
+DropPolicy parseDropPolicy(const std::string& name);
+
+/**
+ * Returns the name of the given drop policy.
+ */
+std::string toString(const DropPolicy policy);
+
+/**
+ * Base class representing a generic queue. Queues operate on packet
+ * handles; the packets themselves reside in a PacketArena (owned by
+ * the simulator), which must be set before using the queue.
  */
 class BaseQueue {
 protected:
     const std::string kType; // Underlying policy name
+    const PacketArena* arena_ = nullptr; // Packet storage
+    bool is_double_ended_ = false; // Is popBack() enabled?
     explicit BaseQueue(const std::string type) : kType(type) {}
 
+    // Internal helper method. Returns the packet
+    // corresponding to the given handle.
+    const Packet& getPacket(const PacketHandle handle) const {
+        return (*arena_)[handle];
+    }
+
     // Internal helper method. Throws an error if
     // attempting to pop or peek an empty queue.
     static void assertNotEmpty(const bool empty) {
@@ -24,6 +53,14 @@ protected:
         }
     }
 
+    // Internal helper method. Throws an error if
+    // popBack() is invoked w/o being enabled.
+    void assertDoubleEnded() const {
+        if (!is_double_ended_) { throw std::runtime_error(
+            "popBack() requires a double-ended queue.");
+        }
+    }
+
 public:
     virtual ~BaseQueue() {}
 
@@ -32,6 +69,11 @@ public:
      */
     const std::string& type() const { return kType; }
 
+    /**
+     * Sets the arena in which queued packets reside.
+     */
+    void setPacketArena(const PacketArena* arena) { arena_ = arena; }
+
     /**
      * Returns the number of packets in the queue.
      */
@@ -47,22 +89,67 @@ public:
      */
     virtual bool isFlowOrderMaintained() const = 0;
 
+    /**
+     * Returns whether this queue supports preemptive scheduling,
+     * i.e. ranks packets by their remaining work (see isBefore).
+     */
+    virtual bool isPreemptionSupported() const { return false; }
+
+    /**
+     * Returns whether packet a strictly takes priority over packet
+     * b (e.g., whether an arrival should preempt a packet in service),
+     * given the service (in ns) attained by each packet so far. Note:
+     * For packets in service, this should include the work done since
+     * they were scheduled (see Server::getAttainedService).
+     * @throw runtime error if the queue does not support preemption.
+     */
+    virtual bool isBefore(const PacketHandle /* a */,
+                          const double /* attained_a */,
+                          const PacketHandle /* b */,
+                          const double /* attained_b */) const {
+        throw std::runtime_error(
+            "Policy " + kType + " does not support preemption.");
+    }
+
     /**
      * Pops (and returns) the packet at the front of the queue.
      * @throw runtime error if the queue is currently empty.
      */
-    virtual Packet pop() = 0;
+    virtual PacketHandle pop() = 0;
+
+    /**
+     * Enables (or disables) popBack(). Since this requires tracking
+     * the lowest-priority packet (typically, in a second heap), it
+     * is disabled by default. Note: Must be set while empty.
+     */
+    virtual void setDoubleEnded(const bool enabled) {
+        is_double_ended_ = enabled;
+    }
+
+    /**
+     * Pops (and returns) the packet at the back of the queue, i.e.
+     * the one that would be scheduled last (for flow-ordered queues,
+     * the tail packet of the lowest-priority flow).
+     * @throw runtime error if the queue is currently empty, or
+     * is not double-ended.
+     */
+    virtual PacketHandle popBack() = 0;
 
     /**
      * Returns (w/o popping) the packet at the front of the queue.
      * @throw runtime error if the queue is currently empty.
      */
-    virtual Packet peek() const = 0;
+    virtual PacketHandle peek() const = 0;
 
     /**
      * Pushes a new packet onto the queue.
      */
-    virtual void push(const Packet& packet) = 0;
+    virtual void push(const PacketHandle handle) = 0;
+
+    /**
+     * Resets the queue to its initial (empty) state.
+     */
+    virtual void reset() = 0;
 };
 
 #endif // SIMULATOR_QUEUEING_BASE_QUEUE_H
@@ -0,0 +1,104 @@
+#ifndef SIMULATOR_QUEUEING_DOUBLE_ENDED_HEAP_H
+#define SIMULATOR_QUEUEING_DOUBLE_ENDED_HEAP_H
+
+// Library headers
+#include "common/utils.h"
+#include "packet/packet_arena.h"
+
+// STD headers
+#include <assert.h>
+#include <vector>
+
+// Boost headers
+#include <boost/heap/binomial_heap.hpp>
+
+/**
+ * Heap comparator that reverses the order of MinHeapEntry, i.e.
+ * the lowest-priority entry is at the top of the heap.
+ */
+template<class Entry>
+struct ReverseHeapOrder {
+    bool operator()(const Entry& a, const Entry& b) const { return (b < a); }
+};
+
+/**
+ * Heap of packets (ordered by MinHeapEntry) that can, optionally,
+ * also pop its lowest-priority entry (e.g., to implement drop-max).
+ * In that case, every entry is mirrored in a second heap of reversed
+ * order, and the two are kept in sync via per-packet heap handles.
+ * Otherwise, this behaves exactly like the underlying binomial heap.
+ */
+template<class Metric>
+class DoubleEndedHeap final {
+public:
+    typedef MinHeapEntry<PacketHandle, Metric> Entry;
+
+private:
+    typedef boost::heap::binomial_heap<Entry> FrontHeap;
+    typedef boost::heap::binomial_heap<
+        Entry, boost::heap::compare<ReverseHeapOrder<Entry>>> BackHeap;
+
+    bool is_double_ended_ = false; // Mirror entries in the back heap?
+    FrontHeap front_; // Highest priority first
+    BackHeap back_; // Lowest priority first
+    std::vector<typename FrontHeap::handle_type> front_handles_; // By packet
+    std::vector<typename BackHeap::handle_type> back_handles_; // By packet
+
+public:
+    // Accessors
+    size_t size() const { return front_.size(); }
+    bool empty() const { return front_.empty(); }
+    bool isDoubleEnded() const { return is_double_ended_; }
+    const Entry& top() const { return front_.top(); }
+    const Entry& bottom() const { assert(is_double_ended_); return back_.top(); }
+
+    /**
+     * Enables (or disables) popBottom(). Clears the heap.
+     */
+    void setDoubleEnded(const bool enabled) {
+        is_double_ended_ = enabled;
+        clear();
+    }
+
+    /**
+     * Inserts the given entry.
+     */
+    void push(const Entry& entry) {
+        if (!is_double_ended_) { front_.push(entry); return; }
+
+        const PacketHandle handle = entry.tag();
+        if (handle >= front_handles_.size()) {
+            front_handles_.resize(handle + 1);
+            back_handles_.resize(handle + 1);
+        }
+        front_handles_[handle] = front_.push(entry);
+        back_handles_[handle] = back_.push(entry);
+    }
+
+    /**
+     * Removes the highest-priority entry.
+     */
+    void pop() {
+        if (is_double_ended_) { back_.erase(back_handles_[front_.top().tag()]); }
+        front_.pop();
+    }
+
+    /**
+     * Removes the lowest-priority entry. Requires double-ended mode.
+     */
+    void popBottom() {
+        assert(is_double_ended_);
+        front_.erase(front_handles_[back_.top().tag()]);
+        back_.pop();
+    }
+
+    /**
+     * Removes all entries.
+     */
+    void clear() {
+        front_.clear();
+        back_.clear();
+    }
+};
+
+#endif // SIMULATOR_QUEUEING_DOUBLE_ENDED_HEAP_H
@@ -1,17 +1,29 @@
 #include "fcfs_queue.h"
 
-Packet FCFSQueue::pop() {
+PacketHandle FCFSQueue::pop() {
     BaseQueue::assertNotEmpty(empty());
-    Packet packet = queue_.front();
+    const PacketHandle handle = queue_.front();
     queue_.pop_front();
-    return packet;
+    return handle;
 }
 
-Packet FCFSQueue::peek() const {
+PacketHandle FCFSQueue::popBack() {
+    BaseQueue::assertNotEmpty(empty());
+    BaseQueue::assertDoubleEnded();
+    const PacketHandle handle = queue_.back();
+    queue_.pop_back();
+    return handle;
+}
+
+PacketHandle FCFSQueue::peek() const {
     BaseQueue::assertNotEmpty(empty());
     return queue_.front();
 }
 
-void FCFSQueue::push(const Packet& packet) {
-    queue_.push_back(packet);
+void FCFSQueue::push(const PacketHandle handle) {
+    queue_.push_back(handle);
+}
+
+void FCFSQueue::reset() {
+    queue_.clear();
 }
@@ -3,17 +3,17 @@
 
 // Library headers
 #include "base_queue.h"
-#include "packet/packet.h"
+#include "packet/packet_arena.h"
 
 // STD headers
-#include <list>
+#include <deque>
 
 /**
  * Represents an FCFS queue.
  */
-class FCFSQueue : public BaseQueue {
+class FCFSQueue final : public BaseQueue {
 private:
-    std::list<Packet> queue_; // Packet queue
+    std::deque<PacketHandle> queue_; // Packet queue
 
 public:
     explicit FCFSQueue() : BaseQueue(name()) {}
@@ -43,18 +43,30 @@ public:
      * Pops (and returns) the packet at the front of the queue.
      * @throw runtime error if the queue is currently empty.
      */
-    virtual Packet pop() override;
+    virtual PacketHandle pop() override;
+
+    /**
+     * Pops (and returns) the packet at the back of the queue.
+     * @throw runtime error if the queue is currently empty, or
+     * is not double-ended.
+     */
+    virtual PacketHandle popBack() override;
 
     /**
      * Returns (w/o popping) the packet at the front of the queue.
      * @throw runtime error if the queue is currently empty.
      */
-    virtual Packet peek() const override;
+    virtual PacketHandle peek() const override;
 
     /**
      * Pushes a new packet onto the queue.
      */
-    virtual void push(const Packet& packet) override;
+    virtual void push(const PacketHandle handle) override;
+
+    /**
+     * Resets the queue to its initial (empty) state.
+     */
+    virtual void reset() override;
 };
 
 #endif // SIMULATOR_QUEUEING_FCFS_QUEUE_H
@@ -26,36 +26,73 @@ bool FQFlowMetadata::pop() {
     return (num_packets_ == 0);
 }
 
+bool FQFlowMetadata::popBack(const Packet& packet) {
+    if (num_packets_ == 0) {
+        throw std::runtime_error("Cannot pop an empty flow queue.");
+    }
+    // The next-to-last packet's virtual clock
+    virtual_clock_ -= packet.getJobSizeEstimate();
+    num_packets_--;
+    return (num_packets_ == 0);
+}
+
 /**
  * FQQueue implementation.
  */
-Packet FQQueue::pop() {
+PacketHandle FQQueue::pop() {
     BaseQueue::assertNotEmpty(empty());
-    Packet packet = queue_.top().tag();
+    const PacketHandle handle = queue_.top().tag();
     queue_.pop(); // Pop the global queue
 
     // Update the flow metadata
-    auto iter = data_.find(packet.getFlowId());
+    auto iter = data_.find(getPacket(handle).getFlowId());
     assert(iter != data_.end()); // Sanity check
     if (iter->second.pop()) { data_.erase(iter); }
 
     size_--; // Decrement the global queue size
-    return packet;
+    return handle;
+}
+
+PacketHandle FQQueue::popBack() {
+    BaseQueue::assertNotEmpty(empty());
+    BaseQueue::assertDoubleEnded();
+
+    // Since virtual clocks are non-decreasing along each flow,
+    // the packet with the largest virtual clock is at the back
+    // of its flow queue.
+    const PacketHandle handle = queue_.bottom().tag();
+    queue_.popBottom(); // Pop the global queue
+
+    // Update the flow metadata
+    const Packet& packet = getPacket(handle);
+    auto iter = data_.find(packet.getFlowId());
+    assert(iter != data_.end()); // Sanity check
+    if (iter->second.popBack(packet)) { data_.erase(iter); }
+
+    size_--; // Decrement the global queue size
+    return handle;
 }
 
-Packet FQQueue::peek() const {
+PacketHandle FQQueue::peek() const {
     BaseQueue::assertNotEmpty(empty());
     return queue_.top().tag();
 }
 
-void FQQueue::push(const Packet& packet) {
+void FQQueue::push(const PacketHandle handle) {
     // Fetch (and update) the flow metadata
+    const Packet& packet = getPacket(handle);
     const FQFlowMetadata data = data_[
         packet.getFlowId()].push(packet);
 
-    FQPriorityEntry entry(packet, data.getVirtualClock(),
+    FQPriorityEntry entry(handle, data.getVirtualClock(),
                           packet.getArriveTime());
 
     queue_.push(entry); // Insert packet into the queue
     size_++; // Increment the global queue size
 }
+
+void FQQueue::reset() {
+    size_ = 0;
+    data_.clear();
+    queue_.clear();
+}
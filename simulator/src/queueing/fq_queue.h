@@ -4,14 +4,12 @@
 // Library headers
 #include "base_queue.h"
 #include "common/utils.h"
-#include "packet/packet.h"
+#include "double_ended_heap.h"
+#include "packet/packet_arena.h"
 
 // STD headers
 #include <unordered_map>
 
-// Boost headers
-#include <boost/heap/binomial_heap.hpp>
-
 /**
  * Per-flow metadata in a FQ-based queue.
  */
@@ -35,18 +33,26 @@ public:
      * @return Whether the flow queue becomes empty.
      */
     bool pop();
+
+    /**
+     * Removes the given packet (which must be the one
+     * at the back of the flow queue), rolling back the
+     * flow's virtual clock.
+     * @return Whether the flow queue becomes empty.
+     */
+    bool popBack(const Packet& packet);
 };
 
 /**
  * Represents a FQ-based queue.
  */
-class FQQueue : public BaseQueue {
+class FQQueue final : public BaseQueue {
 private:
     size_t size_ = 0; // Queue size
-    typedef MinHeapEntry<Packet, double> FQPriorityEntry;
+    typedef MinHeapEntry<PacketHandle, double> FQPriorityEntry;
     std::unordered_map<FlowId, FQFlowMetadata, HashFlowId,
                        EqualToFlowId> data_; // Flow ID -> Metadata
-    boost::heap::binomial_heap<FQPriorityEntry> queue_; // Packet queue
+    DoubleEndedHeap<double> queue_; // Packet queue
 
 public:
     explicit FQQueue() : BaseQueue(name()) {}
@@ -76,18 +82,38 @@ public:
      * Pops (and returns) the packet at the front of the queue.
      * @throw runtime error if the queue is currently empty.
      */
-    virtual Packet pop() override;
+    virtual PacketHandle pop() override;
+
+    /**
+     * Enables (or disables) popBack().
+     */
+    virtual void setDoubleEnded(const bool enabled) override {
+        BaseQueue::setDoubleEnded(enabled);
+        queue_.setDoubleEnded(enabled);
+    }
+
+    /**
+     * Pops (and returns) the packet at the back of the queue.
+     * @throw runtime error if the queue is currently empty, or
+     * is not double-ended.
+     */
+    virtual PacketHandle popBack() override;
 
     /**
      * Returns (w/o popping) the packet at the front of the queue.
      * @throw runtime error if the queue is currently empty.
      */
-    virtual Packet peek() const override;
+    virtual PacketHandle peek() const override;
 
     /**
      * Pushes a new packet onto the queue.
      */
-    virtual void push(const Packet& packet) override;
+    virtual void push(const PacketHandle handle) override;
+
+    /**
+     * Resets the queue to its initial (empty) state.
+     */
+    virtual void reset() override;
 };
 
 #endif // SIMULATOR_QUEUEING_FQ_QUEUE_H
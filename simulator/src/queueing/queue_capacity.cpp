@@ -0,0 +1,30 @@
+#include "queue_capacity.h"
+
+// STD headers
+#include <string>
+
+/**
+ * QueueCapacity implementation.
+ */
+void QueueCapacity::print(std::ostream& out) const {
+    if (packets != 0) { out << " " << packets << " packets"; }
+    if (bytes != 0) {
+        out << ((packets != 0) ? ", " : " ") << bytes << " bytes";
+    }
+    out << " (" << toString(drop_policy) << ")";
+}
+
+QueueCapacity parseQueueCapacity(const libconfig::Setting& config) {
+    QueueCapacity capacity;
+    unsigned long long value;
+    if (config.lookupValue("queue_capacity_packets", value)) {
+        capacity.packets = value;
+    }
+    if (config.lookupValue("queue_capacity_bytes", value)) {
+        capacity.bytes = value;
+    }
+    std::string drop_policy = toString(capacity.drop_policy);
+    config.lookupValue("drop_policy", drop_policy);
+    capacity.drop_policy = parseDropPolicy(drop_policy);
+    return capacity;
+}
@@ -0,0 +1,109 @@
+#ifndef SIMULATOR_QUEUEING_QUEUE_CAPACITY_H
+#define SIMULATOR_QUEUEING_QUEUE_CAPACITY_H
+
+// Library headers
+#include "base_queue.h"
+#include "packet/packet_arena.h"
+
+// STD headers
+#include <limits>
+#include <ostream>
+#include <stdint.h>
+
+// Libconfig
+#include <libconfig.h++>
+
+/**
+ * Represents the capacity of a queue, in packets and/or bytes (zero
+ * means unbounded), and the policy used to drop packets once it is
+ * full (see admitPacket).
+ */
+struct QueueCapacity final {
+    uint64_t packets = 0; // Capacity in packets (0: unbounded)
+    uint64_t bytes = 0; // Capacity in bytes (0: unbounded)
+    DropPolicy drop_policy = DropPolicy::TAIL; // Drop policy
+
+    // Accessors
+    bool isBounded() const { return ((packets != 0) || (bytes != 0)); }
+    uint64_t getMaxSize() const {
+        return (packets != 0) ? packets : std::numeric_limits<uint64_t>::max();
+    }
+    uint64_t getMaxPacketSizeInBits() const {
+        return (bytes != 0) ? (bytes * 8) : std::numeric_limits<uint64_t>::max();
+    }
+
+    /**
+     * Print the capacity (e.g., " 64 packets, 96000 bytes (drop_tail)").
+     */
+    void print(std::ostream& out) const;
+};
+
+/**
+ * Helper function to parse the queue capacity ('queue_capacity_packets'
+ * and/or 'queue_capacity_bytes') and the drop policy ('drop_policy').
+ * @throw invalid argument if the drop policy is unknown.
+ */
+QueueCapacity parseQueueCapacity(const libconfig::Setting& config);
+
+/**
+ * Admits the given packet into a bounded queue, dropping packets (per
+ * the drop policy) until the queue fits within its capacity. The queued
+ * packet size (in bits) is tracked in queue_psize. Every evicted (or
+ * rejected) packet is passed to drop, and on_queue_op is invoked before
+ * every queue operation (with true for enqueues, false for dequeues),
+ * e.g. to charge its cost. Packets larger than the byte capacity are
+ * always dropped. Note: The queue must be double-ended if the drop
+ * policy is MAX.
+ */
+template<class Queue, class DropFn, class QueueOpFn>
+void admitPacket(Queue& queue, const PacketArena& arena,
+                 const PacketHandle handle, const QueueCapacity& capacity,
+                 uint64_t& queue_psize, DropFn&& drop, QueueOpFn&& on_queue_op) {
+    const uint64_t capacity_size = capacity.getMaxSize();
+    const uint64_t capacity_psize = capacity.getMaxPacketSizeInBits();
+    const uint32_t psize = arena[handle].getPacketSize();
+
+    // If the packet can never fit (i.e., even in an empty queue),
+    // drop it without evicting anything (for any drop policy).
+    if (psize > capacity_psize) { drop(handle); return; }
+
+    // Drop-max: Enqueue the packet, then evict the
+    // lowest-priority packets (possibly this one).
+    if (capacity.drop_policy == DropPolicy::MAX) {
+        on_queue_op(true);
+        queue.push(handle);
+        queue_psize += psize;
+        while ((queue.size() > capacity_size) ||
+               (queue_psize > capacity_psize)) {
+            on_queue_op(false);
+            const PacketHandle victim = queue.popBack();
+            queue_psize -= arena[victim].getPacketSize();
+            drop(victim);
+        }
+        return;
+    }
+    // Drop-head: Evict packets from the front
+    // of the queue to make room for the packet.
+    if (capacity.drop_policy == DropPolicy::HEAD) {
+        while (!queue.empty() &&
+               ((queue.size() >= capacity_size) ||
+                ((queue_psize + psize) > capacity_psize))) {
+            on_queue_op(false);
+            const PacketHandle victim = queue.pop();
+            queue_psize -= arena[victim].getPacketSize();
+            drop(victim);
+        }
+    }
+    // Drop the packet if it still doesn't fit
+    if ((queue.size() >= capacity_size) ||
+        ((queue_psize + psize) > capacity_psize)) {
+        drop(handle);
+    }
+    else {
+        on_queue_op(true);
+        queue.push(handle);
+        queue_psize += psize;
+    }
+}
+
+#endif // SIMULATOR_QUEUEING_QUEUE_CAPACITY_H
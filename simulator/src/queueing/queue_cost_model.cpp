@@ -0,0 +1,183 @@
+#include "queue_cost_model.h"
+
+// STD headers
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * Helper function. Returns the list of numbers at the given path.
+ */
+static std::vector<double> lookupList(const libconfig::Setting& config,
+                                      const std::string& path) {
+    const libconfig::Setting& setting = config[path.c_str()];
+    std::vector<double> values;
+    for (int idx = 0; idx < setting.getLength(); idx++) {
+        values.push_back(static_cast<double>(setting[idx]));
+    }
+    return values;
+}
+
+/**
+ * QueueCostModel implementation.
+ */
+QueueCostModel* QueueCostModel::generate(const libconfig::Setting& config) {
+    QueueCostModel* model = nullptr;
+
+    std::string type; // Model type
+    if (!config.lookupValue("type", type)) {
+        throw std::runtime_error("No queue cost model type specified.");
+    }
+    // Constant costs
+    else if (type == ConstantQueueCostModel::name()) {
+        double enqueue_ns = 0, dequeue_ns = 0;
+        config.lookupValue("enqueue_ns", enqueue_ns);
+        config.lookupValue("dequeue_ns", dequeue_ns);
+        model = new ConstantQueueCostModel(enqueue_ns, dequeue_ns);
+    }
+    // Logarithmic costs
+    else if (type == LogQueueCostModel::name()) {
+        double enqueue_ns = 0, enqueue_log_ns = 0;
+        double dequeue_ns = 0, dequeue_log_ns = 0;
+        config.lookupValue("enqueue_ns", enqueue_ns);
+        config.lookupValue("enqueue_log_ns", enqueue_log_ns);
+        config.lookupValue("dequeue_ns", dequeue_ns);
+        config.lookupValue("dequeue_log_ns", dequeue_log_ns);
+
+        // Note: The log terms vanish for empty queues, so they
+        // aren't covered by the (size-zero) sanity check below.
+        if ((enqueue_ns < 0) || (enqueue_log_ns < 0) ||
+            (dequeue_ns < 0) || (dequeue_log_ns < 0)) {
+            throw std::runtime_error(
+                "Queue operation costs must be non-negative.");
+        }
+        model = new LogQueueCostModel(enqueue_ns, enqueue_log_ns,
+                                      dequeue_ns, dequeue_log_ns);
+    }
+    // Measured costs
+    else if (type == TableQueueCostModel::name()) {
+        if (!config.exists("sizes") || !config.exists("enqueue_ns") ||
+            !config.exists("dequeue_ns")) {
+            throw std::runtime_error("Must specify 'sizes', 'enqueue_ns', "
+                                     "and 'dequeue_ns' for a cost table.");
+        }
+        model = new TableQueueCostModel(lookupList(config, "sizes"),
+                                        lookupList(config, "enqueue_ns"),
+                                        lookupList(config, "dequeue_ns"));
+    }
+    // Hardware queue
+    else if (type == HFFSQueueCostModel::name()) {
+        double clock_ghz = 0;
+        double enqueue_cycles = 1, dequeue_cycles = 1;
+        if (!config.lookupValue("clock_ghz", clock_ghz) || !(clock_ghz > 0)) {
+            throw std::runtime_error(
+                "Must specify a positive 'clock_ghz' for the hFFS model.");
+        }
+        config.lookupValue("enqueue_cycles", enqueue_cycles);
+        config.lookupValue("dequeue_cycles", dequeue_cycles);
+        model = new HFFSQueueCostModel(clock_ghz, enqueue_cycles,
+                                       dequeue_cycles);
+    }
+    else {
+        throw std::runtime_error("Unknown queue cost model: " + type + ".");
+    }
+    // Sanity check: Costs must be non-negative
+    if ((model->getEnqueueCost(0) < 0) || (model->getDequeueCost(0) < 0)) {
+        delete(model);
+        throw std::runtime_error("Queue operation costs must be non-negative.");
+    }
+    return model;
+}
+
+/**
+ * ConstantQueueCostModel implementation.
+ */
+void ConstantQueueCostModel::printConfiguration() const {
+    std::cout << "{ type: " << name() << ", "
+              << std::fixed << std::setprecision(2)
+              << "enqueue: " << kEnqueueNs << " ns, "
+              << "dequeue: " << kDequeueNs << " ns }";
+}
+
+/**
+ * LogQueueCostModel implementation.
+ */
+double LogQueueCostModel::getEnqueueCost(const size_t size) const {
+    return (kEnqueueNs + (kEnqueueLogNs * std::log2(size + 1)));
+}
+
+double LogQueueCostModel::getDequeueCost(const size_t size) const {
+    return (kDequeueNs + (kDequeueLogNs * std::log2(size + 1)));
+}
+
+void LogQueueCostModel::printConfiguration() const {
+    std::cout << "{ type: " << name() << ", "
+              << std::fixed << std::setprecision(2)
+              << "enqueue: " << kEnqueueNs << " + " << kEnqueueLogNs
+              << " * log2(n + 1) ns, "
+              << "dequeue: " << kDequeueNs << " + " << kDequeueLogNs
+              << " * log2(n + 1) ns }";
+}
+
+/**
+ * TableQueueCostModel implementation.
+ */
+TableQueueCostModel::TableQueueCostModel(
+    const std::vector<double>& sizes, const std::vector<double>& enqueue_ns,
+    const std::vector<double>& dequeue_ns) : QueueCostModel(name()),
+    kSizes(sizes), kEnqueueNs(enqueue_ns), kDequeueNs(dequeue_ns) {
+    if (kSizes.empty() || (kSizes.size() != kEnqueueNs.size()) ||
+        (kSizes.size() != kDequeueNs.size())) {
+        throw std::runtime_error("Cost table columns must be non-empty, "
+                                 "and of equal length.");
+    }
+    for (size_t idx = 1; idx < kSizes.size(); idx++) {
+        if (!(kSizes[idx] > kSizes[idx - 1])) {
+            throw std::runtime_error(
+                "Cost table sizes must be strictly increasing.");
+        }
+    }
+    for (size_t idx = 0; idx < kSizes.size(); idx++) {
+        if ((kEnqueueNs[idx] < 0) || (kDequeueNs[idx] < 0)) {
+            throw std::runtime_error(
+                "Queue operation costs must be non-negative.");
+        }
+    }
+}
+
+double TableQueueCostModel::interpolate(const std::vector<double>& costs,
+                                        const size_t size) const {
+    const double x = static_cast<double>(size);
+    if (x <= kSizes.front()) { return costs.front(); }
+    if (x >= kSizes.back()) { return costs.back(); }
+
+    // Find the enclosing measurements
+    const size_t hi = (std::upper_bound(kSizes.begin(), kSizes.end(), x) -
+                       kSizes.begin());
+    const size_t lo = (hi - 1);
+    const double t = ((x - kSizes[lo]) / (kSizes[hi] - kSizes[lo]));
+    return (costs[lo] + (t * (costs[hi] - costs[lo])));
+}
+
+void TableQueueCostModel::printConfiguration() const {
+    std::cout << "{ type: " << name() << ", "
+              << std::fixed << std::setprecision(2) << "entries: [";
+    for (size_t idx = 0; idx < kSizes.size(); idx++) {
+        std::cout << ((idx == 0) ? "" : ", ") << "(" << kSizes[idx] << ": "
+                  << kEnqueueNs[idx] << ", " << kDequeueNs[idx] << ")";
+    }
+    std::cout << "] ns }";
+}
+
+/**
+ * HFFSQueueCostModel implementation.
+ */
+void HFFSQueueCostModel::printConfiguration() const {
+    std::cout << "{ type: " << name() << ", "
+              << std::fixed << std::setprecision(2)
+              << "clock: " << kClockGHz << " GHz, "
+              << "enqueue: " << kEnqueueCycles << " cycles, "
+              << "dequeue: " << kDequeueCycles << " cycles }";
+}
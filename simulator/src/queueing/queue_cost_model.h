@@ -0,0 +1,182 @@
+#ifndef SIMULATOR_QUEUEING_QUEUE_COST_MODEL_H
+#define SIMULATOR_QUEUEING_QUEUE_COST_MODEL_H
+
+// Library headers
+#include "common/macros.h"
+
+// STD headers
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+// Libconfig
+#include <libconfig.h++>
+
+/**
+ * Base class representing the cost (in ns) of queue operations, as
+ * a function of the queue size at the time of the operation. These
+ * model the scheduler itself (e.g., heap operations on the NF's data
+ * path), as opposed to the work performed by the servers.
+ */
+class QueueCostModel {
+protected:
+    const std::string kType; // Model type
+    explicit QueueCostModel(const std::string type) : kType(type) {}
+
+public:
+    virtual ~QueueCostModel() {}
+    DISALLOW_COPY_AND_ASSIGN(QueueCostModel);
+
+    /**
+     * Returns the model type.
+     */
+    const std::string& type() const { return kType; }
+
+    /**
+     * Returns the cost of inserting a packet into a queue of the given size.
+     */
+    virtual double getEnqueueCost(const size_t size) const = 0;
+
+    /**
+     * Returns the cost of removing a packet from a queue of the given size.
+     */
+    virtual double getDequeueCost(const size_t size) const = 0;
+
+    /**
+     * Print the model configuration.
+     */
+    virtual void printConfiguration() const = 0;
+
+    /**
+     * Returns the cost model specified in the given configuration.
+     * @throw runtime error if the configuration is invalid.
+     */
+    static QueueCostModel* generate(const libconfig::Setting& config);
+};
+
+/**
+ * Queue operations take constant time, irrespective of the queue size.
+ */
+class ConstantQueueCostModel final : public QueueCostModel {
+private:
+    const double kEnqueueNs; // Enqueue cost (ns)
+    const double kDequeueNs; // Dequeue cost (ns)
+
+public:
+    explicit ConstantQueueCostModel(const double enqueue_ns,
+                                    const double dequeue_ns) :
+        QueueCostModel(name()), kEnqueueNs(enqueue_ns),
+        kDequeueNs(dequeue_ns) {}
+
+    /**
+     * Returns the model name.
+     */
+    static std::string name() { return "constant"; }
+
+    virtual double getEnqueueCost(const size_t /* size */) const override {
+        return kEnqueueNs;
+    }
+    virtual double getDequeueCost(const size_t /* size */) const override {
+        return kDequeueNs;
+    }
+    virtual void printConfiguration() const override;
+};
+
+/**
+ * Queue operations take (a + b * log2(n + 1)) ns, where n is the
+ * queue size (e.g., for binary or binomial heaps).
+ */
+class LogQueueCostModel final : public QueueCostModel {
+private:
+    const double kEnqueueNs; // Enqueue cost (ns, constant term)
+    const double kEnqueueLogNs; // Enqueue cost (ns, per log2(n + 1))
+    const double kDequeueNs; // Dequeue cost (ns, constant term)
+    const double kDequeueLogNs; // Dequeue cost (ns, per log2(n + 1))
+
+public:
+    explicit LogQueueCostModel(const double enqueue_ns,
+                               const double enqueue_log_ns,
+                               const double dequeue_ns,
+                               const double dequeue_log_ns) :
+        QueueCostModel(name()), kEnqueueNs(enqueue_ns),
+        kEnqueueLogNs(enqueue_log_ns), kDequeueNs(dequeue_ns),
+        kDequeueLogNs(dequeue_log_ns) {}
+
+    /**
+     * Returns the model name.
+     */
+    static std::string name() { return "log"; }
+
+    virtual double getEnqueueCost(const size_t size) const override;
+    virtual double getDequeueCost(const size_t size) const override;
+    virtual void printConfiguration() const override;
+};
+
+/**
+ * Queue operation costs are measured (e.g., using the DPDK benchmark)
+ * at a set of queue sizes, and linearly interpolated in between. Costs
+ * beyond the measured range are clamped to the nearest measurement.
+ */
+class TableQueueCostModel final : public QueueCostModel {
+private:
+    const std::vector<double> kSizes; // Measured queue sizes (ascending)
+    const std::vector<double> kEnqueueNs; // Measured enqueue costs (ns)
+    const std::vector<double> kDequeueNs; // Measured dequeue costs (ns)
+
+    // Internal helper method. Interpolates the given costs.
+    double interpolate(const std::vector<double>& costs,
+                       const size_t size) const;
+
+public:
+    explicit TableQueueCostModel(const std::vector<double>& sizes,
+                                 const std::vector<double>& enqueue_ns,
+                                 const std::vector<double>& dequeue_ns);
+
+    /**
+     * Returns the model name.
+     */
+    static std::string name() { return "table"; }
+
+    virtual double getEnqueueCost(const size_t size) const override {
+        return interpolate(kEnqueueNs, size);
+    }
+    virtual double getDequeueCost(const size_t size) const override {
+        return interpolate(kDequeueNs, size);
+    }
+    virtual void printConfiguration() const override;
+};
+
+/**
+ * Models the hardware (hFFS) queue, which is fully pipelined: every
+ * operation takes a fixed number of cycles, regardless of the queue
+ * size. By default, both enqueues and dequeues take 1 cycle, since
+ * the wrapper prefetches the minimum (see pipelined_heap_wrapper.sv).
+ */
+class HFFSQueueCostModel final : public QueueCostModel {
+private:
+    const double kClockGHz; // Clock frequency (GHz)
+    const double kEnqueueCycles; // Cycles per enqueue
+    const double kDequeueCycles; // Cycles per dequeue
+
+public:
+    explicit HFFSQueueCostModel(const double clock_ghz,
+                                const double enqueue_cycles=1,
+                                const double dequeue_cycles=1) :
+        QueueCostModel(name()), kClockGHz(clock_ghz),
+        kEnqueueCycles(enqueue_cycles), kDequeueCycles(dequeue_cycles) {}
+
+    /**
+     * Returns the model name.
+     */
+    static std::string name() { return "hffs"; }
+
+    virtual double getEnqueueCost(const size_t /* size */) const override {
+        return (kEnqueueCycles / kClockGHz);
+    }
+    virtual double getDequeueCost(const size_t /* size */) const override {
+        return (kDequeueCycles / kClockGHz);
+    }
+    virtual void printConfiguration() const override;
+};
+
+#endif // SIMULATOR_QUEUEING_QUEUE_COST_MODEL_H
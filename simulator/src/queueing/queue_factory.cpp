@@ -1,25 +1,21 @@
 #include "queue_factory.h"
 
-// Library headers
-#include "fcfs_queue.h"
-#include "fq_queue.h"
-#include "sjf_queue.h"
-#include "sjf_inorder_queue.h"
-#include "wsjf_queue.h"
-#include "wsjf_inorder_queue.h"
-
 // STD headers
 #include <stdexcept>
 
 BaseQueue* QueueFactory::
 generate(const libconfig::Setting& queue_config) {
-    BaseQueue* queue = nullptr;
     std::string policy; // Queueing policy
     if (!queue_config.lookupValue("policy", policy)) {
         throw std::runtime_error("Must specify 'policy' to use.");
     }
+    return generate(policy);
+}
+
+BaseQueue* QueueFactory::generate(const std::string& policy) {
+    BaseQueue* queue = nullptr;
     // FCFS queue
-    else if (policy == FCFSQueue::name()) {
+    if (policy == FCFSQueue::name()) {
         queue = new FCFSQueue();
     }
     // FQ queue
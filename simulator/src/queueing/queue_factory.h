@@ -3,6 +3,16 @@
 
 // Library headers
 #include "base_queue.h"
+#include "common/type_dispatch.h"
+#include "fcfs_queue.h"
+#include "fq_queue.h"
+#include "sjf_queue.h"
+#include "sjf_inorder_queue.h"
+#include "wsjf_queue.h"
+#include "wsjf_inorder_queue.h"
+
+// STD headers
+#include <string>
 
 // Libconfig
 #include <libconfig.h++>
@@ -12,12 +22,22 @@
  */
 class QueueFactory final {
 public:
+    // Built-in queue types (see Simulator::run)
+    typedef TypeDispatcher<BaseQueue, FCFSQueue, FQQueue, SJFQueue,
+                           SJFInorderQueue, WSJFQueue,
+                           WSJFInorderQueue> Types;
+
     /**
      * Returns a queue corresponding to the queueing
      * policy specified in the given configuration.
      */
     static BaseQueue*
     generate(const libconfig::Setting& queue_config);
+
+    /**
+     * Returns a queue implementing the given policy.
+     */
+    static BaseQueue* generate(const std::string& policy);
 };
 
 #endif // SIMULATOR_QUEUEING_QUEUE_FACTORY_H
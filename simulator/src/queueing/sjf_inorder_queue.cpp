@@ -4,88 +4,148 @@
  * SJFInorderFlowMetadata implementation.
  */
 SJFInorderFlowMetadata&
-SJFInorderFlowMetadata::push(const Packet& packet) {
+SJFInorderFlowMetadata::push(const PacketArena& arena,
+                             const PacketHandle handle) {
     // Update the flow's cumulative job size, and
     // insert the given packet into the queue.
-    queue_.push(packet);
+    const Packet& packet = arena[handle];
+    queue_.push_back(handle);
     total_jsize_ += packet.getJobSizeEstimate();
 
     return *this;
 }
 
-Packet SJFInorderFlowMetadata::pop() {
+PacketHandle SJFInorderFlowMetadata::pop(const PacketArena& arena) {
     if (queue_.empty()) {
         throw std::runtime_error("Cannot pop an empty flow queue.");
     }
     // Update the flow queue state
-    Packet packet = queue_.front();
+    const PacketHandle handle = queue_.front();
+    const Packet& packet = arena[handle];
     total_jsize_ -= packet.getJobSizeEstimate();
+    queue_.pop_front();
+
+    // Discard any accumulated floating-point error
+    if (queue_.empty()) { total_jsize_ = 0; }
+    assert(total_jsize_ >= 0); // Sanity check
+
+    return handle;
+}
+
+PacketHandle SJFInorderFlowMetadata::popBack(const PacketArena& arena) {
+    if (queue_.empty()) {
+        throw std::runtime_error("Cannot pop an empty flow queue.");
+    }
+    // Update the flow queue state
+    const PacketHandle handle = queue_.back();
+    const Packet& packet = arena[handle];
+    total_jsize_ -= packet.getJobSizeEstimate();
+    queue_.pop_back();
+
+    // Discard any accumulated floating-point error
+    if (queue_.empty()) { total_jsize_ = 0; }
     assert(total_jsize_ >= 0); // Sanity check
-    queue_.pop();
 
-    return packet;
+    return handle;
 }
 
 /**
  * SJFInorderQueue implementation.
  */
-Packet SJFInorderQueue::pop() {
+void SJFInorderQueue::updatePriority(const FlowId& flow_id,
+                                     const SJFInorderFlowMetadata& data) {
+    const SJFPriorityEntry entry(flow_id, data.getFlowRatio(),
+                                 getPacket(data.front()).getArriveTime());
+
+    priorities_.update(data.getHandle(), entry);
+    if (is_double_ended_) {
+        back_priorities_.update(data.getBackHandle(), entry);
+    }
+}
+
+PacketHandle SJFInorderQueue::pop() {
     BaseQueue::assertNotEmpty(empty());
     const FlowId flow_id = priorities_.top().tag();
     auto iter = data_.find(flow_id); // Fetch metadata
     assert(iter != data_.end() && !iter->second.empty());
-    const Packet packet = iter->second.pop(); // Pop the flow queue
+    const PacketHandle handle = iter->second.pop(*arena_); // Pop the flow queue
 
     // If the queue is not empty, update the correspoding
     // flow priority in the heap using the stored handle.
     if (!iter->second.empty()) {
-        priorities_.update(
-            iter->second.getHandle(),
-            SJFPriorityEntry(flow_id, iter->second.getFlowRatio(),
-                             iter->second.front().getArriveTime())
-        );
+        updatePriority(flow_id, iter->second);
     }
     // Else, purge both the flow mapping and heap entry
     else {
         priorities_.pop();
+        if (is_double_ended_) {
+            back_priorities_.erase(iter->second.getBackHandle());
+        }
+        data_.erase(iter);
+    }
+
+    size_--; // Update the global queue size
+    return handle;
+}
+
+PacketHandle SJFInorderQueue::popBack() {
+    BaseQueue::assertNotEmpty(empty());
+    BaseQueue::assertDoubleEnded();
+
+    // Drop the tail packet of the lowest-priority flow
+    const FlowId flow_id = back_priorities_.top().tag();
+    auto iter = data_.find(flow_id); // Fetch metadata
+    assert(iter != data_.end() && !iter->second.empty());
+    const PacketHandle handle = iter->second.popBack(*arena_);
+
+    if (!iter->second.empty()) {
+        updatePriority(flow_id, iter->second);
+    }
+    else {
+        priorities_.erase(iter->second.getHandle());
+        back_priorities_.pop();
         data_.erase(iter);
     }
 
     size_--; // Update the global queue size
-    return packet;
+    return handle;
 }
 
-Packet SJFInorderQueue::peek() const {
+PacketHandle SJFInorderQueue::peek() const {
     BaseQueue::assertNotEmpty(empty());
 
     const FlowId flow_id = priorities_.top().tag();
     return data_.at(flow_id).front();
 }
 
-void SJFInorderQueue::push(const Packet& packet) {
+void SJFInorderQueue::push(const PacketHandle handle) {
     // Insert this packet into the flow queue. If this is the
     // HoL packet for this flow, also insert it into the heap.
-    const FlowId flow_id = packet.getFlowId();
+    const FlowId flow_id = getPacket(handle).getFlowId();
     auto iter = data_.find(flow_id);
     if (iter == data_.end()) {
 
-        SJFInorderFlowMetadata& data = data_[flow_id].push(packet);
+        SJFInorderFlowMetadata& data = data_[flow_id].push(*arena_, handle);
         assert(data.size() == 1); // Sanity check
-        handle_t handle = priorities_.push(
-            SJFPriorityEntry(flow_id, data.getFlowRatio(),
-                             data.front().getArriveTime())
-        );
-        // Set the flow's heap handle
-        data.setHandle(handle);
+        const SJFPriorityEntry entry(flow_id, data.getFlowRatio(),
+                                     getPacket(data.front()).getArriveTime());
+
+        // Set the flow's heap handle(s)
+        data.setHandle(priorities_.push(entry));
+        if (is_double_ended_) {
+            data.setBackHandle(back_priorities_.push(entry));
+        }
     }
     else {
         assert(!iter->second.empty()); // Sanity check
-        SJFInorderFlowMetadata& data = iter->second.push(packet);
-        priorities_.update(
-            iter->second.getHandle(),
-            SJFPriorityEntry(flow_id, data.getFlowRatio(),
-                             data.front().getArriveTime())
-        );
+        updatePriority(flow_id, iter->second.push(*arena_, handle));
     }
     size_++; // Update the global queue size
 }
+
+void SJFInorderQueue::reset() {
+    size_ = 0;
+    data_.clear();
+    priorities_.clear();
+    back_priorities_.clear();
+}
@@ -4,10 +4,11 @@
 // Library headers
 #include "base_queue.h"
 #include "common/utils.h"
-#include "packet/packet.h"
+#include "double_ended_heap.h"
+#include "packet/packet_arena.h"
 
 // STD headers
-#include <queue>
+#include <deque>
 #include <unordered_map>
 
 // Boost headers
@@ -16,6 +17,9 @@
 // Typedefs
 typedef MinHeapEntry<FlowId, double> SJFPriorityEntry;
 typedef boost::heap::binomial_heap<SJFPriorityEntry>::handle_type handle_t;
+typedef boost::heap::binomial_heap<SJFPriorityEntry, boost::heap::compare<
+    ReverseHeapOrder<SJFPriorityEntry>>> back_heap_t;
+typedef back_heap_t::handle_type back_handle_t;
 
 /**
  * Per-flow metadata in an inorder SJF queue.
@@ -23,34 +27,44 @@ typedef boost::heap::binomial_heap<SJFPriorityEntry>::handle_type handle_t;
 class SJFInorderFlowMetadata {
 private:
     handle_t handle_; // Heap entry handle
-    std::queue<Packet> queue_; // Flow queue
+    back_handle_t back_handle_; // Reversed heap entry handle
+    std::deque<PacketHandle> queue_; // Flow queue
     double total_jsize_ = 0; // Cumulative job size (numerator)
 
 public:
     // Accessors
     handle_t getHandle() const { return handle_; }
+    back_handle_t getBackHandle() const { return back_handle_; }
     double getTotalJobSize() const { return total_jsize_; }
     double getFlowRatio() const { return (total_jsize_ / queue_.size()); }
 
     // Mutators
     void setHandle(const handle_t handle) { handle_ = handle; }
+    void setBackHandle(const back_handle_t handle) { back_handle_ = handle; }
 
     /**
      * Flow queue operations.
      */
     size_t size() const { return queue_.size(); }
     bool empty() const { return queue_.empty(); }
-    Packet front() const { return queue_.front(); }
+    PacketHandle front() const { return queue_.front(); }
 
     /**
-     * Append a new packet to the flow queue.
+     * Append a new packet (residing in the given arena)
+     * to the flow queue.
      */
-    SJFInorderFlowMetadata& push(const Packet& packet);
+    SJFInorderFlowMetadata& push(const PacketArena& arena,
+                                 const PacketHandle handle);
 
     /**
      * Deque the packet at the front of the flow queue.
      */
-    Packet pop();
+    PacketHandle pop(const PacketArena& arena);
+
+    /**
+     * Deque the packet at the back of the flow queue.
+     */
+    PacketHandle popBack(const PacketArena& arena);
 };
 
 /**
@@ -59,13 +73,20 @@ public:
  * J_{i} and n represent the job size of each queued packet
  * and the size of the queue for that flow, respectively.
  */
-class SJFInorderQueue : public BaseQueue {
+class SJFInorderQueue final : public BaseQueue {
 private:
     // Heap-based queue implementation
     size_t size_ = 0;
     boost::heap::binomial_heap<SJFPriorityEntry> priorities_;
+    back_heap_t back_priorities_; // Reversed, if double-ended
     std::unordered_map<FlowId, SJFInorderFlowMetadata, HashFlowId,
                        EqualToFlowId> data_; // Flow ID -> Metadata
+
+    // Internal helper method. Updates the priority of the given
+    // (non-empty) flow, which is already in the heap(s).
+    void updatePriority(const FlowId& flow_id,
+                        const SJFInorderFlowMetadata& data);
+
 public:
     explicit SJFInorderQueue() : BaseQueue(name()) {}
     virtual ~SJFInorderQueue() {}
@@ -94,18 +115,30 @@ public:
      * Pops (and returns) the packet at the front of the queue.
      * @throw runtime error if the queue is currently empty.
      */
-    virtual Packet pop() override;
+    virtual PacketHandle pop() override;
+
+    /**
+     * Pops (and returns) the packet at the back of the queue.
+     * @throw runtime error if the queue is currently empty, or
+     * is not double-ended.
+     */
+    virtual PacketHandle popBack() override;
 
     /**
      * Returns (w/o popping) the packet at the front of the queue.
      * @throw runtime error if the queue is currently empty.
      */
-    virtual Packet peek() const override;
+    virtual PacketHandle peek() const override;
 
     /**
      * Pushes a new packet onto the queue.
      */
-    virtual void push(const Packet& packet) override;
+    virtual void push(const PacketHandle handle) override;
+
+    /**
+     * Resets the queue to its initial (empty) state.
+     */
+    virtual void reset() override;
 };
 
 #endif // SIMULATOR_QUEUEING_SJF_INORDER_QUEUE_H
@@ -1,19 +1,38 @@
 #include "sjf_queue.h"
 
-Packet SJFQueue::pop() {
+PacketHandle SJFQueue::pop() {
     BaseQueue::assertNotEmpty(empty());
-    Packet packet = queue_.top().tag();
+    const PacketHandle handle = queue_.top().tag();
     queue_.pop();
-    return packet;
+    return handle;
 }
 
-Packet SJFQueue::peek() const {
+PacketHandle SJFQueue::popBack() {
+    BaseQueue::assertNotEmpty(empty());
+    BaseQueue::assertDoubleEnded();
+    const PacketHandle handle = queue_.bottom().tag();
+    queue_.popBottom();
+    return handle;
+}
+
+bool SJFQueue::isBefore(const PacketHandle a, const double attained_a,
+                        const PacketHandle b, const double attained_b) const {
+    return (getPacket(a).getRemainingJobSizeEstimate(attained_a) <
+            getPacket(b).getRemainingJobSizeEstimate(attained_b));
+}
+
+PacketHandle SJFQueue::peek() const {
     BaseQueue::assertNotEmpty(empty());
     return queue_.top().tag();
 }
 
-void SJFQueue::push(const Packet& packet) {
-    SJFPriorityEntry entry(packet, packet.getJobSizeEstimate(),
+void SJFQueue::push(const PacketHandle handle) {
+    const Packet& packet = getPacket(handle);
+    SJFPriorityEntry entry(handle, packet.getRemainingJobSizeEstimate(),
                            packet.getArriveTime());
     queue_.push(entry);
 }
+
+void SJFQueue::reset() {
+    queue_.clear();
+}
@@ -4,10 +4,11 @@
 // Library headers
 #include "base_queue.h"
 #include "common/utils.h"
-#include "packet/packet.h"
+#include "double_ended_heap.h"
+#include "packet/packet_arena.h"
 
 // STD headers
-#include <queue>
+#include <deque>
 #include <unordered_map>
 
 // Boost headers
@@ -16,6 +17,9 @@
 // Typedefs
 typedef MinHeapEntry<FlowId, double> WSJFPriorityEntry;
 typedef boost::heap::binomial_heap<WSJFPriorityEntry>::handle_type handle_t;
+typedef boost::heap::binomial_heap<WSJFPriorityEntry, boost::heap::compare<
+    ReverseHeapOrder<WSJFPriorityEntry>>> back_heap_t;
+typedef back_heap_t::handle_type back_handle_t;
 
 /**
  * Per-flow metadata in an inorder WSJF queue.
@@ -23,36 +27,46 @@ typedef boost::heap::binomial_heap<WSJFPriorityEntry>::handle_type handle_t;
 class WSJFInorderFlowMetadata {
 private:
     handle_t handle_; // Heap entry handle
-    std::queue<Packet> queue_; // Flow queue
+    back_handle_t back_handle_; // Reversed heap entry handle
+    std::deque<PacketHandle> queue_; // Flow queue
     double total_jsize_ = 0; // Cumulative job size (numerator)
     uint64_t total_psize_ = 0; // Cumulative packet size (denominator)
 
 public:
     // Accessors
     handle_t getHandle() const { return handle_; }
+    back_handle_t getBackHandle() const { return back_handle_; }
     double getTotalJobSize() const { return total_jsize_; }
     uint64_t getTotalPacketSize() const { return total_psize_; }
     double getFlowRatio() const { return (total_jsize_ / total_psize_); }
 
     // Mutators
     void setHandle(const handle_t handle) { handle_ = handle; }
+    void setBackHandle(const back_handle_t handle) { back_handle_ = handle; }
 
     /**
      * Flow queue operations.
      */
     size_t size() const { return queue_.size(); }
     bool empty() const { return queue_.empty(); }
-    Packet front() const { return queue_.front(); }
+    PacketHandle front() const { return queue_.front(); }
 
     /**
-     * Append a new packet to the flow queue.
+     * Append a new packet (residing in the given arena)
+     * to the flow queue.
      */
-    WSJFInorderFlowMetadata& push(const Packet& packet);
+    WSJFInorderFlowMetadata& push(const PacketArena& arena,
+                                  const PacketHandle handle);
 
     /**
      * Deque the packet at the front of the flow queue.
      */
-    Packet pop();
+    PacketHandle pop(const PacketArena& arena);
+
+    /**
+     * Deque the packet at the back of the flow queue.
+     */
+    PacketHandle popBack(const PacketArena& arena);
 };
 
 /**
@@ -61,14 +75,20 @@ public:
  * J_{q} and P_{q} represent the job and packet sizes of the queued
  * entries in each flow, respectively.
  */
-class WSJFInorderQueue : public BaseQueue {
+class WSJFInorderQueue final : public BaseQueue {
 private:
     // Heap-based queue implementation
     size_t size_ = 0;
     boost::heap::binomial_heap<WSJFPriorityEntry> priorities_;
+    back_heap_t back_priorities_; // Reversed, if double-ended
     std::unordered_map<FlowId, WSJFInorderFlowMetadata, HashFlowId,
                        EqualToFlowId> data_; // Flow ID -> Metadata
 
+    // Internal helper method. Updates the priority of the given
+    // (non-empty) flow, which is already in the heap(s).
+    void updatePriority(const FlowId& flow_id,
+                        const WSJFInorderFlowMetadata& data);
+
 public:
     explicit WSJFInorderQueue() : BaseQueue(name()) {}
     virtual ~WSJFInorderQueue() {}
@@ -97,18 +117,30 @@ public:
      * Pops (and returns) the packet at the front of the queue.
      * @throw runtime error if the queue is currently empty.
      */
-    virtual Packet pop() override;
+    virtual PacketHandle pop() override;
+
+    /**
+     * Pops (and returns) the packet at the back of the queue.
+     * @throw runtime error if the queue is currently empty, or
+     * is not double-ended.
+     */
+    virtual PacketHandle popBack() override;
 
     /**
      * Returns (w/o popping) the packet at the front of the queue.
      * @throw runtime error if the queue is currently empty.
      */
-    virtual Packet peek() const override;
+    virtual PacketHandle peek() const override;
 
     /**
      * Pushes a new packet onto the queue.
      */
-    virtual void push(const Packet& packet) override;
+    virtual void push(const PacketHandle handle) override;
+
+    /**
+     * Resets the queue to its initial (empty) state.
+     */
+    virtual void reset() override;
 };
 
 #endif // SIMULATOR_QUEUEING_WSJF_INORDER_QUEUE_H
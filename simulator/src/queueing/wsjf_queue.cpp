@@ -1,21 +1,39 @@
 #include "wsjf_queue.h"
 
-Packet WSJFQueue::pop() {
+PacketHandle WSJFQueue::pop() {
     BaseQueue::assertNotEmpty(empty());
-    Packet packet = queue_.top().tag();
+    const PacketHandle handle = queue_.top().tag();
     queue_.pop();
-    return packet;
+    return handle;
 }
 
-Packet WSJFQueue::peek() const {
+PacketHandle WSJFQueue::popBack() {
     BaseQueue::assertNotEmpty(empty());
-    return queue_.top().tag();
+    BaseQueue::assertDoubleEnded();
+    const PacketHandle handle = queue_.bottom().tag();
+    queue_.popBottom();
+    return handle;
+}
+
+bool WSJFQueue::isBefore(const PacketHandle a, const double attained_a,
+                         const PacketHandle b, const double attained_b) const {
+    return (getMetric(getPacket(a), attained_a) <
+            getMetric(getPacket(b), attained_b));
 }
 
-void WSJFQueue::push(const Packet& packet) {
-    double metric = (packet.getJobSizeEstimate() /
-                     static_cast<double>(packet.getPacketSize()));
+PacketHandle WSJFQueue::peek() const {
+    BaseQueue::assertNotEmpty(empty());
+    return queue_.top().tag();
+}
 
-    WSJFPriorityEntry entry(packet, metric, packet.getArriveTime());
+void WSJFQueue::push(const PacketHandle handle) {
+    const Packet& packet = getPacket(handle);
+    WSJFPriorityEntry entry(handle, getMetric(packet,
+                                              packet.getAttainedService()),
+                            packet.getArriveTime());
     queue_.push(entry);
 }
+
+void WSJFQueue::reset() {
+    queue_.clear();
+}
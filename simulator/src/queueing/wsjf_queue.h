@@ -4,19 +4,24 @@
 // Library headers
 #include "base_queue.h"
 #include "common/utils.h"
-#include "packet/packet.h"
-
-// Boost headers
-#include <boost/heap/binomial_heap.hpp>
+#include "double_ended_heap.h"
+#include "packet/packet_arena.h"
 
 /**
  * Represents a Weighted SJF queue.
  */
-class WSJFQueue : public BaseQueue {
+class WSJFQueue final : public BaseQueue {
 private:
     // Heap-based queue implementation
-    typedef MinHeapEntry<Packet, double> WSJFPriorityEntry;
-    boost::heap::binomial_heap<WSJFPriorityEntry> queue_;
+    typedef MinHeapEntry<PacketHandle, double> WSJFPriorityEntry;
+    DoubleEndedHeap<double> queue_;
+
+    // Internal helper method. Returns the priority metric (lower
+    // is better) of the given packet, given its attained service.
+    static double getMetric(const Packet& packet, const double attained) {
+        return (packet.getRemainingJobSizeEstimate(attained) /
+                static_cast<double>(packet.getPacketSize()));
+    }
 
 public:
     explicit WSJFQueue() : BaseQueue(name()) {}
@@ -42,22 +47,55 @@ public:
      */
     virtual bool isFlowOrderMaintained() const override { return false; }
 
+    /**
+     * Returns whether this queue supports preemptive scheduling.
+     */
+    virtual bool isPreemptionSupported() const override { return true; }
+
+    /**
+     * Returns whether packet a has a strictly smaller ratio of remaining
+     * job size estimate (given its attained service) to packet size than b.
+     */
+    virtual bool isBefore(const PacketHandle a, const double attained_a,
+                          const PacketHandle b,
+                          const double attained_b) const override;
+
     /**
      * Pops (and returns) the packet at the front of the queue.
      * @throw runtime error if the queue is currently empty.
      */
-    virtual Packet pop() override;
+    virtual PacketHandle pop() override;
+
+    /**
+     * Enables (or disables) popBack().
+     */
+    virtual void setDoubleEnded(const bool enabled) override {
+        BaseQueue::setDoubleEnded(enabled);
+        queue_.setDoubleEnded(enabled);
+    }
+
+    /**
+     * Pops (and returns) the packet at the back of the queue.
+     * @throw runtime error if the queue is currently empty, or
+     * is not double-ended.
+     */
+    virtual PacketHandle popBack() override;
 
     /**
      * Returns (w/o popping) the packet at the front of the queue.
      * @throw runtime error if the queue is currently empty.
      */
-    virtual Packet peek() const override;
+    virtual PacketHandle peek() const override;
 
     /**
      * Pushes a new packet onto the queue.
      */
-    virtual void push(const Packet& packet) override;
+    virtual void push(const PacketHandle handle) override;
+
+    /**
+     * Resets the queue to its initial (empty) state.
+     */
+    virtual void reset() override;
 };
 
 #endif // SIMULATOR_QUEUEING_WSJF_QUEUE_H
@@ -0,0 +1,71 @@
+#include "rss_dispatcher.h"
+
+// STD headers
+#include <stdexcept>
+
+// Default (Microsoft) RSS key, as used by most NIC drivers
+static constexpr uint8_t kToeplitzKey[40] = {
+    0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
+    0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
+    0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
+    0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
+    0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa,
+};
+
+RSSHash parseRSSHash(const std::string& name) {
+    if (name == "toeplitz") { return RSSHash::TOEPLITZ; }
+    else if (name == "xor") { return RSSHash::XOR; }
+    throw std::invalid_argument("Unknown RSS hash: " + name + ".");
+}
+
+std::string toString(const RSSHash hash) {
+    return (hash == RSSHash::XOR) ? "xor" : "toeplitz";
+}
+
+/**
+ * RSSDispatcher implementation.
+ */
+RSSDispatcher::RSSDispatcher(const uint32_t num_cores, const RSSHash hash) :
+                             num_cores_(num_cores), hash_(hash) {
+    if (num_cores == 0) {
+        throw std::invalid_argument("Core count must be positive.");
+    }
+    // Spread the indirection table entries across cores
+    for (uint32_t idx = 0; idx < kIndirectionTableSize; idx++) {
+        indirection_table_[idx] = (idx % num_cores_);
+    }
+    // Precompute the Toeplitz hash. For every set bit i of the
+    // input (MSB-first), the hash is XOR'd with the 32 bits of
+    // the key starting at bit i; since this is linear in the
+    // input, it can be tabulated per input byte.
+    for (uint32_t offset = 0; offset < kFlowIdBytes; offset++) {
+        for (uint32_t value = 0; value < 256; value++) {
+            uint32_t result = 0;
+            for (uint32_t bit = 0; bit < 8; bit++) {
+                if (!(value & (0x80 >> bit))) { continue; }
+                const uint32_t key_bit = (offset * 8) + bit;
+                uint64_t window = 0;
+                for (uint32_t byte = 0; byte < 5; byte++) {
+                    window = (window << 8) | kToeplitzKey[(key_bit / 8) + byte];
+                }
+                result ^= static_cast<uint32_t>(window >> (8 - (key_bit % 8)));
+            }
+            toeplitz_table_[offset][value] = result;
+        }
+    }
+}
+
+uint32_t RSSDispatcher::hashToeplitz(const FlowId& flow_id) const {
+    // Serialize the flow ID in network byte order
+    const uint32_t words[3] = {
+        flow_id.getSrcIP(), flow_id.getDstIP(),
+        ((static_cast<uint32_t>(flow_id.getSrcPort()) << 16) |
+         flow_id.getDstPort())};
+
+    uint32_t result = 0;
+    for (uint32_t offset = 0; offset < kFlowIdBytes; offset++) {
+        const uint8_t value = (words[offset / 4] >> (24 - 8 * (offset % 4)));
+        result ^= toeplitz_table_[offset][value];
+    }
+    return result;
+}
@@ -0,0 +1,79 @@
+#ifndef SIMULATOR_SERVER_RSS_DISPATCHER_H
+#define SIMULATOR_SERVER_RSS_DISPATCHER_H
+
+// Library headers
+#include "packet/packet.h"
+
+// STD headers
+#include <stdint.h>
+#include <string>
+
+/**
+ * Flow hash functions for RSS dispatch. TOEPLITZ is the standard
+ * RSS hash (using the well-known default key), followed by a NIC-
+ * style indirection table. XOR folds the flow ID fields and takes
+ * the result modulo the core count; as such, it is trivially
+ * steerable (an adversary can pick flow IDs that land on any
+ * given core).
+ */
+enum class RSSHash { TOEPLITZ = 0, XOR };
+
+/**
+ * Returns the RSS hash corresponding to the given name ("toeplitz"
+ * or "xor"). @throw invalid argument if it is unknown.
+ */
+RSSHash parseRSSHash(const std::string& name);
+
+/**
+ * Returns the name of the given RSS hash.
+ */
+std::string toString(const RSSHash hash);
+
+/**
+ * Maps packets to cores by hashing their flow IDs (as with Receive
+ * Side Scaling on multi-queue NICs). Packets of the same flow are
+ * always dispatched to the same core.
+ */
+class RSSDispatcher final {
+public:
+    // Indirection table size (in entries)
+    static constexpr uint32_t kIndirectionTableSize = 128;
+
+private:
+    // Serialized flow ID size (in bytes)
+    static constexpr uint32_t kFlowIdBytes = 12;
+
+    uint32_t num_cores_ = 1; // Number of cores
+    RSSHash hash_ = RSSHash::TOEPLITZ; // Flow hash function
+    uint32_t indirection_table_[kIndirectionTableSize]; // Hash to core
+
+    // Toeplitz hash contribution of every (byte offset, value)
+    uint32_t toeplitz_table_[kFlowIdBytes][256];
+
+    // Internal helper methods
+    uint32_t hashToeplitz(const FlowId& flow_id) const;
+
+public:
+    explicit RSSDispatcher(const uint32_t num_cores=1,
+                           const RSSHash hash=RSSHash::TOEPLITZ);
+
+    // Accessors
+    RSSHash getHash() const { return hash_; }
+    uint32_t getNumCores() const { return num_cores_; }
+
+    /**
+     * Returns the core to dispatch the given flow to.
+     */
+    uint32_t getCore(const FlowId& flow_id) const {
+        if (num_cores_ == 1) { return 0; }
+        else if (hash_ == RSSHash::XOR) {
+            return ((flow_id.getSrcIP() ^ flow_id.getDstIP() ^
+                     ((static_cast<uint32_t>(flow_id.getSrcPort()) << 16) |
+                      flow_id.getDstPort())) % num_cores_);
+        }
+        return indirection_table_[hashToeplitz(flow_id) %
+                                  kIndirectionTableSize];
+    }
+};
+
+#endif // SIMULATOR_SERVER_RSS_DISPATCHER_H
@@ -5,9 +5,12 @@
 #include "packet/packet.h"
 
 // STD headers
+#include <algorithm>
 #include <assert.h>
+#include <stdexcept>
 
-Server::Server(Application* a, const BaseQueue* q) : app_(a) {
+Server::Server(Application* a, const BaseQueue* q, PacketArena* arena,
+               const std::vector<double>& speeds) : app_(a), arena_(arena) {
     // Ensure that the application's requirements
     // of per-flow packet ordering are respected.
     if (app_->isFlowOrderRequired() &&
@@ -16,39 +19,166 @@ Server::Server(Application* a, const BaseQueue* q) : app_(a) {
             "Policy " + q->type() + " does not guarantee per-flow " +
             "ordering (required by application " + app_->type() + ")");
     }
+    // Initialize the server pool. Note: With several servers fed
+    // from the same queue, packets of the same flow may be served
+    // concurrently (and depart out of order), so applications that
+    // require flow order must use a single server (per queue).
+    if (speeds.empty()) {
+        throw std::runtime_error("Must specify at least one server.");
+    }
+    else if (app_->isFlowOrderRequired() && (speeds.size() > 1)) {
+        throw std::runtime_error(
+            "Application " + app_->type() + " requires per-flow " +
+            "ordering, which a shared queue served by multiple " +
+            "servers does not guarantee (use a single server, or " +
+            "the partitioned topology)");
+    }
+    for (const double speed : speeds) {
+        if (!(speed > 0)) {
+            throw std::runtime_error("Server speeds must be positive.");
+        }
+        idle_.emplace(-speed, servers_.size());
+        servers_.emplace_back();
+        servers_.back().speed = speed;
+        total_speed_ += speed;
+    }
 }
 
-Server::~Server() { delete(app_); }
+/**
+ * Record packet departure.
+ */
+PacketHandle Server::recordDeparture() {
+    assert(!departures_.empty()); // Sanity check
+    const uint32_t idx = departures_.top().second;
+    departures_.pop();
+
+    // Mark the server as idle
+    ServerState& server = servers_[idx];
+    (*arena_)[server.packet].setDepartTime(server.depart_time);
+    idle_.emplace(-server.speed, idx);
+    server.is_busy = false;
+    return server.packet;
+}
 
 /**
- * Sets the actual & estimated job sizes for the given packet.
+ * Schedule a new packet.
  */
-void Server::setJobSizeEstimateAndActual(Packet& packet) {
-    packet.setJobSizeEstimate(app_->getJobSizeEstimate(packet));
-    packet.setJobSizeActual(app_->process(packet));
+void Server::schedule(const double time, const PacketHandle handle,
+                      const double overhead_ns) {
+    // Sanity checks
+    const Packet& packet = (*arena_)[handle];
+    assert(packet.getJobSizeEstimate() >= 0);
+    assert(!idle_.empty());
+    assert(packet.getJobSizeActual() != kInvalidJobSize);
+    const double jsize = packet.getRemainingJobSizeActual();
+
+    // Pick the fastest idle server
+    const uint32_t idx = idle_.top().second;
+    ServerState& server = servers_[idx];
+    assert(!server.is_busy && time >= server.depart_time);
+    idle_.pop();
+
+    // Update the server state
+    const double service_time = ((jsize / server.speed) + overhead_ns);
+    server.work_start_time = time + overhead_ns;
+    server.depart_time = time + service_time;
+    server.busy_time += service_time;
+    server.packet = handle;
+    server.is_busy = true;
+    departures_.emplace(server.depart_time, idx);
 }
 
 /**
- * Record packet departure.
+ * Record batch departure.
  */
-Packet Server::recordDeparture() {
-    packet_.setDepartTime(depart_time_);
-    is_busy_ = false;
-    return packet_;
+void Server::recordBatchDeparture(std::vector<PacketHandle>& departures) {
+    assert(!departures_.empty()); // Sanity check
+    const uint32_t idx = departures_.top().second;
+    departures_.pop();
+
+    // Mark the server as idle
+    ServerState& server = servers_[idx];
+    for (const PacketHandle handle : server.batch) {
+        (*arena_)[handle].setDepartTime(server.depart_time);
+        departures.push_back(handle);
+    }
+    server.batch.clear();
+    idle_.emplace(-server.speed, idx);
+    server.is_busy = false;
 }
 
 /**
- * Schedule a new packet.
+ * Schedule a new batch.
  */
-void Server::schedule(const double time, Packet packet) {
-    // Sanity checks
-    assert(packet.getJobSizeEstimate() >= 0);
-    assert(!is_busy_ && time >= depart_time_);
-    const double jsize = packet.getJobSizeActual();
-    assert(jsize != kInvalidJobSize); // Sanity check
-
-    // Update the current server state
-    depart_time_ = time + jsize;
-    packet_ = packet;
-    is_busy_ = true;
+void Server::scheduleBatch(const double time,
+                           const std::vector<PacketHandle>& batch,
+                           const double overhead_ns) {
+    assert(!batch.empty() && !idle_.empty()); // Sanity checks
+    double work = batch_cost_ns_;
+    for (const PacketHandle handle : batch) {
+        const Packet& packet = (*arena_)[handle];
+        assert(packet.getJobSizeActual() != kInvalidJobSize);
+        work += (packet.getRemainingJobSizeActual() + packet_cost_ns_);
+    }
+    // Pick the fastest idle server
+    const uint32_t idx = idle_.top().second;
+    ServerState& server = servers_[idx];
+    assert(!server.is_busy && time >= server.depart_time);
+    idle_.pop();
+
+    // Update the server state
+    const double service_time = ((work / server.speed) + overhead_ns);
+    server.work_start_time = time + overhead_ns;
+    server.depart_time = time + service_time;
+    server.busy_time += service_time;
+    server.packet = batch.front();
+    server.batch = batch;
+    server.is_busy = true;
+    departures_.emplace(server.depart_time, idx);
+}
+
+/**
+ * Preempt a packet in service.
+ */
+PacketHandle Server::preempt(const uint32_t idx, const double time) {
+    ServerState& server = servers_[idx];
+    assert(server.is_busy && time <= server.depart_time); // Sanity check
+
+    // Credit the work completed so far, and
+    // refund the remainder of the service time.
+    (*arena_)[server.packet].setAttainedService(getAttainedService(idx, time));
+    server.busy_time -= (server.depart_time - time);
+
+    // Remove the server from the departures heap. Note: The
+    // pool is typically small, so the heap is simply rebuilt.
+    MinHeap departures;
+    for (; !departures_.empty(); departures_.pop()) {
+        if (departures_.top().second != idx) { departures.push(departures_.top()); }
+    }
+    departures_.swap(departures);
+
+    // Mark the server as idle
+    server.depart_time = time;
+    idle_.emplace(-server.speed, idx);
+    server.is_busy = false;
+    return server.packet;
+}
+
+/**
+ * Resets the server state.
+ */
+void Server::reset() {
+    departures_ = MinHeap();
+    idle_ = MinHeap();
+    for (uint32_t idx = 0; idx < servers_.size(); idx++) {
+        ServerState& server = servers_[idx];
+        server.is_busy = false;
+        server.packet = 0;
+        server.batch.clear();
+        server.work_start_time = 0;
+        server.depart_time = 0;
+        server.busy_time = 0;
+        idle_.emplace(-server.speed, idx);
+    }
+    app_->reset();
 }
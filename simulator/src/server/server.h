@@ -3,48 +3,185 @@
 
 // Library headers
 #include "packet/packet.h"
+#include "packet/packet_arena.h"
 #include "queueing/base_queue.h"
 #include "applications/application.h"
 
+// STD headers
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
 /**
- * Represents a single, non-preemptive server.
+ * Represents a pool of k servers (i.e., a G/G/k system) fed from
+ * a single queue. Servers may be heterogeneous: server i processes
+ * work at a relative speed s_i, such that a job of (actual) size J
+ * occupies it for (J / s_i) ns. Packets are scheduled on the fastest
+ * idle server (ties are broken by server index). Jobs normally run
+ * to completion, but may be preempted, in which case the work done
+ * so far is credited to the packet (see Packet::getAttainedService),
+ * and only the remaining work is performed once it is rescheduled.
+ * Alternatively, servers may process packets in batches (as with DPDK
+ * bursts): a batch incurs a fixed per-batch cost, plus a per-packet
+ * cost for each of its packets (see setBatchCosts), and all of its
+ * packets depart together once the entire batch is processed.
+ *
+ * Note: The server does not take ownership of the application or
+ * packet arena.
  */
 class Server {
 private:
+    /**
+     * State of an individual server in the pool.
+     */
+    struct ServerState {
+        double speed = 1; // Relative processing speed
+        bool is_busy = false; // Server busy?
+        PacketHandle packet = 0; // Packet currently being served
+        std::vector<PacketHandle> batch; // Batch currently being served
+        double work_start_time = 0; // Start of work on the packet (i.e.,
+                                    // after any scheduling overhead)
+        double depart_time = 0; // Departure time for packet
+        double busy_time = 0; // Cumulative service time (ns)
+    };
+    // (Key, server index) min-heap
+    typedef std::pair<double, uint32_t> HeapEntry;
+    typedef std::priority_queue<HeapEntry, std::vector<HeapEntry>,
+                                std::greater<HeapEntry>> MinHeap;
+
     // Underlying application
     Application* app_ = nullptr;
+    PacketArena* arena_ = nullptr; // Packet storage
 
     // Housekeeping
-    bool is_busy_ = false; // Server busy?
-    Packet packet_; // Packet currently being served
-    double depart_time_ = 0; // Departure time for packet
+    double batch_cost_ns_ = 0; // Work per batch (ns)
+    double packet_cost_ns_ = 0; // Additional work per batched packet (ns)
+    double total_speed_ = 0; // Aggregate processing speed
+    std::vector<ServerState> servers_; // Per-server state
+    MinHeap departures_; // Busy servers, keyed by departure time
+    MinHeap idle_; // Idle servers, keyed by (negated) speed
 
 public:
-    explicit Server(Application* a, const BaseQueue* q);
-    ~Server();
+    explicit Server(Application* a, const BaseQueue* q, PacketArena* arena,
+                    const std::vector<double>& speeds={1});
 
     // Accessor methods
-    bool isBusy() const { return is_busy_; }
     Application* getApplication() const { return app_; }
-    double getDepartureTime() const { return depart_time_; }
+    double getTotalSpeed() const { return total_speed_; }
+    uint32_t getNumServers() const { return servers_.size(); }
+    bool hasIdleServer() const { return !idle_.empty(); }
+    bool hasBusyServer() const { return !departures_.empty(); }
+    double getSpeed(const uint32_t idx) const { return servers_[idx].speed; }
+    bool isBusy(const uint32_t idx) const { return servers_[idx].is_busy; }
+    PacketHandle getPacket(const uint32_t idx) const {
+        return servers_[idx].packet;
+    }
+
+    /**
+     * Returns the earliest departure time across all busy servers.
+     */
+    double getDepartureTime() const {
+        return departures_.empty() ? 0 : departures_.top().first;
+    }
+
+    /**
+     * Returns the time (in ns) that the idx'th server spent serving
+     * packets up to the given time, excluding the remaining service
+     * time of the packet (or batch) in service, if any.
+     */
+    double getBusyTime(const uint32_t idx, const double time) const {
+        const ServerState& server = servers_[idx];
+        return server.busy_time - (!server.is_busy ? 0 :
+            std::max(0.0, server.depart_time - time));
+    }
+
+    /**
+     * Returns the service (work, in ns) attained by the packet on the
+     * idx'th server as of the given time, i.e. the work credited to it
+     * by earlier preemptions, plus the work done since it was scheduled.
+     */
+    double getAttainedService(const uint32_t idx, const double time) const {
+        const ServerState& server = servers_[idx];
+        const Packet& packet = (*arena_)[server.packet];
+        const double work = std::max(0.0, time - server.work_start_time) * server.speed;
+        return std::min(packet.getJobSizeActual(),
+                        packet.getAttainedService() + work);
+    }
+
+    /**
+     * Returns the fraction of the given duration (in ns) that
+     * the idx'th server spent serving packets.
+     */
+    double getUtilization(const uint32_t idx, const double duration) const {
+        return (duration > 0) ? (servers_[idx].busy_time / duration) : 0;
+    }
 
     /**
      * Sets the estimated & actual job sizes for the parameterized packet.
      * Note: This method MUST be invoked on each packet before scheduling
      * it or inserting it into the packet queue. As a corollary, packets'
-     * job size fields must not be used prior to this invocation.
+     * job size fields must not be used prior to this invocation. If the
+     * concrete application type (App) is known, calls are devirtualized.
+     */
+    template<class App = Application>
+    void setJobSizeEstimateAndActual(Packet& packet) {
+        App* const app = static_cast<App*>(app_);
+        packet.setJobSizeEstimate(app->getJobSizeEstimate(packet));
+        packet.setJobSizeActual(app->process(packet));
+    }
+
+    /**
+     * Record the earliest packet departure. Returns the departing
+     * packet's handle (which the caller is responsible for releasing).
+     */
+    PacketHandle recordDeparture();
+
+    /**
+     * Schedule a new packet on an idle server. The server spends
+     * the given overhead (in ns, e.g. for a context switch) before
+     * performing the packet's (remaining) work.
+     */
+    void schedule(const double time, const PacketHandle handle,
+                  const double overhead_ns=0);
+
+    /**
+     * Sets the fixed work (in ns, on a unit-speed server) incurred
+     * by every batch, and by every packet in a batch, respectively.
+     */
+    void setBatchCosts(const double batch_ns, const double packet_ns) {
+        batch_cost_ns_ = batch_ns;
+        packet_cost_ns_ = packet_ns;
+    }
+
+    /**
+     * Record the earliest batch departure. Appends the departing
+     * packets' handles to the given vector (the caller is, again,
+     * responsible for releasing them).
+     */
+    void recordBatchDeparture(std::vector<PacketHandle>& departures);
+
+    /**
+     * Schedule a (non-empty) batch of packets on an idle server. As
+     * with schedule(), the server spends the given overhead before
+     * processing the batch; packets are processed in batch order.
      */
-    void setJobSizeEstimateAndActual(Packet& packet);
+    void scheduleBatch(const double time,
+                       const std::vector<PacketHandle>& batch,
+                       const double overhead_ns=0);
 
     /**
-     * Record packet departure.
+     * Preempts the packet being served on the idx'th server at the
+     * given time, crediting the work completed so far, and marks it
+     * as idle. Returns the preempted packet's handle.
      */
-    Packet recordDeparture();
+    PacketHandle preempt(const uint32_t idx, const double time);
 
     /**
-     * Schedule a new packet.
+     * Resets the server (and application) to the initial state.
      */
-    void schedule(const double time, Packet packet);
+    void reset();
 };
 
 #endif // SIMULATOR_SERVER_SERVER_H
@@ -2,29 +2,226 @@
 
 // Library headers
 #include "applications/application_factory.h"
+#include "chain_simulator.h"
+#include "common/histogram.h"
+#include "common/philox.h"
 #include "common/utils.h"
+#include "logging/packet_log_writer.h"
 #include "packet/packet.h"
 #include "queueing/fcfs_queue.h"
 #include "queueing/queue_factory.h"
 #include "server/server.h"
+#include "sweep.h"
 #include "traffic/synthetic_trafficgen.h"
-#include "traffic/trace_trafficgen.h"
 #include "traffic/trafficgen_factory.h"
 
 // STD headers
+#include <algorithm>
+#include <cmath>
 #include <exception>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <random>
+#include <typeinfo>
+#include <unordered_map>
 
 // Boost headers
 #include <boost/program_options.hpp>
 
+/**
+ * SimulationResults implementation.
+ */
+void SimulationResults::print(std::ostream& out) const {
+    out << "==========================================" << std::endl
+        << "            Simulation Results            " << std::endl
+        << "==========================================" << std::endl;
+
+    // Display performance metrics
+    out << std::fixed << std::setprecision(2);
+    if (!policy.empty()) { out << "Policy: " << policy << std::endl; }
+    out << "Maximum service rate: " << service_rate_gbps_i << " Gbps" << std::endl;
+    out << "Innocent packet rate: " << input_rate_gbps_i << " Gbps" << std::endl;
+    out << "Average packet size: " << average_psize_i << " bits" << std::endl;
+    out << "Maximum packet size: " << maximum_psize_i << " bits" << std::endl;
+    out << "Average job size: " << average_jsize_i << " ns" << std::endl;
+    out << "Maximum job size: " << maximum_jsize_i << " ns" << std::endl;
+    out << "Innocent arrivals: " << num_innocent_arrivals << std::endl;
+    out << "Total arrivals: " << num_arrivals << std::endl;
+    if ((num_drops_i != 0) || (num_drops_a != 0)) {
+        out << "Drops (innocent/attack): " << num_drops_i << " / "
+            << num_drops_a << std::endl;
+    }
+    if (num_preemptions != 0) {
+        out << "Preemptions: " << num_preemptions << std::endl;
+    }
+    if (average_batch_size != 1) {
+        out << "Average batch size: " << average_batch_size << std::endl;
+    }
+    out << "Server utilization:";
+    for (size_t idx = 0; idx < server_utilizations.size(); idx++) {
+        out << ((idx == 0) ? " " : ", ") << (server_utilizations[idx] * 100);
+    }
+    out << " %" << std::endl;
+    if (!scheduler_utilizations.empty()) {
+        out << "Scheduler utilization:";
+        for (size_t idx = 0; idx < scheduler_utilizations.size(); idx++) {
+            out << ((idx == 0) ? " " : ", ") << (scheduler_utilizations[idx] * 100);
+        }
+        out << " %" << std::endl;
+    }
+    if (core_goodputs_gbps.size() > 1) {
+        out << "Per-core goodput:";
+        for (size_t idx = 0; idx < core_goodputs_gbps.size(); idx++) {
+            out << ((idx == 0) ? " " : ", ") << core_goodputs_gbps[idx];
+        }
+        out << " Gbps" << std::endl;
+        out << "Core load imbalance: " << core_load_imbalance << std::endl;
+    }
+    out << std::endl;
+
+    out << "Innocent latency (p50/p99/p99.9): " << latency_p50_ns_i << " / "
+        << latency_p99_ns_i << " / " << latency_p999_ns_i << " ns" << std::endl;
+    if (num_arrivals != num_innocent_arrivals) {
+        out << "Attack latency (p50/p99/p99.9): " << latency_p50_ns_a << " / "
+            << latency_p99_ns_a << " / " << latency_p999_ns_a << " ns" << std::endl;
+    }
+    if (num_flows_i != 0) {
+        out << "Per-flow p99 latency (median/max across " << num_flows_i
+            << " flows): " << flow_p99_latency_p50_ns << " / "
+            << flow_p99_latency_max_ns << " ns" << std::endl;
+    }
+    out << std::endl;
+
+    out << std::fixed << std::setprecision(4);
+    out << "Average goodput: " << last_goodput_gbps << " Gbps" << std::endl;
+    out << "Steady-state goodput: " << ss_goodput_gbps << " Gbps" << std::endl;
+    out << "Steady-state displacement factor: " << ss_displacement_factor << std::endl;
+    out << "Batch-means goodput: " << bm_goodput_gbps << " +/- "
+        << bm_goodput_ci_gbps << " Gbps (95% CI)" << std::endl;
+    if (num_arrivals != num_innocent_arrivals) {
+        out << "Batch-means displacement factor: " << bm_displacement_factor
+            << " +/- " << bm_displacement_factor_ci << " (95% CI)" << std::endl;
+    }
+    out << "Steady-state batches: " << num_batches << " (warm-up: "
+        << num_warmup_batches << ")" << (is_converged ? ", converged" : "")
+        << std::endl;
+    out << std::endl;
+}
+
+/**
+ * Config helpers.
+ */
+std::vector<double> parseServerSpeeds(const libconfig::Setting& config) {
+    const bool has_count = config.exists("num_servers");
+    const bool has_speeds = config.exists("server_speeds");
+    if (has_count && has_speeds) {
+        throw std::runtime_error(
+            "Must specify at most one of 'num_servers' and 'server_speeds'.");
+    }
+    else if (has_speeds) {
+        const libconfig::Setting& speeds_config = config["server_speeds"];
+        std::vector<double> speeds;
+        for (int idx = 0; idx < speeds_config.getLength(); idx++) {
+            speeds.push_back(static_cast<double>(speeds_config[idx]));
+        }
+        return speeds;
+    }
+    else if (has_count) {
+        const int num_servers = config.lookup("num_servers");
+        if (num_servers <= 0) {
+            throw std::runtime_error("'num_servers' must be positive.");
+        }
+        return std::vector<double>(num_servers, 1);
+    }
+    return std::vector<double>(1, 1);
+}
+
+std::vector<const libconfig::Setting*>
+getConfigList(const libconfig::Setting& config) {
+    std::vector<const libconfig::Setting*> configs;
+    if (!config.isList()) { configs.push_back(&config); }
+    else {
+        for (int idx = 0; idx < config.getLength(); idx++) {
+            configs.push_back(&config[idx]);
+        }
+    }
+    return configs;
+}
+
+/**
+ * Metric helpers.
+ */
+double computeDisplacementFactor(const double input_rate_gbps_i,
+                                 const double goodput_gbps_i,
+                                 const double input_rate_gbps_a) {
+    if (input_rate_gbps_a == 0) { return 0; }
+
+    // Epsilon to avoid messing with log-scale plots
+    double displacement_factor = 1e-4;
+
+    // Thresholding to make DF less noisy for small attack input rates
+    const double goodput_loss = (input_rate_gbps_i - goodput_gbps_i);
+    if ((goodput_loss / input_rate_gbps_i) > 1e-2) {
+        displacement_factor = (goodput_loss / input_rate_gbps_a);
+    }
+    return displacement_factor;
+}
+
+/**
+ * Helper function. Returns whether all the given
+ * objects have the same (dynamic) type.
+ */
+template<class T>
+static bool isHomogeneous(const std::vector<T*>& objects) {
+    for (const T* object : objects) {
+        if (typeid(*object) != typeid(*objects[0])) { return false; }
+    }
+    return true;
+}
+
+/**
+ * Helper function. Returns whether the batch-means CIs on goodput
+ * and DF (after truncating the warm-up) are within the target width,
+ * relative to the point estimates. Note: Since DF can be arbitrarily
+ * close to zero, its CI width is relative to max(|DF|, 1).
+ */
+static bool isConverged(const BatchMeans& goodput, const BatchMeans&
+                        displacement_factor, const double target_width) {
+    const size_t warmup_length = std::max(
+        goodput.getWarmupLength(), displacement_factor.getWarmupLength());
+
+    const BatchMeans::Estimate g = goodput.getEstimate(warmup_length);
+    if (g.half_width > (target_width * g.mean)) { return false; }
+    if (displacement_factor.size() == 0) { return true; }
+
+    const BatchMeans::Estimate df = (
+        displacement_factor.getEstimate(warmup_length));
+    return (df.half_width <= (target_width * std::max(std::abs(df.mean), 1.0)));
+}
+
 /**
  * Simulator implementation.
  */
-Simulator::Simulator(const bool is_dry_run, const
-    libconfig::Setting& config) : kIsDryRun(is_dry_run) {
-    parseSimulationConfig(config); // Parse the simulation config
+Simulator::Simulator(const bool is_dry_run, const libconfig::Setting&
+    config, TraceCache* const trace_cache) : kIsDryRun(is_dry_run),
+    kOwnsComponents(true), kSeed(getRandomSeed()) {
+    // Parse the simulation config
+    parseSimulationConfig(config, trace_cache);
+    validateConfig();
+}
+
+Simulator::Simulator(const bool is_dry_run, const uint64_t max_num_arrivals,
+    BaseQueue* const queue, Application* const application, TrafficGenerator*
+    const tg_innocent, TrafficGenerator* const tg_attack, const std::vector<
+    double>& server_speeds) : kIsDryRun(is_dry_run), kOwnsComponents(false),
+    kMaxNumArrivals(max_num_arrivals), kSeed(getRandomSeed()), queues_(1, queue),
+    application_(application), tg_innocents_(1, tg_innocent),
+    tg_attacks_(1, tg_attack) {
+    arenas_.emplace_back(new PacketArena());
+    servers_.push_back(new Server(application_, queue, arenas_[0].get(),
+                                  server_speeds));
+    validateConfig();
 }
 
 void Simulator::printConfig() const {
@@ -33,22 +230,83 @@ void Simulator::printConfig() const {
               << "               Input Config               " << std::endl
               << "==========================================" << std::endl;
 
-    std::cout << "Policy: " << queue_->type() << ","
-              << std::endl << "Application: ";
-    server_->getApplication()->printConfiguration();
+    std::cout << "Seed: " << kSeed << std::endl;
+    std::cout << ((getNumPolicies() > 1) ? "Policies: " : "Policy: ");
+    for (uint32_t policy = 0; policy < getNumPolicies(); policy++) {
+        std::cout << ((policy == 0) ? "" : ", ") << queues_[policy *
+                     dispatcher_.getNumCores()]->type();
+    }
+    std::cout << "," << std::endl << "Application: ";
+    application_->printConfiguration();
+
+    // Display the server speeds (across all cores). Note: The
+    // servers are identical across policies.
+    std::vector<double> speeds;
+    for (uint32_t core = 0; core < dispatcher_.getNumCores(); core++) {
+        const Server* server = servers_[core];
+        for (uint32_t idx = 0; idx < server->getNumServers(); idx++) {
+            speeds.push_back(server->getSpeed(idx));
+        }
+    }
+    std::cout << std::endl << "Servers: " << speeds.size();
+    if (speeds.size() > 1) {
+        std::cout << " (speeds:";
+        for (size_t idx = 0; idx < speeds.size(); idx++) {
+            std::cout << ((idx == 0) ? " " : ", ") << speeds[idx];
+        }
+        std::cout << ")";
+    }
+    if (dispatcher_.getNumCores() > 1) {
+        std::cout << ", partitioned across " << dispatcher_.getNumCores()
+                  << " cores (" << toString(dispatcher_.getHash())
+                  << " hash)";
+    }
+    std::cout << std::endl;
 
-    std::cout << std::endl << "Innocent traffic-gen: ";
-    tg_innocent_->printConfiguration();
+    if (isQueueBounded()) {
+        std::cout << "Queue capacity:";
+        kQueueCapacity.print(std::cout);
+        std::cout << std::endl;
+    }
+    if (kIsPreemptive) {
+        std::cout << "Preemptive (context switch: " << kContextSwitchNs
+                  << " ns)" << std::endl;
+    }
+    if (kIsBatched) {
+        std::cout << "Batched (max size: " << kMaxBatchSize << ", timeout: "
+                  << kBatchTimeoutNs << " ns, cost: " << kBatchCostNs
+                  << " ns/batch + " << kPacketCostNs << " ns/packet)"
+                  << std::endl;
+    }
+    for (uint32_t policy = 0; policy < cost_models_.size(); policy++) {
+        const BaseQueue* queue = queues_[policy * dispatcher_.getNumCores()];
+        std::cout << "Scheduler cost";
+        if (cost_models_.size() > 1) { std::cout << " (" << queue->type() << ")"; }
+        std::cout << ": ";
+        cost_models_[policy]->printConfiguration();
+        std::cout << std::endl;
+    }
 
+    for (const TrafficGenerator* tg : tg_innocents_) {
+        std::cout << std::endl << "Innocent traffic-gen: ";
+        tg->printConfiguration();
+    }
     if (!kIsDryRun) {
-        std::cout << std::endl << "Attack traffic-gen: ";
-        tg_attack_->printConfiguration();
+        for (const TrafficGenerator* tg : tg_attacks_) {
+            std::cout << std::endl << "Attack traffic-gen: ";
+            tg->printConfiguration();
+        }
     }
     std::cout << std::endl;
 }
 
-void Simulator::
-parseSimulationConfig(const libconfig::Setting& config) {
+void Simulator::parseSimulationConfig(
+    const libconfig::Setting& config, TraceCache* const trace_cache) {
+    // NF chains are simulated separately (see ChainSimulator)
+    if (config.exists("chain")) {
+        throw std::runtime_error(
+            "NF chain configs must be simulated using ChainSimulator.");
+    }
     // Parse the maximum arrival count
     kMaxNumArrivals = std::numeric_limits<uint64_t>::max();
     if (config.exists("max_num_arrivals")) {
@@ -56,137 +314,687 @@ parseSimulationConfig(const libconfig::Setting& config) {
             long long>(config.lookup("max_num_arrivals"));
     }
 
-    // Generate the queue
-    if (kIsDryRun) {
+    // Track per-flow latency quantiles?
+    config.lookupValue("per_flow_latency", kIsPerFlowLatency);
+
+    // Parse the RNG seed (if any)
+    unsigned long long seed;
+    if (config.lookupValue("seed", seed)) { kSeed = seed; }
+
+    // Parse the steady-state batching parameters
+    config.lookupValue("batch_size", kBatchSize);
+    config.lookupValue("ci_width", kTargetCIWidth);
+    if (kBatchSize == 0) {
+        throw std::runtime_error("'batch_size' must be positive.");
+    }
+    if (kTargetCIWidth < 0) {
+        throw std::runtime_error("'ci_width' must be non-negative.");
+    }
+
+    // Parse the topology. In the partitioned topology, each
+    // server is a separate core (with its own queue).
+    const std::vector<double> speeds = parseServerSpeeds(config);
+    std::string topology = "shared";
+    config.lookupValue("topology", topology);
+    if (topology != "shared" && topology != "partitioned") {
+        throw std::runtime_error("Unknown topology: " + topology + ".");
+    }
+    const bool is_partitioned = (topology == "partitioned");
+    const uint32_t num_cores = is_partitioned ? speeds.size() : 1;
+
+    std::string rss_hash = "toeplitz";
+    config.lookupValue("rss_hash", rss_hash);
+    dispatcher_ = RSSDispatcher(num_cores, parseRSSHash(rss_hash));
+
+    // Parse the policies. In lockstep mode ('policies'), several
+    // policies are simulated at once: each policy is assigned its
+    // own set of cores (queues and servers), all of which are fed
+    // the same arrivals (generated, and sized, only once).
+    std::vector<std::string> policies;
+    if (config.exists("policies")) {
+        const libconfig::Setting& setting = config["policies"];
+        if (config.exists("policy")) {
+            throw std::runtime_error(
+                "Must specify at most one of 'policy' and 'policies'.");
+        }
+        for (int idx = 0; idx < setting.getLength(); idx++) {
+            policies.push_back(static_cast<const char*>(setting[idx]));
+        }
+        if (policies.empty()) {
+            throw std::runtime_error("'policies' must not be empty.");
+        }
+    }
+    else {
         std::string policy;
-        if (config.lookupValue("policy", policy) && policy != FCFSQueue::name()) {
+        if (config.lookupValue("policy", policy)) {
+            policies.push_back(policy);
+        }
+        else if (!kIsDryRun) {
+            throw std::runtime_error("Must specify 'policy' to use.");
+        }
+    }
+    if (kIsDryRun) {
+        if ((policies.size() > 1) || ((policies.size() == 1) &&
+                                      (policies[0] != FCFSQueue::name()))) {
             std::cout << "'policy' is specified in dry-run mode. "
                       << "Ignoring this and using FCFS instead."
                       << std::endl << std::endl;
         }
-        queue_ = new FCFSQueue();
+        policies.assign(1, FCFSQueue::name());
     }
-    else {
-        queue_ = QueueFactory::generate(config);
+    // Parse the queue capacity (if any), in packets and/or bytes,
+    // and the policy used to drop packets once a queue is full.
+    kQueueCapacity = parseQueueCapacity(config);
+
+    // Parse the preemption parameters
+    config.lookupValue("preemptive", kIsPreemptive);
+    config.lookupValue("context_switch_ns", kContextSwitchNs);
+    if (kContextSwitchNs < 0) {
+        throw std::runtime_error("'context_switch_ns' must be non-negative.");
+    }
+
+    // Parse the batching parameters (if any)
+    if (config.exists("batching")) {
+        const libconfig::Setting& batching = config["batching"];
+        kIsBatched = true;
+        batching.lookupValue("max_batch_size", kMaxBatchSize);
+        batching.lookupValue("timeout_ns", kBatchTimeoutNs);
+        batching.lookupValue("batch_cost_ns", kBatchCostNs);
+        batching.lookupValue("packet_cost_ns", kPacketCostNs);
+
+        if (kMaxBatchSize == 0) {
+            throw std::runtime_error("'max_batch_size' must be positive.");
+        }
+        if ((kBatchTimeoutNs < 0) || (kBatchCostNs < 0) || (kPacketCostNs < 0)) {
+            throw std::runtime_error(
+                "Batch timeout and costs must be non-negative.");
+        }
+        if (kIsPreemptive) {
+            throw std::runtime_error(
+                "Preemption is not supported with batching.");
+        }
     }
 
-    // Generate the application and server
-    Application* application = nullptr;
+    // Generate the queues. Note: Drop-max evicts packets from
+    // the back of the queue, so it requires double-ended queues.
+    for (const std::string& policy : policies) {
+        for (uint32_t core = 0; core < num_cores; core++) {
+            queues_.push_back(QueueFactory::generate(policy));
+            queues_.back()->setDoubleEnded(isQueueBounded() &&
+                                           (kQueueCapacity.drop_policy ==
+                                            DropPolicy::MAX));
+
+            if (kIsPreemptive && !queues_.back()->isPreemptionSupported()) {
+                throw std::runtime_error(
+                    "Policy " + policy + " does not support preemption.");
+            }
+        }
+    }
+
+    // Parse the scheduler cost model(s), if any: either a single
+    // model (shared by all policies), or one model per policy.
+    if (config.exists("scheduler_cost")) {
+        const std::vector<const libconfig::Setting*> cost_configs = (
+            getConfigList(config["scheduler_cost"]));
+
+        if ((cost_configs.size() != 1) &&
+            (cost_configs.size() != policies.size())) {
+            throw std::runtime_error("'scheduler_cost' must specify either "
+                                     "one model, or one per policy.");
+        }
+        for (size_t policy = 0; policy < policies.size(); policy++) {
+            cost_models_.emplace_back(QueueCostModel::generate(*cost_configs[
+                std::min(policy, cost_configs.size() - 1)]));
+        }
+    }
+
+    // Generate the application and servers
     if (!config.exists("application")) {
         throw std::runtime_error("Must specify 'application'.");
     }
     else {
-        application = ApplicationFactory::generate(config["application"]);
+        application_ = ApplicationFactory::generate(config["application"]);
+    }
+    // Note: Every policy stores its packets in a separate arena
+    // (for locality), shared by its cores.
+    for (size_t policy = 0; policy < policies.size(); policy++) {
+        arenas_.emplace_back(new PacketArena());
+    }
+    for (uint32_t idx = 0; idx < queues_.size(); idx++) {
+        const uint32_t core = (idx % num_cores);
+        servers_.push_back(new Server(application_, queues_[idx],
+            arenas_[idx / num_cores].get(), is_partitioned ?
+            std::vector<double>(1, speeds[core]) : speeds));
+        servers_.back()->setBatchCosts(kBatchCostNs, kPacketCostNs);
     }
-    server_ = new Server(application, queue_);
 
-    // Generate the innocent traffic-gen
+    // Generate the innocent traffic-gens. Note: Synthetic
+    // traffic-gens are assigned disjoint ranges of flow IDs.
+    uint32_t fid_offset = 0;
     if (!config.exists("innocent_traffic")) {
         throw std::runtime_error("Must specify 'innocent_traffic'.");
     }
-    else {
-        tg_innocent_ = TrafficGeneratorFactory::generate(kIsDryRun,
-            TrafficClass::INNOCENT, config["innocent_traffic"]);
+    for (const libconfig::Setting* tg_config :
+         getConfigList(config["innocent_traffic"])) {
+        tg_innocents_.push_back(TrafficGeneratorFactory::generate(kIsDryRun,
+            TrafficClass::INNOCENT, *tg_config, fid_offset, trace_cache));
+
+        fid_offset += tg_innocents_.back()->getNumFlows();
     }
-    // Generate the attack traffic-gen
+    // Generate the attack traffic-gens
     if (!config.exists("attack_traffic")) {
         AttackTrafficGenerator* tg_attack = new AttackTrafficGenerator(
             0, 0, new ConstantDistribution(kDblPosInfty), 0, kInvalidJobSize);
 
         tg_attack->calibrate(0);
-        tg_attack_ = tg_attack;
+        tg_attacks_.push_back(tg_attack);
     }
     else {
-        tg_attack_ = TrafficGeneratorFactory::generate(kIsDryRun,
-            TrafficClass::ATTACK, config["attack_traffic"],
-            tg_innocent_->getNumFlows());
+        for (const libconfig::Setting* tg_config :
+             getConfigList(config["attack_traffic"])) {
+            tg_attacks_.push_back(TrafficGeneratorFactory::generate(kIsDryRun,
+                TrafficClass::ATTACK, *tg_config, fid_offset));
+
+            fid_offset += tg_attacks_.back()->getNumFlows();
+        }
+    }
+    if (tg_innocents_.empty() || tg_attacks_.empty()) {
+        throw std::runtime_error("Traffic lists must not be empty.");
     }
+}
+
+void Simulator::validateConfig() const {
     // Maximum arrival count should be set iff not using a trace
-    bool is_use_trace = (tg_innocent_->type() ==
-                         TraceTrafficGenerator::name());
+    validateMaxNumArrivals(kMaxNumArrivals, tg_innocents_);
+}
 
-    bool is_max_arrival_count_set = (kMaxNumArrivals !=
-                                     std::numeric_limits<uint64_t>::max());
+Simulator::~Simulator() {
+    // Deallocate resources
+    for (Server* server : servers_) { delete(server); }
+    if (kOwnsComponents) {
+        for (TrafficGenerator* tg : tg_innocents_) { delete(tg); }
+        for (TrafficGenerator* tg : tg_attacks_) { delete(tg); }
+        delete(application_);
+        for (BaseQueue* queue : queues_) { delete(queue); }
+    }
+}
 
-    if (!(is_max_arrival_count_set ^ is_use_trace)) {
-        throw std::runtime_error(
-            "'max_num_arrivals' must be set iff not using a trace.");
+void Simulator::addTimer(const double period_ns,
+                         const std::function<void(const double)> callback) {
+    if (!(period_ns > 0)) {
+        throw std::runtime_error("Timer period must be positive.");
     }
+    timers_.push_back(Timer{period_ns, callback});
 }
 
-Simulator::~Simulator() {
-    // Deallocate resources
-    delete(tg_innocent_);
-    delete(tg_attack_);
-    delete(server_);
-    delete(queue_);
+void Simulator::setTimeSeries(const std::string& fp, const double interval_ns) {
+    if (!(interval_ns > 0)) {
+        throw std::runtime_error("Time-series interval must be positive.");
+    }
+    timeseries_.reset(new TimeSeriesWriter(fp));
+    kTimeSeriesIntervalNs = interval_ns;
+}
+
+uint64_t Simulator::getRandomSeed() {
+    std::random_device rd;
+    return ((static_cast<uint64_t>(rd()) << 32) | rd());
 }
 
-void Simulator::run(const bool verbose, const std::string packets_fp) {
-    assert(!done); // TODO(natre): Make simulator instances reusable
-    std::ofstream packets_of(packets_fp, std::ios::trunc);
-    std::vector<Packet> packets; // Packet output
+void Simulator::reset() {
+    // Note: Since the queues may be shared with other simulator
+    // instances, (re-)attach them to this simulator's arenas.
+    const uint32_t num_cores = dispatcher_.getNumCores();
+    for (const std::unique_ptr<PacketArena>& arena : arenas_) { arena->reset(); }
+    for (uint32_t idx = 0; idx < queues_.size(); idx++) {
+        queues_[idx]->setPacketArena(arenas_[idx / num_cores].get());
+        queues_[idx]->reset();
+    }
+    for (Server* server : servers_) { server->reset(); }
+    for (TrafficGenerator* tg : tg_innocents_) { tg->reset(); }
+    for (TrafficGenerator* tg : tg_attacks_) { tg->reset(); }
 
-    // Print configuration
-    printConfig();
+    // Seed the RNG streams. Every component is assigned a fixed
+    // stream ID (by role), so the streams are independent across
+    // components and runs, but common across policies.
+    const uint64_t seed = deriveSeed(kSeed, num_runs_);
+    application_->seed(deriveSeed(seed, kApplicationStream));
+    for (uint32_t idx = 0; idx < tg_innocents_.size(); idx++) {
+        tg_innocents_[idx]->seed(deriveSeed(seed, kInnocentStreamsStart + idx));
+    }
+    for (uint32_t idx = 0; idx < tg_attacks_.size(); idx++) {
+        tg_attacks_[idx]->seed(deriveSeed(seed, kAttackStreamsStart + idx));
+    }
+}
+
+template<class Queue, class App, class InnocentTG, class AttackTG>
+std::vector<SimulationResults>
+Simulator::runImpl(PacketLogWriter* const packets_log) {
+    // Concrete component types. Note: The queues (and servers) of
+    // the p'th policy are at indices [p * num_cores, (p + 1) * num_cores).
+    const uint32_t num_cores = dispatcher_.getNumCores();
+    const uint32_t num_queues = queues_.size();
+    const uint32_t num_policies = (num_queues / num_cores);
+    std::vector<Queue*> queues(num_queues);
+    std::vector<uint32_t> queue_policies(num_queues); // Queue -> policy
+    for (uint32_t idx = 0; idx < num_queues; idx++) {
+        queues[idx] = static_cast<Queue*>(queues_[idx]);
+        queue_policies[idx] = (idx / num_cores);
+    }
+    std::vector<InnocentTG*> tg_innocents;
+    for (TrafficGenerator* tg : tg_innocents_) {
+        tg_innocents.push_back(static_cast<InnocentTG*>(tg));
+    }
+    std::vector<AttackTG*> tg_attacks;
+    for (TrafficGenerator* tg : tg_attacks_) {
+        tg_attacks.push_back(static_cast<AttackTG*>(tg));
+    }
+    // Event IDs. Note: Simultaneous events are processed in ID
+    // order, so departures precede batch deadlines (if batched),
+    // which precede arrivals, innocent arrivals precede attack
+    // arrivals, and timers (then, time-series samples) fire last.
+    const uint32_t kDeadlineEventsStart = num_queues;
+    const uint32_t kInnocentEventsStart = (kDeadlineEventsStart +
+                                           (kIsBatched ? num_queues : 0));
+    const uint32_t kAttackEventsStart = (kInnocentEventsStart +
+                                         tg_innocents.size());
+    const uint32_t kTimerEventsStart = (kAttackEventsStart +
+                                        tg_attacks.size());
+    const uint32_t kSampleEvent = (kTimerEventsStart + timers_.size());
+    calendar_.reset(kSampleEvent + 1);
 
     // Housekeeping
     uint64_t num_arrivals = 0; // Total number of arrivals
-    uint64_t num_departures = 0; // Total number of departures
+    uint64_t num_departures = 0; // Total number of departures (all policies)
+    uint64_t num_drops = 0; // Total number of drops (all policies)
     uint64_t num_innocent_arrivals = 0; // Number of innocent arrivals
 
-    // Profiling
+    // Profiling (arrivals)
+    double steady_state_ns = 0;     // Steady-state simulation period
+    std::vector<double> core_jsize(num_cores, 0); // Per-core offered load
     uint64_t total_psize_i = 0;     // Cumulative packet size (class I traffic)
+    uint64_t total_psize_a = 0;     // Cumulative packet size (class A traffic)
     double total_jsize_i = 0;       // Cumulative job size (class I traffic)
     uint32_t maximum_psize_i = 0;   // Maximum packet size (class I traffic)
     double maximum_jsize_i = 0;     // Maximum job size (class I traffic)
     double last_arrive_time_i = 0;  // End arrival time (class I traffic)
-    double last_depart_time_i = 0;  // End depart time (class I traffic)
-    uint64_t ss_total_psize_i = 0;  // Cumulative packet size of class I
-                                    // traffic served in steady-state.
-    double steady_state_ns = 0;     // Steady-state simulation period
+
+    // Queue capacities, if bounded
+    const bool is_queue_bounded = isQueueBounded();
+    std::vector<uint64_t> queue_psizes(num_queues, 0); // Queued packet size
+
+    // Time-series output (if any). Note: Queued packet sizes are
+    // also tracked for unbounded queues in this case.
+    TimeSeriesWriter* const timeseries = timeseries_.get();
+    const bool is_queue_psize_tracked = (is_queue_bounded ||
+                                         (timeseries != nullptr));
+
+    // Per-core schedulers (if queue operations are costed)
+    const bool is_scheduler_costed = !cost_models_.empty();
+    std::vector<double> scheduler_free_times(num_queues, 0); // Next idle time
+    std::vector<double> scheduler_busy_times(num_queues, 0); // Busy time (ns)
+
+    // Batch formation deadlines (if batched)
+    std::vector<double> batch_deadlines(num_queues, kDblPosInfty);
+    std::vector<PacketHandle> batch; // Batch being formed
+    std::vector<PacketHandle> departures; // Departing packets
+
+    /**
+     * Profiling (departures) for an individual policy.
+     */
+    struct PolicyProfile {
+        uint64_t total_psize_i = 0;     // Cumulative packet size (class I traffic)
+        uint64_t total_psize_a = 0;     // Cumulative packet size (class A traffic)
+        double last_depart_time_i = 0;  // End depart time (class I traffic)
+        double last_depart_time = 0;    // End depart time (all traffic)
+        uint64_t ss_total_psize_i = 0;  // Cumulative packet size of class I
+                                        // traffic served in steady-state.
+        std::vector<uint64_t> core_psize_i; // Per-core cumulative packet
+                                            // size served.
+        std::vector<double> core_last_depart_time_i; // Per-core end
+                                                     // depart time.
+        // Latency (sojourn time) sketches
+        LogLinearHistogram latency_i, latency_a; // Per-class latencies
+        std::unordered_map<FlowId, LogLinearHistogram, HashFlowId,
+                           EqualToFlowId> flow_latencies_i; // Per-flow (class I)
+
+        // Steady-state batches
+        BatchMeans bm_goodput, bm_displacement_factor; // Per-batch samples
+        uint64_t batch_psize_out_i = 0; // Packet size served in this batch
+
+        // Drops (bounded queues only)
+        uint64_t num_drops_i = 0, num_drops_a = 0; // Per-class drop counts
+        uint64_t num_preemptions = 0; // Preemption count
+        uint64_t num_service_batches = 0; // Batches served (if batched)
+        uint64_t num_batched_packets = 0; // Packets served in batches
+    };
+    std::vector<PolicyProfile> profiles(num_policies);
+    for (PolicyProfile& profile : profiles) {
+        profile.core_psize_i.assign(num_cores, 0);
+        profile.core_last_depart_time_i.assign(num_cores, 0);
+    }
+
+    // Steady-state batches. Every kBatchSize innocent arrivals, the
+    // innocent goodput (and DF) over the preceding batch is recorded.
+    double input_rate_gbps_a = 0; // Input rate (class A traffic)
+    for (const AttackTG* tg_attack : tg_attacks) {
+        input_rate_gbps_a += (tg_attack->getCalibratedRateInBitsPerSecond() /
+                              kBitsPerGb);
+    }
+    uint64_t batch_psize_in_i = 0;  // Packet size arrived in this batch
+    uint32_t batch_num_arrivals = 0; // Innocent arrivals in this batch
+    double batch_start_time = 0;    // Start time of this batch
+    uint64_t next_convergence_check = kMinNumBatches;
+    bool is_converged = false;
+
+    // Schedule the initial arrivals and timer expirations
+    uint32_t num_active_innocents = 0; // Innocent traffic-gens with arrivals
+    for (uint32_t idx = 0; idx < tg_innocents.size(); idx++) {
+        if (tg_innocents[idx]->hasNewArrival()) {
+            calendar_.schedule(kInnocentEventsStart + idx,
+                               tg_innocents[idx]->getNextArrivalTime());
+            num_active_innocents++;
+        }
+    }
+    for (uint32_t idx = 0; idx < tg_attacks.size(); idx++) {
+        calendar_.schedule(kAttackEventsStart + idx,
+                           tg_attacks[idx]->getNextArrivalTime());
+    }
+    for (uint32_t idx = 0; idx < timers_.size(); idx++) {
+        calendar_.schedule(kTimerEventsStart + idx, timers_[idx].period_ns);
+    }
+    if (timeseries != nullptr) {
+        calendar_.schedule(kSampleEvent, kTimeSeriesIntervalNs);
+    }
 
     // More innocent arrivals possible?
     bool more_arrivals = (
-        tg_innocent_->hasNewArrival() &&
+        (num_active_innocents > 0) &&
         (num_innocent_arrivals < kMaxNumArrivals));
 
-    while (more_arrivals || (num_arrivals != num_departures)) {
-        // Fetch the arrival and departure times
+    // Helper function. Drops the given packet (of the given policy).
+    auto drop = [&](const uint32_t policy, const PacketHandle handle) {
+        PacketArena& arena = *arenas_[policy];
+        if (arena[handle].getClass() == TrafficClass::INNOCENT) {
+            profiles[policy].num_drops_i++;
+        }
+        else { profiles[policy].num_drops_a++; }
+        arena.release(handle);
+        num_drops++;
+    };
+
+    // Helper function. Charges an enqueue (or dequeue) operation on
+    // the given queue to its scheduler at the given time, returning
+    // the delay (relative to time) until the operation completes.
+    auto chargeQueueOp = [&](const uint32_t idx, const double time,
+                             const bool is_enqueue) {
+        if (!is_scheduler_costed) { return 0.0; }
+        const QueueCostModel& model = *cost_models_[queue_policies[idx]];
+        const size_t size = queues[idx]->size();
+        const double cost = is_enqueue ? model.getEnqueueCost(size) :
+                                         model.getDequeueCost(size);
+
+        const double start = std::max(time, scheduler_free_times[idx]);
+        scheduler_free_times[idx] = (start + cost);
+        scheduler_busy_times[idx] += cost;
+        return (scheduler_free_times[idx] - time);
+    };
+
+    // Helper function. Forms batches from the given queue for its
+    // idle servers (if batched). A batch is dispatched once it is
+    // full, or once its formation deadline (timeout_ns after the
+    // first packet starts waiting for an idle server) expires.
+    auto formBatches = [&](const uint32_t idx, const double time) {
+        Server* const server = servers_[idx];
+        Queue* const queue = queues[idx];
+        const uint32_t policy = queue_policies[idx];
+        const uint32_t deadline_event = (kDeadlineEventsStart + idx);
+        double& deadline = batch_deadlines[idx];
+
+        while (server->hasIdleServer() && !queue->empty()) {
+            if (queue->size() < kMaxBatchSize) {
+                if (deadline == kDblPosInfty) {
+                    deadline = (time + kBatchTimeoutNs);
+                    calendar_.schedule(deadline_event, deadline);
+                }
+                if (time < deadline) { break; }
+            }
+            // Take the top packets of the queue. The server
+            // waits for the last dequeue to complete.
+            double delay = 0;
+            batch.clear();
+            while (!queue->empty() && (batch.size() < kMaxBatchSize)) {
+                delay = chargeQueueOp(idx, time, false);
+                const PacketHandle handle = queue->pop();
+                if (is_queue_psize_tracked) {
+                    queue_psizes[idx] -= (
+                        (*arenas_[policy])[handle].getPacketSize());
+                }
+                batch.push_back(handle);
+            }
+            server->scheduleBatch(time, batch, delay);
+            profiles[policy].num_service_batches++;
+            profiles[policy].num_batched_packets += batch.size();
+
+            deadline = kDblPosInfty;
+            calendar_.cancel(deadline_event);
+        }
+        if (queue->empty() && (deadline != kDblPosInfty)) {
+            deadline = kDblPosInfty;
+            calendar_.cancel(deadline_event);
+        }
+        if (server->hasBusyServer()) {
+            calendar_.schedule(idx, server->getDepartureTime());
+        }
+        else { calendar_.cancel(idx); }
+    };
+
+    // Helper function. Writes a time-series sample for every policy,
+    // covering the window since the previous sample. Note: This only
+    // reads cumulative counters, and is invoked once per interval.
+    struct SampleState {
+        uint64_t total_psize_i = 0, total_psize_a = 0; // Output (bits)
+        uint64_t num_drops_i = 0, num_drops_a = 0; // Drop counts
+        double busy_time = 0; // Aggregate server busy time (ns)
+    };
+    std::vector<SampleState> sample_states(num_policies);
+    uint64_t sample_psize_i = 0, sample_psize_a = 0; // Input (bits)
+    double sample_time = 0; // Start of the current window
+    auto sample = [&](const double time) {
+        const double duration = (time - sample_time);
+        for (uint32_t policy = 0; policy < num_policies; policy++) {
+            const PolicyProfile& profile = profiles[policy];
+            SampleState& state = sample_states[policy];
+
+            TimeSeriesSample sample;
+            sample.run = num_runs_;
+            sample.time_ns = time;
+            sample.policy = queues_[policy * num_cores]->type();
+            sample.input_gbps_i = (total_psize_i - sample_psize_i) / duration;
+            sample.input_gbps_a = (total_psize_a - sample_psize_a) / duration;
+            sample.goodput_gbps_i = (profile.total_psize_i -
+                                     state.total_psize_i) / duration;
+            sample.goodput_gbps_a = (profile.total_psize_a -
+                                     state.total_psize_a) / duration;
+            sample.num_drops_i = (profile.num_drops_i - state.num_drops_i);
+            sample.num_drops_a = (profile.num_drops_a - state.num_drops_a);
+
+            // Aggregate the queue and server state across cores
+            double busy_time = 0;
+            uint32_t num_servers = 0;
+            for (uint32_t core = 0; core < num_cores; core++) {
+                const uint32_t idx = (policy * num_cores) + core;
+                sample.queue_packets += queues[idx]->size();
+                sample.queue_bytes += (queue_psizes[idx] / 8);
+
+                const Server* server = servers_[idx];
+                for (uint32_t s = 0; s < server->getNumServers(); s++) {
+                    busy_time += server->getBusyTime(s, time);
+                }
+                num_servers += server->getNumServers();
+            }
+            sample.utilization = ((busy_time - state.busy_time) /
+                                  (duration * num_servers));
+            timeseries->write(sample);
+
+            state.total_psize_i = profile.total_psize_i;
+            state.total_psize_a = profile.total_psize_a;
+            state.num_drops_i = profile.num_drops_i;
+            state.num_drops_a = profile.num_drops_a;
+            state.busy_time = busy_time;
+        }
+        sample_psize_i = total_psize_i;
+        sample_psize_a = total_psize_a;
+        sample_time = time;
+    };
+
+    profiler_.start();
+    while (more_arrivals || ((num_departures + num_drops) !=
+                             (num_arrivals * num_policies))) {
+        // Fetch the next event
         bool is_steady_state = more_arrivals;
-        double at_attack = tg_attack_->getNextArrivalTime();
-        double at_innocent = tg_innocent_->getNextArrivalTime();
-        double next_departure_time = server_->getDepartureTime();
-        double next_arrival_time = std::min(at_attack, at_innocent);
+        const uint32_t event = calendar_.getNextId();
+        const double event_time = calendar_.getNextTime();
 
+        // Fire a timer
+        if (event >= kTimerEventsStart) {
+            profiler_.recordEvent(Profiler::TIMER);
+            if (event == kSampleEvent) {
+                sample(event_time);
+                calendar_.schedule(event, event_time + kTimeSeriesIntervalNs);
+            }
+            else {
+                const Timer& timer = timers_[event - kTimerEventsStart];
+                timer.callback(event_time);
+                calendar_.schedule(event, event_time + timer.period_ns);
+            }
+        }
         // Simulate an arrival
-        if (more_arrivals && ((next_arrival_time < next_departure_time) ||
-                              !server_->isBusy())) {
-            // Next arrival
-            TrafficGenerator* tg = (
-                (at_attack < at_innocent) ? tg_attack_ : tg_innocent_);
+        else if (event >= kInnocentEventsStart) {
+            // Next arrival. Note: The traffic-gens are of different
+            // types, so they are invoked separately (not via a base
+            // pointer) to keep the calls devirtualized.
+            const bool is_attack_arrival = (event >= kAttackEventsStart);
+            const double next_arrival_time = event_time;
+            profiler_.recordEvent(Profiler::ARRIVAL);
+            InnocentTG* const tg_innocent = is_attack_arrival ? nullptr :
+                tg_innocents[event - kInnocentEventsStart];
+
+            AttackTG* const tg_attack = !is_attack_arrival ? nullptr :
+                tg_attacks[event - kAttackEventsStart];
 
             // Fetch the arrival and compute its estimated job size
-            Packet arrival = tg->getNextArrival(num_arrivals);
-            server_->setJobSizeEstimateAndActual(arrival);
+            Packet arrival = [&]() {
+                Profiler::ScopedTimer timer(profiler_,
+                                            Profiler::TRAFFIC_GENERATION);
+                return is_attack_arrival ?
+                    tg_attack->getNextArrival(num_arrivals) :
+                    tg_innocent->getNextArrival(num_arrivals);
+            }();
+
+            // Note: The application is shared across all cores (and
+            // policies), so job sizes are computed once per arrival.
+            {
+                Profiler::ScopedTimer timer(profiler_, Profiler::APPLICATION);
+                servers_[0]->setJobSizeEstimateAndActual<App>(arrival);
+            }
 
             // Process jobs with valid job sizes
             if (arrival.getJobSizeActual() != kInvalidJobSize) {
-                tg->updateArrivalTime();
+                if (is_attack_arrival) { tg_attack->updateArrivalTime(); }
+                else { tg_innocent->updateArrivalTime(); }
 
                 // If the estimated jsize is invalid, reset it to zero
                 if (arrival.getJobSizeEstimate() == kInvalidJobSize) {
                     arrival.setJobSizeEstimate(0);
                 }
 
-                // If the server is currently unoccupied,
-                // schedule the next arrival immediately.
-                if (!server_->isBusy()) {
-                    assert(queue_->empty());
-                    server_->schedule(next_arrival_time, arrival);
+                // Dispatch the arrival to a core
+                const uint32_t core = dispatcher_.getCore(arrival.getFlowId());
+                core_jsize[core] += arrival.getJobSizeActual();
+
+                // Fan the arrival out to the core of every policy. Each
+                // policy serves its own copy of the packet (stored in
+                // the arena). If one of the core's servers is unoccupied,
+                // schedule the arrival immediately; else, insert it into
+                // the core's queue.
+                Profiler::ScopedTimer timer(profiler_, Profiler::SCHEDULING);
+                for (uint32_t policy = 0, idx = core; policy < num_policies;
+                     policy++, idx += num_cores) {
+                    PacketHandle handle = arenas_[policy]->allocate(arrival);
+                    Server* const server = servers_[idx];
+                    if (server->hasIdleServer() && !kIsBatched) {
+                        assert(queues[idx]->empty());
+                        chargeQueueOp(idx, next_arrival_time, true);
+                        server->schedule(next_arrival_time, handle, chargeQueueOp(
+                            idx, next_arrival_time, false));
+
+                        calendar_.schedule(idx, server->getDepartureTime());
+                        continue;
+                    }
+                    // If preemptive, and the arrival takes priority over
+                    // the lowest-priority job in service, preempt it. The
+                    // preempted packet is then queued instead. Jobs in
+                    // service are ranked by their current remaining work.
+                    if (kIsPreemptive) {
+                        uint32_t victim = 0;
+                        double victim_attained = server->getAttainedService(
+                            0, next_arrival_time);
+
+                        for (uint32_t s = 1; s < server->getNumServers(); s++) {
+                            const double attained = server->getAttainedService(
+                                s, next_arrival_time);
+
+                            if (queues[idx]->isBefore(
+                                    server->getPacket(victim), victim_attained,
+                                    server->getPacket(s), attained)) {
+                                victim = s;
+                                victim_attained = attained;
+                            }
+                        }
+                        const double attained = (*arenas_[policy])[
+                            handle].getAttainedService();
+
+                        if (queues[idx]->isBefore(
+                                handle, attained, server->getPacket(victim),
+                                victim_attained)) {
+                            const PacketHandle preempted = server->preempt(
+                                victim, next_arrival_time);
+
+                            chargeQueueOp(idx, next_arrival_time, true);
+                            server->schedule(next_arrival_time, handle,
+                                kContextSwitchNs + chargeQueueOp(
+                                    idx, next_arrival_time, false));
+                            calendar_.schedule(idx, server->getDepartureTime());
+                            profiles[policy].num_preemptions++;
+                            handle = preempted;
+                        }
+                    }
+                    if (!is_queue_bounded) {
+                        chargeQueueOp(idx, next_arrival_time, true);
+                        queues[idx]->push(handle);
+                        if (is_queue_psize_tracked) {
+                            queue_psizes[idx] += (
+                                (*arenas_[policy])[handle].getPacketSize());
+                        }
+                    }
+                    // If the queue is bounded, admit the packet, dropping
+                    // packets (per the drop policy) until the queue fits.
+                    else {
+                        admitPacket(*queues[idx], *arenas_[policy], handle,
+                            kQueueCapacity, queue_psizes[idx],
+                            [&](const PacketHandle victim) {
+                                drop(policy, victim);
+                            },
+                            [&](const bool is_enqueue) {
+                                chargeQueueOp(idx, next_arrival_time,
+                                              is_enqueue);
+                            });
+                    }
+                    // If batched, the arrival may complete a batch
+                    if (kIsBatched) { formBatches(idx, next_arrival_time); }
+                    profiler_.recordQueueSize(queues[idx]->size());
                 }
-                // Else, insert it into the queue
-                else { queue_->push(arrival); }
+                timer.stop();
 
                 // Update the steady-state timestamp
                 steady_state_ns = next_arrival_time;
@@ -195,116 +1003,376 @@ void Simulator::run(const bool verbose, const std::string packets_fp) {
                 bool is_innocent = (arrival.getClass() ==
                                     TrafficClass::INNOCENT);
 
-                if (is_innocent) { num_innocent_arrivals++; }
+                if (is_innocent) {
+                    total_psize_i += arrival.getPacketSize();
+                    total_jsize_i += arrival.getJobSizeActual();
+                    maximum_psize_i = std::max(maximum_psize_i,
+                                               arrival.getPacketSize());
+                    maximum_jsize_i = std::max(maximum_jsize_i,
+                                               arrival.getJobSizeActual());
+                    last_arrive_time_i = next_arrival_time;
+                    num_innocent_arrivals++;
+                }
+                else { total_psize_a += arrival.getPacketSize(); }
                 num_arrivals++;
+
+                // Close the steady-state batch, if required
+                if (is_innocent) {
+                    batch_psize_in_i += arrival.getPacketSize();
+                    if (++batch_num_arrivals == kBatchSize) {
+                        const double duration = (next_arrival_time -
+                                                 batch_start_time);
+                        for (PolicyProfile& profile : profiles) {
+                            if (duration > 0) {
+                                const double goodput = (
+                                    profile.batch_psize_out_i / duration);
+                                profile.bm_goodput.add(goodput);
+                                if (input_rate_gbps_a != 0) {
+                                    profile.bm_displacement_factor.add(((
+                                        batch_psize_in_i / duration) - goodput) /
+                                        input_rate_gbps_a);
+                                }
+                            }
+                            profile.batch_psize_out_i = 0;
+                        }
+                        batch_start_time = next_arrival_time;
+                        batch_psize_in_i = 0;
+                        batch_num_arrivals = 0;
+
+                        // Periodically check whether the target CI
+                        // width has been reached (for all policies).
+                        const size_t num_batches = profiles[0].bm_goodput.size();
+                        if ((kTargetCIWidth > 0) &&
+                            (num_batches >= next_convergence_check)) {
+                            next_convergence_check += (num_batches / 10);
+                            is_converged = true;
+                            for (const PolicyProfile& profile : profiles) {
+                                is_converged &= isConverged(profile.bm_goodput,
+                                    profile.bm_displacement_factor,
+                                    kTargetCIWidth);
+                            }
+                        }
+                    }
+                }
+            }
+            // Reschedule the traffic-gen's next arrival
+            if (is_attack_arrival) {
+                calendar_.schedule(event, tg_attack->getNextArrivalTime());
+            }
+            else if (tg_innocent->hasNewArrival()) {
+                calendar_.schedule(event, tg_innocent->getNextArrivalTime());
+            }
+            else {
+                calendar_.cancel(event);
+                num_active_innocents--;
             }
         }
-        // Simulate a departure
+        // Dispatch a batch whose formation deadline expired
+        else if (event >= kDeadlineEventsStart) {
+            profiler_.recordEvent(Profiler::DEADLINE);
+            Profiler::ScopedTimer timer(profiler_, Profiler::SCHEDULING);
+            calendar_.cancel(event);
+            formBatches(event - kDeadlineEventsStart, event_time);
+        }
+        // Simulate a departure (or, if batched, a batch departure)
         else {
-            assert(server_->isBusy());
-            Packet departure = server_->recordDeparture();
-            bool is_innocent = (departure.getClass() == TrafficClass::INNOCENT);
-
-            // Update profiling data
-            if (is_innocent) {
-                total_jsize_i += departure.getJobSizeActual();
-                total_psize_i += departure.getPacketSize();
-                maximum_jsize_i = std::max(maximum_jsize_i,
-                                           departure.getJobSizeActual());
-
-                maximum_psize_i = std::max(maximum_psize_i,
-                                           departure.getPacketSize());
-
-                last_depart_time_i = departure.getDepartTime();
-                last_arrive_time_i = std::max(last_arrive_time_i,
-                                              departure.getArriveTime());
-                // Currently in steady-state
-                if (is_steady_state) {
-                    ss_total_psize_i = total_psize_i;
+            const uint32_t departure_queue = event;
+            const uint32_t policy = queue_policies[departure_queue];
+            const uint32_t departure_core = (departure_queue -
+                                             (policy * num_cores));
+            const double next_departure_time = event_time;
+            PolicyProfile& profile = profiles[policy];
+            Server* const server = servers_[departure_queue];
+            Queue* const queue = queues[departure_queue];
+            PacketArena& arena = *arenas_[policy];
+            profiler_.recordEvent(Profiler::DEPARTURE);
+            departures.clear();
+            if (kIsBatched) { server->recordBatchDeparture(departures); }
+            else { departures.push_back(server->recordDeparture()); }
+
+            Profiler::ScopedTimer accounting_timer(profiler_,
+                                                   Profiler::ACCOUNTING);
+            for (const PacketHandle handle : departures) {
+                const Packet& departure = arena[handle];
+                bool is_innocent = (departure.getClass() == TrafficClass::INNOCENT);
+                profile.last_depart_time = departure.getDepartTime();
+
+                // Update profiling data
+                const double latency = departure.getLatency();
+                if (!is_innocent) {
+                    profile.latency_a.record(latency);
+                    profile.total_psize_a += departure.getPacketSize();
+                }
+                else {
+                    profile.latency_i.record(latency);
+                    if (kIsPerFlowLatency) {
+                        // Only the first kMaxNumTrackedFlows flows (in
+                        // order of first departure) are tracked.
+                        auto& flow_latencies = profile.flow_latencies_i;
+                        auto iter = (flow_latencies.size() < kMaxNumTrackedFlows) ?
+                            flow_latencies.try_emplace(departure.getFlowId(),
+                                kFlowLatencyPrecision).first :
+                            flow_latencies.find(departure.getFlowId());
+
+                        if (iter != flow_latencies.end()) { iter->second.record(latency); }
+                    }
+                    profile.total_psize_i += departure.getPacketSize();
+                    profile.core_psize_i[departure_core] += departure.getPacketSize();
+                    profile.core_last_depart_time_i[departure_core] = (
+                        departure.getDepartTime());
+                    profile.last_depart_time_i = departure.getDepartTime();
+                    // Currently in steady-state
+                    if (is_steady_state) {
+                        profile.ss_total_psize_i = profile.total_psize_i;
+                        profile.batch_psize_out_i += departure.getPacketSize();
+                    }
+                    // Also log this departure if required (first policy only)
+                    if ((packets_log != nullptr) && (policy == 0)) {
+                        packets_log->write(departure);
+                    }
                 }
-                // Also log this departure if required
-                if (packets_of) { packets.push_back(departure); }
+                arena.release(handle);
             }
+            accounting_timer.stop();
 
-            // If the queue isn't empty, schedule the next packet
-            if (!queue_->empty()) {
-                server_->schedule(next_departure_time, queue_->pop());
+            // If batched, form the next batch(es) from the queue
+            Profiler::ScopedTimer timer(profiler_, Profiler::SCHEDULING);
+            if (kIsBatched) { formBatches(departure_queue, next_departure_time); }
+            else {
+                // If the queue isn't empty, schedule the next packet
+                // (on the server that was just freed up).
+                if (!queue->empty()) {
+                    const double delay = chargeQueueOp(
+                        departure_queue, next_departure_time, false);
+
+                    const PacketHandle next = queue->pop();
+                    if (is_queue_psize_tracked) {
+                        queue_psizes[departure_queue] -= arena[next].getPacketSize();
+                    }
+                    server->schedule(next_departure_time, next, delay);
+                }
+                if (server->hasBusyServer()) {
+                    calendar_.schedule(event, server->getDepartureTime());
+                }
+                else { calendar_.cancel(event); }
             }
             // Increment the departure count
-            num_departures++;
+            num_departures += departures.size();
         }
 
-        // More innocent arrivals possible?
-        more_arrivals = (
-            tg_innocent_->hasNewArrival() &&
-            (num_innocent_arrivals < kMaxNumArrivals));
+        // More innocent arrivals possible (and required)? If
+        // not, stop all arrivals.
+        if (more_arrivals && ((num_active_innocents == 0) || is_converged ||
+                              (num_innocent_arrivals >= kMaxNumArrivals))) {
+            for (uint32_t id = kInnocentEventsStart;
+                 id < kTimerEventsStart; id++) { calendar_.cancel(id); }
+            more_arrivals = false;
+        }
+    }
+    profiler_.stop();
+
+    // Sample the last (partial) window, if any
+    if (timeseries != nullptr) {
+        double end_time = 0;
+        for (const PolicyProfile& profile : profiles) {
+            end_time = std::max(end_time, profile.last_depart_time);
+        }
+        if (end_time > sample_time) { sample(end_time); }
     }
     // Sanity checks
-    assert(queue_->empty());
-    assert(!server_->isBusy());
+    for (uint32_t idx = 0; idx < num_queues; idx++) {
+        assert(queues[idx]->empty());
+        assert(!servers_[idx]->hasBusyServer());
+    }
 
-    // Compute performance metrics
-    uint64_t average_psize_i = (total_psize_i / num_innocent_arrivals);
-    double average_jsize_i = (total_jsize_i / num_innocent_arrivals);
-    double service_rate_gbps_i = (average_psize_i / average_jsize_i);
-    double input_rate_gbps_i = (total_psize_i / last_arrive_time_i);
-    double input_rate_gbps_a = (
-        tg_attack_->getCalibratedRateInBitsPerSecond() / kBitsPerGb);
+    // Per-core load imbalance (common to all policies)
+    double core_load_imbalance = 1;
+    double total_core_jsize = 0, maximum_core_jsize = 0;
+    for (uint32_t core = 0; core < num_cores; core++) {
+        total_core_jsize += core_jsize[core];
+        maximum_core_jsize = std::max(maximum_core_jsize, core_jsize[core]);
+    }
+    if (total_core_jsize > 0) {
+        core_load_imbalance = (
+            maximum_core_jsize / (total_core_jsize / num_cores));
+    }
 
-    double last_goodput_gbps = (total_psize_i / last_depart_time_i);
-    double ss_goodput_gbps = (ss_total_psize_i / steady_state_ns);
-    double ss_displacement_factor = 0;
+    // Compute performance metrics (for every policy)
+    std::vector<SimulationResults> policy_results;
+    for (uint32_t policy = 0; policy < num_policies; policy++) {
+        const PolicyProfile& profile = profiles[policy];
+        const uint32_t first_queue = (policy * num_cores);
+
+        uint64_t average_psize_i = (total_psize_i / num_innocent_arrivals);
+        double average_jsize_i = (total_jsize_i / num_innocent_arrivals);
+        double total_speed = 0;
+        for (uint32_t core = 0; core < num_cores; core++) {
+            total_speed += servers_[first_queue + core]->getTotalSpeed();
+        }
+        double service_rate_gbps_i = ((average_psize_i / average_jsize_i) *
+                                      total_speed);
+        double input_rate_gbps_i = (total_psize_i / last_arrive_time_i);
 
-    if (input_rate_gbps_a != 0) {
-        // Epsilon to avoid messing with log-scale plots
-        ss_displacement_factor = 1e-4;
+        double last_goodput_gbps = (profile.total_psize_i /
+                                    profile.last_depart_time_i);
+        double ss_goodput_gbps = (profile.ss_total_psize_i / steady_state_ns);
+        double ss_displacement_factor = computeDisplacementFactor(
+            input_rate_gbps_i, ss_goodput_gbps, input_rate_gbps_a);
 
-        // Thresholding to make DF less noisy for small attack input rates
-        const double goodput_loss = (input_rate_gbps_i - ss_goodput_gbps);
-        if ((goodput_loss / input_rate_gbps_i) > 1e-2) {
-            ss_displacement_factor = goodput_loss / input_rate_gbps_a;
+        // Summarize the results
+        SimulationResults results;
+        results.policy = queues_[first_queue]->type();
+        results.service_rate_gbps_i = service_rate_gbps_i;
+        results.input_rate_gbps_i = input_rate_gbps_i;
+        results.input_rate_gbps_a = input_rate_gbps_a;
+        results.average_psize_i = average_psize_i;
+        results.maximum_psize_i = maximum_psize_i;
+        results.average_jsize_i = average_jsize_i;
+        results.maximum_jsize_i = maximum_jsize_i;
+        results.num_innocent_arrivals = num_innocent_arrivals;
+        results.num_arrivals = num_arrivals;
+        results.num_drops_i = profile.num_drops_i;
+        results.num_drops_a = profile.num_drops_a;
+        results.num_preemptions = profile.num_preemptions;
+        if (profile.num_service_batches != 0) {
+            results.average_batch_size = (
+                static_cast<double>(profile.num_batched_packets) /
+                profile.num_service_batches);
         }
+        results.last_goodput_gbps = last_goodput_gbps;
+        results.ss_goodput_gbps = ss_goodput_gbps;
+        results.ss_displacement_factor = ss_displacement_factor;
+        for (uint32_t core = 0; core < num_cores; core++) {
+            const Server* server = servers_[first_queue + core];
+            for (uint32_t idx = 0; idx < server->getNumServers(); idx++) {
+                results.server_utilizations.push_back(
+                    server->getUtilization(idx, profile.last_depart_time));
+            }
+        }
+        if (is_scheduler_costed) {
+            for (uint32_t core = 0; core < num_cores; core++) {
+                results.scheduler_utilizations.push_back(
+                    (profile.last_depart_time > 0) ? (scheduler_busy_times[
+                     first_queue + core] / profile.last_depart_time) : 0);
+            }
+        }
+        // Per-core goodput and load imbalance
+        for (uint32_t core = 0; core < num_cores; core++) {
+            results.core_goodputs_gbps.push_back(
+                (profile.core_last_depart_time_i[core] > 0) ? (
+                 profile.core_psize_i[core] /
+                 profile.core_last_depart_time_i[core]) : 0);
+        }
+        results.core_load_imbalance = core_load_imbalance;
+
+        // Batch-means estimates. Note: The same warm-up period is
+        // truncated from both series (whichever is the longest).
+        const size_t warmup_length = std::max(
+            profile.bm_goodput.getWarmupLength(),
+            profile.bm_displacement_factor.getWarmupLength());
+
+        const BatchMeans::Estimate goodput = (
+            profile.bm_goodput.getEstimate(warmup_length));
+        const BatchMeans::Estimate displacement_factor = (
+            profile.bm_displacement_factor.getEstimate(warmup_length));
+
+        results.num_batches = profile.bm_goodput.size();
+        results.num_warmup_batches = warmup_length;
+        results.is_converged = is_converged;
+        results.bm_goodput_gbps = goodput.mean;
+        results.bm_goodput_ci_gbps = goodput.half_width;
+        if (profile.bm_displacement_factor.size() != 0) {
+            results.bm_displacement_factor = displacement_factor.mean;
+            results.bm_displacement_factor_ci = displacement_factor.half_width;
+        }
+
+        // Latency quantiles
+        results.latency_p50_ns_i = profile.latency_i.getQuantile(0.5);
+        results.latency_p99_ns_i = profile.latency_i.getQuantile(0.99);
+        results.latency_p999_ns_i = profile.latency_i.getQuantile(0.999);
+        results.latency_p50_ns_a = profile.latency_a.getQuantile(0.5);
+        results.latency_p99_ns_a = profile.latency_a.getQuantile(0.99);
+        results.latency_p999_ns_a = profile.latency_a.getQuantile(0.999);
+        if (!profile.flow_latencies_i.empty()) {
+            std::vector<double> flow_p99s;
+            for (const auto& flow_latency : profile.flow_latencies_i) {
+                flow_p99s.push_back(flow_latency.second.getQuantile(0.99));
+            }
+            std::sort(flow_p99s.begin(), flow_p99s.end());
+            results.num_flows_i = flow_p99s.size();
+            results.flow_p99_latency_p50_ns = flow_p99s[(flow_p99s.size() - 1) / 2];
+            results.flow_p99_latency_max_ns = flow_p99s.back();
+        }
+        policy_results.push_back(results);
     }
-    if (verbose) {
-        std::cout << "==========================================" << std::endl
-                  << "            Simulation Results            " << std::endl
-                  << "==========================================" << std::endl;
-
-        // Display performance metrics
-        std::cout << std::fixed << std::setprecision(2);
-        std::cout << "Maximum service rate: " << service_rate_gbps_i << " Gbps" << std::endl;
-        std::cout << "Innocent packet rate: " << input_rate_gbps_i << " Gbps" << std::endl;
-        std::cout << "Average packet size: " << average_psize_i << " bits" << std::endl;
-        std::cout << "Maximum packet size: " << maximum_psize_i << " bits" << std::endl;
-        std::cout << "Average job size: " << average_jsize_i << " ns" << std::endl;
-        std::cout << "Maximum job size: " << maximum_jsize_i << " ns" << std::endl;
-        std::cout << "Innocent arrivals: " << num_innocent_arrivals << std::endl;
-        std::cout << "Total arrivals: " << num_arrivals << std::endl;
-        std::cout << std::endl;
+    return policy_results;
+}
 
-        std::cout << std::fixed << std::setprecision(4);
-        std::cout << "Average goodput: " << last_goodput_gbps << " Gbps" << std::endl;
-        std::cout << "Steady-state goodput: " << ss_goodput_gbps << " Gbps" << std::endl;
-        std::cout << "Steady-state displacement factor: " << ss_displacement_factor << std::endl;
-        std::cout << std::endl;
+std::vector<SimulationResults>
+Simulator::runAll(const bool verbose, const std::string packets_fp,
+                  const PacketLogFormat packets_format) {
+    // Packet output. Note: The output packet log
+    // is ordered by packet departure times.
+    std::unique_ptr<PacketLogWriter> packets_log;
+    if (!packets_fp.empty()) {
+        packets_log.reset(new PacketLogWriter(packets_fp, packets_format));
     }
 
-    // Output packet data. Note: The output packet
-    // log is ordered by packet departure times.
-    if (packets_of) {
-        packets_of << std::fixed << std::setprecision(2);
-        for (const Packet& packet : packets) {
-            packets_of << packet.getArriveTime()        << ";"
-                       << packet.getDepartTime()        << ";"
-                       << packet.getFlowId()            << ";"
-                       << packet.getClassTag()          << ";"
-                       << packet.getPacketSize()        << ";"
-                       << packet.getJobSizeEstimate()   << ";"
-                       << packet.getJobSizeActual()     << std::endl;
+    // Reset the simulation state. Note: This is required even
+    // for the first run, since components may be shared with
+    // other simulator instances.
+    reset();
+
+    // Print configuration
+    if (verbose) { printConfig(); }
+
+    // Run the simulation loop, specialized on the concrete component
+    // types if they are all built-in (else, via the virtual interfaces).
+    // Note: Traffic-gens of the same class must share the same type,
+    // and queues are only specialized if all policies are the same.
+    PacketLogWriter* const log = packets_log.get();
+    auto run_virtual = [&]() {
+        return runImpl<BaseQueue, Application,
+                       TrafficGenerator, TrafficGenerator>(log);
+    };
+    auto run_typed = [&](auto queue_tag) {
+        return ApplicationFactory::Types::dispatch(
+            *application_, [&](auto app_tag) {
+            return TrafficGeneratorFactory::InnocentTypes::dispatch(
+                *tg_innocents_[0], [&](auto tg_innocent_tag) {
+                return TrafficGeneratorFactory::AttackTypes::dispatch(
+                    *tg_attacks_[0], [&](auto tg_attack_tag) {
+                    return runImpl<typename decltype(queue_tag)::type,
+                                   typename decltype(app_tag)::type,
+                                   typename decltype(tg_innocent_tag)::type,
+                                   typename decltype(tg_attack_tag)::type>(log);
+                }, run_virtual);
+            }, run_virtual);
+        }, run_virtual);
+    };
+    const bool is_homogeneous = (isHomogeneous(tg_innocents_) &&
+                                 isHomogeneous(tg_attacks_));
+
+    std::vector<SimulationResults> results = !is_homogeneous ? run_virtual() :
+        !isHomogeneous(queues_) ? run_typed(TypeTag<BaseQueue>()) :
+        QueueFactory::Types::dispatch(*queues_[0], run_typed, run_virtual);
+
+    if (verbose) {
+        for (const SimulationResults& policy_results : results) {
+            policy_results.print(std::cout);
         }
     }
-    // Disallow re-runs
-    done = true;
+    num_runs_++;
+
+    // Flush the packet log
+    if (packets_log) { packets_log->close(); }
+    return results;
+}
+
+SimulationResults Simulator::run(const bool verbose,
+                                 const std::string packets_fp,
+                                 const PacketLogFormat packets_format) {
+    return runAll(verbose, packets_fp, packets_format)[0];
 }
 
 int main(int argc, char** argv) {
@@ -314,6 +1382,15 @@ int main(int argc, char** argv) {
     bool is_dry_run;        // Dry-run mode?
     std::string config_fp;  // Path to config file
     std::string packets_fp; // Path to packets file
+    std::string packets_format; // Packets file format
+    std::string sweep_fp;   // Path to sweep (grid) file
+    std::string results_fp; // Path to sweep results file
+    uint32_t num_threads;   // Sweep worker thread count
+    uint32_t num_replications; // Replication count
+    uint64_t seed;          // RNG seed
+    std::string timeseries_fp; // Path to time-series file
+    double timeseries_interval_ns; // Time-series sampling interval
+    bool is_profiled;       // Print a self-profiling report?
 
     // Parse arguments
     options_description desc{"Adversarial scheduling simulator"};
@@ -324,7 +1401,16 @@ int main(int argc, char** argv) {
             ("help",    "Prints this message")
             ("config",  value<std::string>(&config_fp)->required(), "[Required] Path to a configuration (.cfg) file")
             ("packets", value<std::string>(&packets_fp),            "[Optional] Path to an output packets file")
-            ("dry",                                                 "[Optional] Perform a dry-run (using FCFS)");
+            ("packets_format", value<std::string>(&packets_format)->default_value("binary"), "[Optional] Packets file format ('binary', 'columnar', or 'text')")
+            ("dry",                                                 "[Optional] Perform a dry-run (using FCFS)")
+            ("sweep",   value<std::string>(&sweep_fp),              "[Optional] Path to a sweep grid (.cfg) file; runs every grid point in-process")
+            ("threads", value<uint32_t>(&num_threads)->default_value(0), "[Optional] Sweep worker thread count (default: grid value, else all cores)")
+            ("results", value<std::string>(&results_fp),            "[Optional] Path to an output sweep results (.csv) file (default: stdout)")
+            ("replications", value<uint32_t>(&num_replications)->default_value(1), "[Optional] Number of back-to-back simulation runs (default: 1; sweeps use the grid's 'replications')")
+            ("seed",    value<uint64_t>(&seed),                     "[Optional] RNG seed (default: config value, else random)")
+            ("timeseries", value<std::string>(&timeseries_fp),      "[Optional] Path to an output time-series (.csv) file")
+            ("timeseries_interval", value<double>(&timeseries_interval_ns)->default_value(1e6), "[Optional] Time-series sampling interval in ns of simulated time (default: 1 ms)")
+            ("profile",                                             "[Optional] Print a self-profiling report (event rate, time breakdown, peak RSS) at exit");
 
         // Parse simulation parameters
         store(command_line_parser(argc, argv).options(desc).run(), variables);
@@ -346,13 +1432,41 @@ int main(int argc, char** argv) {
         std::cerr << "Error:" << e.what() << std::endl;
         return false;
     }
-    // Dry-run?
+    // Dry-run? Profiled?
     is_dry_run = (variables.count("dry") != 0);
+    is_profiled = (variables.count("profile") != 0);
+
+    // Parse the packets file format
+    PacketLogFormat packets_log_format;
+    try {
+        packets_log_format = parsePacketLogFormat(packets_format);
+    }
+    catch(const std::invalid_argument& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return(EXIT_FAILURE);
+    }
+
+    // Sweep mode?
+    bool is_sweep = !sweep_fp.empty();
+    if (is_sweep && is_dry_run) {
+        std::cerr << "Error: Dry-runs are not supported in sweep mode." << std::endl;
+        return(EXIT_FAILURE);
+    }
+    if (is_sweep && !timeseries_fp.empty()) {
+        std::cerr << "Error: Time-series output is not supported in sweep mode." << std::endl;
+        return(EXIT_FAILURE);
+    }
+    if (is_sweep && is_profiled) {
+        std::cerr << "Error: Profiling is not supported in sweep mode "
+                  << "(profile the grid point's config instead)." << std::endl;
+        return(EXIT_FAILURE);
+    }
 
-    // Parse the configuration
-    libconfig::Config cfg;
+    // Parse the configuration (and the sweep grid, if any)
+    libconfig::Config cfg, sweep_cfg;
     try {
         cfg.readFile(config_fp);
+        if (is_sweep) { sweep_cfg.readFile(sweep_fp); }
     }
     catch(const libconfig::FileIOException &fioex) {
         std::cerr << "I/O error while reading file." << std::endl;
@@ -364,9 +1478,51 @@ int main(int argc, char** argv) {
         return(EXIT_FAILURE);
     }
 
+    // Run a parameter sweep
+    if (is_sweep) {
+        sweep_cfg.setAutoConvert(true);
+        Sweep sweep(config_fp, sweep_cfg.getRoot(), num_threads);
+        if (variables.count("seed")) { sweep.setSeed(seed); }
+        sweep.run(results_fp);
+        return 0;
+    }
     cfg.setAutoConvert(true);
+
+    // Simulate an NF chain
+    if (cfg.getRoot().exists("chain")) {
+        if (is_dry_run) {
+            std::cerr << "Error: Dry-runs are not supported for NF chains." << std::endl;
+            return(EXIT_FAILURE);
+        }
+        if (!packets_fp.empty() || !timeseries_fp.empty() || is_profiled) {
+            std::cerr << "Error: Packet logs, time-series output, and "
+                      << "profiling are not supported for NF chains." << std::endl;
+            return(EXIT_FAILURE);
+        }
+        ChainSimulator chain(cfg.getRoot());
+        if (variables.count("seed")) { chain.setSeed(seed); }
+        chain.run(true); // Run simulation
+
+        for (uint32_t idx = 1; idx < num_replications; idx++) {
+            std::cout << "Replication " << idx << ":" << std::endl;
+            chain.run(false).print(std::cout);
+        }
+        return 0;
+    }
     Simulator simulator(is_dry_run, cfg.getRoot());
-    simulator.run(true, packets_fp); // Run simulation
+    if (variables.count("seed")) { simulator.setSeed(seed); }
+    if (!timeseries_fp.empty()) {
+        simulator.setTimeSeries(timeseries_fp, timeseries_interval_ns);
+    }
+    simulator.setProfiling(is_profiled);
+    simulator.run(true, packets_fp, packets_log_format); // Run simulation
+
+    // Run any additional replications (reusing the simulator)
+    for (uint32_t idx = 1; idx < num_replications; idx++) {
+        std::cout << "Replication " << idx << ":" << std::endl;
+        simulator.run(false).print(std::cout);
+    }
+    if (is_profiled) { simulator.printProfile(std::cout); }
 
     return 0;
 }
@@ -2,35 +2,256 @@
 #define SIMULATOR_SIMULATOR_H
 
 // Library headers
+#include "common/batch_means.h"
+#include "logging/packet_log.h"
+#include "logging/packet_log_writer.h"
+#include "logging/timeseries_writer.h"
+#include "packet/packet_arena.h"
 #include "queueing/base_queue.h"
+#include "queueing/queue_capacity.h"
+#include "queueing/queue_cost_model.h"
+#include "server/rss_dispatcher.h"
 #include "server/server.h"
+#include "event_calendar.h"
+#include "profiler.h"
+#include "traffic/trace_cache.h"
+#include "traffic/trace_trafficgen.h"
 #include "traffic/trafficgen.h"
 
+// STD headers
+#include <functional>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 // Libconfig
 #include <libconfig.h++>
 
 /**
- * Implements the core simulator functionality.
+ * Helper function to parse the server pool configuration. Servers
+ * are specified either as a count of identical (unit-speed) servers
+ * ('num_servers'), or as a list of relative speeds ('server_speeds').
+ * @throw runtime error if the configuration is invalid.
+ */
+std::vector<double> parseServerSpeeds(const libconfig::Setting& config);
+
+/**
+ * Helper function. Returns the configs (e.g., of traffic-gens) in the
+ * given setting, which is either a single group or a list of groups.
+ */
+std::vector<const libconfig::Setting*>
+getConfigList(const libconfig::Setting& config);
+
+/**
+ * Helper function to validate the maximum arrival count, which must
+ * be set (i.e., less than the maximum) iff the innocent traffic-gens
+ * aren't all trace-driven. @throw runtime error if the check fails.
+ */
+template<class TrafficGenerators>
+void validateMaxNumArrivals(const uint64_t max_num_arrivals,
+                            const TrafficGenerators& tg_innocents) {
+    bool is_use_trace = true;
+    for (const auto& tg : tg_innocents) {
+        is_use_trace &= (tg->type() == TraceTrafficGenerator::name());
+    }
+    bool is_max_arrival_count_set = (max_num_arrivals !=
+                                     std::numeric_limits<uint64_t>::max());
+
+    if (!(is_max_arrival_count_set ^ is_use_trace)) {
+        throw std::runtime_error(
+            "'max_num_arrivals' must be set iff not using a trace.");
+    }
+}
+
+/**
+ * Helper function. Returns the displacement factor, i.e. the loss in
+ * innocent goodput per unit of attack traffic, given the innocent and
+ * attack input rates and the innocent goodput (all in Gbps).
+ */
+double computeDisplacementFactor(const double input_rate_gbps_i,
+                                 const double goodput_gbps_i,
+                                 const double input_rate_gbps_a);
+
+/**
+ * Represents the summary statistics of a simulation run.
+ */
+struct SimulationResults final {
+    std::string policy;                 // Scheduling policy
+    double service_rate_gbps_i = 0;     // Maximum service rate (class I)
+    double input_rate_gbps_i = 0;       // Input rate (class I)
+    double input_rate_gbps_a = 0;       // Input rate (class A)
+    uint64_t average_psize_i = 0;       // Average packet size (class I)
+    uint32_t maximum_psize_i = 0;       // Maximum packet size (class I)
+    double average_jsize_i = 0;         // Average job size (class I)
+    double maximum_jsize_i = 0;         // Maximum job size (class I)
+    uint64_t num_innocent_arrivals = 0; // Innocent arrival count
+    uint64_t num_arrivals = 0;          // Total arrival count
+    uint64_t num_drops_i = 0;           // Drop count (class I)
+    uint64_t num_drops_a = 0;           // Drop count (class A)
+    uint64_t num_preemptions = 0;       // Preemption count
+    double average_batch_size = 1;      // Average packets per batch
+    double last_goodput_gbps = 0;       // Average goodput
+    double ss_goodput_gbps = 0;         // Steady-state goodput
+    double ss_displacement_factor = 0;  // Steady-state DF
+    std::vector<double> server_utilizations; // Per-server utilization
+    std::vector<double> scheduler_utilizations; // Per-core scheduler
+                                                // utilization (if modeled)
+    std::vector<double> core_goodputs_gbps; // Per-core goodput
+    double core_load_imbalance = 1;     // Max-to-mean per-core load
+    double latency_p50_ns_i = 0;        // Median latency (class I)
+    double latency_p99_ns_i = 0;        // 99th-percentile latency (class I)
+    double latency_p999_ns_i = 0;       // 99.9th-percentile latency (class I)
+    double latency_p50_ns_a = 0;        // Median latency (class A)
+    double latency_p99_ns_a = 0;        // 99th-percentile latency (class A)
+    double latency_p999_ns_a = 0;       // 99.9th-percentile latency (class A)
+    uint64_t num_flows_i = 0;           // Flow count (class I, if tracked)
+    double flow_p99_latency_p50_ns = 0; // Median per-flow p99 latency
+    double flow_p99_latency_max_ns = 0; // Maximum per-flow p99 latency
+    uint64_t num_batches = 0;           // Steady-state batch count
+    uint64_t num_warmup_batches = 0;    // Batches truncated as warm-up
+    bool is_converged = false;          // Stopped at the target CI width?
+    double bm_goodput_gbps = 0;         // Batch-means goodput
+    double bm_goodput_ci_gbps = 0;      // 95% CI half-width (goodput)
+    double bm_displacement_factor = 0;  // Batch-means DF
+    double bm_displacement_factor_ci = 0; // 95% CI half-width (DF)
+
+    /**
+     * Print the results in a human-readable format.
+     */
+    void print(std::ostream& out) const;
+};
+
+/**
+ * Implements the core simulator functionality. The system comprises
+ * one or more cores, each of which is a (queue, server) pair. In the
+ * (default) shared topology, a single queue feeds a pool of servers;
+ * in the partitioned topology, every server has its own queue, and
+ * arrivals are dispatched to cores by flow hash (as with RSS). Cores
+ * schedule independently, but are simulated in one event loop, fed by
+ * any number of innocent and attack traffic-gens (see EventCalendar).
+ *
+ * Scheduling is free by default. If a queue cost model is specified,
+ * every core also has a scheduler, which performs queue operations one
+ * at a time; enqueues and dequeues occupy it for the modeled duration,
+ * and a server that frees up must wait for its dequeue to complete. As
+ * such, the scheduler (rather than the servers) may become a bottleneck.
+ *
+ * Scheduling is non-preemptive by default. In preemptive mode, an
+ * arrival that takes priority over a job in service (as ranked by
+ * the queue, using the remaining work) preempts it, and the latter
+ * is requeued with its remaining work; e.g., SJF then yields SRPT.
+ *
+ * In batched mode, an idle server waits for up to max_batch_size packets
+ * to be queued (but at most timeout_ns after the first one), then takes
+ * the top packets of the queue (in scheduling order) as a batch; e.g.,
+ * with WSJF, a batch comprises the top-k packets by WSJF metric. Every
+ * batch incurs a fixed cost, which is amortized over its packets.
+ *
+ * To compare policies cheaply, several policies may be simulated in
+ * lockstep: every policy gets its own set of cores, and each arrival
+ * is generated (and sized by the application) once, then fanned out
+ * to all of them. This is sound since job sizes are determined upon
+ * arrival, independently of the order in which packets are served.
+ *
+ * Simulator instances are reusable: every run starts by resetting the
+ * queues, servers (and application), and traffic-gens to their initial
+ * states, so several runs (e.g., replications) can be performed back-
+ * to-back.
  */
 class Simulator final {
 private:
+    // Precision of per-flow latency sketches (see LogLinearHistogram)
+    static constexpr uint32_t kFlowLatencyPrecision = 5;
+
+    // Maximum number of flows whose latencies are tracked. Since each
+    // sketch takes up to ~7KB (for latencies of up to 1s), this bounds
+    // the memory used for per-flow latencies to ~70MB per policy.
+    static constexpr uint32_t kMaxNumTrackedFlows = 10000;
+
+    // Default number of innocent arrivals per steady-state batch
+    static constexpr uint32_t kDefaultBatchSize = 1000;
+
+    // Minimum number of batches before checking for convergence
+    static constexpr uint64_t kMinNumBatches = (10 * BatchMeans::kNumBatches);
+
+    // RNG stream IDs of the simulation components (see reset)
+    static constexpr uint64_t kApplicationStream = 0;
+    static constexpr uint64_t kInnocentStreamsStart = (1ULL << 32);
+    static constexpr uint64_t kAttackStreamsStart = (2ULL << 32);
+
     // Simulation config
     const bool kIsDryRun; // Dry run?
+    const bool kOwnsComponents; // Owns (deallocates) the components?
     uint64_t kMaxNumArrivals; // Max arrival count
-    Server* server_ = nullptr; // Server implementation
-    BaseQueue* queue_ = nullptr; // Queue implementation
-    TrafficGenerator* tg_innocent_ = nullptr; // Innocent traffic-gen
-    TrafficGenerator* tg_attack_ = nullptr; // Adversarial traffic-gen
+    bool kIsPerFlowLatency = false; // Track per-flow latency?
+    uint32_t kBatchSize = kDefaultBatchSize; // Innocent arrivals per batch
+    double kTargetCIWidth = 0; // Target (relative) CI half-width, if any
+    uint64_t kSeed = 0; // Base RNG seed
+    QueueCapacity kQueueCapacity; // Per-queue capacity and drop policy
+    bool kIsPreemptive = false; // Preempt jobs in service?
+    double kContextSwitchNs = 0; // Cost of a preemption (ns)
+    bool kIsBatched = false; // Serve packets in batches?
+    uint32_t kMaxBatchSize = 1; // Maximum packets per batch
+    double kBatchTimeoutNs = 0; // Batch formation timeout (ns)
+    double kBatchCostNs = 0; // Work per batch (ns)
+    double kPacketCostNs = 0; // Additional work per batched packet (ns)
+    uint32_t num_runs_ = 0; // Runs since seeding (selects the RNG streams)
+    std::vector<Server*> servers_; // Per-core servers
+    std::vector<BaseQueue*> queues_; // Per-core queues
+    RSSDispatcher dispatcher_; // Maps flows to cores
+    Application* application_ = nullptr; // Application implementation
+    std::vector<TrafficGenerator*> tg_innocents_; // Innocent traffic-gens
+    std::vector<TrafficGenerator*> tg_attacks_; // Adversarial traffic-gens
+    std::vector<std::unique_ptr<PacketArena>> arenas_; // Per-policy storage
+                                                       // for in-flight packets
+    std::vector<std::unique_ptr<QueueCostModel>> cost_models_; // Per-policy
+                                                       // scheduler costs, if any
+    EventCalendar calendar_; // Pending events
 
-    // Housekeeping
-    bool done = false;
+    /**
+     * Periodic timer (see addTimer).
+     */
+    struct Timer {
+        double period_ns; // Firing period (ns)
+        std::function<void(const double)> callback; // Invoked on expiry
+    };
+    std::vector<Timer> timers_; // User timers
+    std::unique_ptr<TimeSeriesWriter> timeseries_; // Time-series output
+    double kTimeSeriesIntervalNs = 0; // Time-series sampling interval (ns)
+    Profiler profiler_; // Self-profiling instrumentation (if enabled)
 
     // Helper method to parse configs
-    void parseSimulationConfig(const libconfig::Setting& config);
+    void parseSimulationConfig(const libconfig::Setting& config,
+                               TraceCache* const trace_cache);
+
+    // Helper method to validate the simulation config
+    void validateConfig() const;
+
+    // Simulation loop, specialized on the component types
+    template<class Queue, class App, class InnocentTG, class AttackTG>
+    std::vector<SimulationResults> runImpl(PacketLogWriter* const packets_log);
 
 public:
     explicit Simulator(const bool is_dry_run,
-                       const libconfig::Setting& config);
+                       const libconfig::Setting& config,
+                       TraceCache* const trace_cache = nullptr);
+
+    /**
+     * Instantiates a simulator using pre-built components. The
+     * caller retains ownership of the components, which may be
+     * shared across (non-concurrent) simulator instances. By
+     * default, packets are served by a single (unit-speed) server.
+     */
+    explicit Simulator(const bool is_dry_run,
+                       const uint64_t max_num_arrivals,
+                       BaseQueue* const queue,
+                       Application* const application,
+                       TrafficGenerator* const tg_innocent,
+                       TrafficGenerator* const tg_attack,
+                       const std::vector<double>& server_speeds={1});
     ~Simulator();
 
     /**
@@ -39,10 +260,86 @@ public:
     void printConfig() const;
 
     /**
-     * Run simulation.
+     * Registers a timer that fires every period_ns (of simulated
+     * time) during subsequent runs, e.g. for periodic sampling or
+     * flow timeouts. The callback is invoked with the current time,
+     * after any other events at that time. Note: Timers do not keep
+     * the simulation alive once all packets have departed.
+     */
+    void addTimer(const double period_ns,
+                  const std::function<void(const double)> callback);
+
+    /**
+     * Enables time-series output: during subsequent runs, a sample
+     * of every policy's state is written to the given (CSV) file
+     * every interval_ns of simulated time (see TimeSeriesSample).
+     * Sampling only reads counters that are maintained regardless,
+     * so its overhead is negligible for reasonable intervals.
+     */
+    void setTimeSeries(const std::string& fp, const double interval_ns);
+
+    /**
+     * Enables self-profiling: subsequent runs count events and time
+     * the phases of the simulation loop (see Profiler). Use this to
+     * tell whether a slow configuration is bound by the queues (e.g.,
+     * very deep heaps) or by the application (e.g., TCP reassembly).
+     */
+    void setProfiling(const bool is_enabled) {
+        profiler_.setEnabled(is_enabled);
+    }
+
+    /**
+     * Print the self-profiling report (accumulated over all runs).
+     */
+    void printProfile(std::ostream& out) const { profiler_.print(out); }
+
+    // Accessors
+    uint64_t getSeed() const { return kSeed; }
+    bool isQueueBounded() const { return kQueueCapacity.isBounded(); }
+    uint32_t getNumPolicies() const {
+        return (queues_.size() / dispatcher_.getNumCores());
+    }
+
+    /**
+     * Sets the base RNG seed. Runs are reproducible: the random
+     * inputs (e.g., packet and job sizes) of the r'th run after
+     * seeding depend only on the seed, r, and the traffic config.
+     * In particular, runs with different policies see common
+     * random numbers, which reduces the variance of comparisons.
+     */
+    void setSeed(const uint64_t seed) { kSeed = seed; num_runs_ = 0; }
+
+    /**
+     * Returns a non-deterministic seed (e.g., if none is specified).
+     */
+    static uint64_t getRandomSeed();
+
+    /**
+     * Resets the simulation components to their initial states,
+     * and seeds their RNG streams for the next run.
+     */
+    void reset();
+
+    /**
+     * Run simulation. If verbose, prints the configuration
+     * and results to stdout. If a packets file is specified,
+     * streams innocent departures to it in the given format.
+     * Returns the summary results.
+     */
+    SimulationResults run(const bool verbose,
+                          const std::string packets_fp="",
+                          const PacketLogFormat packets_format=
+                                PacketLogFormat::BINARY);
+
+    /**
+     * Same as run(), but returns the results for every policy
+     * (in lockstep mode, in the order specified). Note: Only
+     * departures of the first policy are written to the log.
      */
-    void run(const bool verbose,
-             const std::string packets_fp="");
+    std::vector<SimulationResults> runAll(const bool verbose,
+                                          const std::string packets_fp="",
+                                          const PacketLogFormat packets_format=
+                                                PacketLogFormat::BINARY);
 };
 
 #endif // SIMULATOR_SIMULATOR_H
@@ -0,0 +1,424 @@
+#include "sweep.h"
+
+// Library headers
+#include "common/philox.h"
+#include "traffic/synthetic_trafficgen.h"
+
+// STD headers
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+/**
+ * Helper method. Replaces (or adds) the named setting in the
+ * given group, and returns a reference to the new setting.
+ */
+static libconfig::Setting&
+overrideSetting(libconfig::Setting& group, const char* name,
+                const libconfig::Setting::Type type) {
+    if (group.exists(name)) { group.remove(name); }
+    return group.add(name, type);
+}
+
+/**
+ * Helper method. Returns a compact string representation of
+ * the given rate (in bps), for use in grid point names.
+ */
+static std::string rateToString(const double rate_bps) {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(0) << rate_bps;
+    return ss.str();
+}
+
+/**
+ * Sweep implementation.
+ */
+Sweep::Sweep(const std::string& template_fp, const libconfig::Setting& grid,
+             const uint32_t num_threads) {
+    // Read the template configuration. Every grid point parses
+    // its own copy, so the template is stored as (raw) text.
+    std::ifstream template_ifs(template_fp);
+    if (!template_ifs) {
+        throw std::runtime_error("Failed to read template: " +
+                                 template_fp + ".");
+    }
+    std::stringstream ss;
+    ss << template_ifs.rdbuf();
+    template_ = ss.str();
+
+    // Parse the grid specification
+    parseGrid(grid);
+    grid.lookupValue("replications", num_replications_);
+    if (num_replications_ == 0) {
+        throw std::runtime_error("Replication count must be positive.");
+    }
+    // Determine the base RNG seed. If neither the grid nor the
+    // template specifies one, a random seed is shared by all the
+    // points (so they still see common random numbers).
+    unsigned long long seed;
+    seed_ = Simulator::getRandomSeed();
+    if (grid.lookupValue("seed", seed)) { setSeed(seed); }
+    grid.lookupValue("common_random_numbers", is_crn_);
+    if (points_.empty()) {
+        throw std::runtime_error("Sweep must contain at least one point.");
+    }
+    // Determine the worker thread count. The command-line
+    // takes precedence over the grid specification, which
+    // takes precedence over the hardware concurrency.
+    num_threads_ = num_threads;
+    if (num_threads_ == 0) { grid.lookupValue("threads", num_threads_); }
+    if (num_threads_ == 0) { num_threads_ = std::thread::hardware_concurrency(); }
+    num_threads_ = std::max(1U, std::min(num_threads_, static_cast<
+                                         uint32_t>(points_.size())));
+}
+
+void Sweep::parseGrid(const libconfig::Setting& grid) {
+    // Explicit list of points
+    if (grid.exists("points")) {
+        const libconfig::Setting& points = grid["points"];
+        for (int idx = 0; idx < points.getLength(); idx++) {
+            const libconfig::Setting& setting = points[idx];
+            Point point;
+            int attack_psize_bits = -1, attack_num_flows = -1;
+
+            setting.lookupValue("name", point.name);
+            setting.lookupValue("policy", point.policy);
+            setting.lookupValue("innocent_rate_bps", point.innocent_rate_bps);
+            setting.lookupValue("average_packet_size_bits", point.innocent_psize_bits);
+            setting.lookupValue("attack_rate_bps", point.attack_rate_bps);
+            setting.lookupValue("attack_job_size_ns", point.attack_jsize_ns);
+            setting.lookupValue("attack_packet_size_bits", attack_psize_bits);
+            setting.lookupValue("attack_num_flows", attack_num_flows);
+            setting.lookupValue("output_fp", point.output_fp);
+            setting.lookupValue("packets_fp", point.packets_fp);
+
+            point.attack_psize_bits = attack_psize_bits;
+            point.attack_num_flows = attack_num_flows;
+            if (point.name.empty()) { point.name = "point_" + std::to_string(idx); }
+            points_.push_back(point);
+        }
+    }
+    // Cartesian product of policies and rates. Unspecified
+    // axes retain the value in the template configuration.
+    else {
+        std::vector<std::string> policies;
+        std::vector<double> innocent_rates, attack_rates;
+        if (grid.exists("policies")) {
+            const libconfig::Setting& setting = grid["policies"];
+            for (int idx = 0; idx < setting.getLength(); idx++) {
+                policies.push_back(static_cast<const char*>(setting[idx]));
+            }
+        }
+        if (grid.exists("innocent_rates_bps")) {
+            const libconfig::Setting& setting = grid["innocent_rates_bps"];
+            for (int idx = 0; idx < setting.getLength(); idx++) {
+                innocent_rates.push_back(static_cast<double>(setting[idx]));
+            }
+        }
+        if (grid.exists("attack_rates_bps")) {
+            const libconfig::Setting& setting = grid["attack_rates_bps"];
+            for (int idx = 0; idx < setting.getLength(); idx++) {
+                attack_rates.push_back(static_cast<double>(setting[idx]));
+            }
+        }
+        if (policies.empty()) { policies.push_back(""); }
+        if (innocent_rates.empty()) { innocent_rates.push_back(NAN); }
+        if (attack_rates.empty()) { attack_rates.push_back(NAN); }
+
+        for (const std::string& policy : policies) {
+            for (const double innocent_rate : innocent_rates) {
+                for (const double attack_rate : attack_rates) {
+                    Point point;
+                    point.policy = policy;
+                    point.innocent_rate_bps = innocent_rate;
+                    point.attack_rate_bps = attack_rate;
+
+                    // Generate the point name
+                    point.name = policy.empty() ? "template" : policy;
+                    if (!std::isnan(innocent_rate)) {
+                        point.name += "_I" + rateToString(innocent_rate);
+                    }
+                    if (!std::isnan(attack_rate)) {
+                        point.name += "_A" + rateToString(attack_rate);
+                    }
+                    points_.push_back(point);
+                }
+            }
+        }
+    }
+}
+
+void Sweep::applyPoint(const Point& point, libconfig::Setting& root) {
+    using libconfig::Setting;
+
+    // Scheduling policy
+    if (!point.policy.empty()) {
+        if (root.exists("policies")) { root.remove("policies"); }
+        overrideSetting(root, "policy", Setting::TypeString) = point.policy;
+    }
+    // Innocent traffic parameters
+    if (!std::isnan(point.innocent_rate_bps) ||
+        !std::isnan(point.innocent_psize_bits)) {
+        if (!root.exists("innocent_traffic")) {
+            throw std::runtime_error("Must specify 'innocent_traffic'.");
+        }
+        Setting& innocent = root["innocent_traffic"];
+        if (!innocent.isGroup()) {
+            throw std::runtime_error("Sweeping 'innocent_traffic' parameters "
+                                     "requires a single traffic-gen.");
+        }
+        if (!std::isnan(point.innocent_rate_bps)) {
+            overrideSetting(innocent, "rate_bps",
+                Setting::TypeFloat) = point.innocent_rate_bps;
+        }
+        if (!std::isnan(point.innocent_psize_bits)) {
+            overrideSetting(innocent, "average_packet_size_bits",
+                Setting::TypeFloat) = point.innocent_psize_bits;
+        }
+    }
+    // Attack traffic parameters
+    if (!std::isnan(point.attack_rate_bps) ||
+        !std::isnan(point.attack_jsize_ns) ||
+        (point.attack_psize_bits >= 0) || (point.attack_num_flows >= 0)) {
+        if (!root.exists("attack_traffic")) {
+            Setting& attack = root.add("attack_traffic", Setting::TypeGroup);
+            attack.add("type", Setting::TypeString) = (
+                SyntheticTrafficGenerator::name());
+        }
+        Setting& attack = root["attack_traffic"];
+        if (!attack.isGroup()) {
+            throw std::runtime_error("Sweeping 'attack_traffic' parameters "
+                                     "requires a single traffic-gen.");
+        }
+        if (!std::isnan(point.attack_rate_bps)) {
+            overrideSetting(attack, "rate_bps",
+                Setting::TypeFloat) = point.attack_rate_bps;
+        }
+        if (!std::isnan(point.attack_jsize_ns)) {
+            overrideSetting(attack, "job_size_ns",
+                Setting::TypeFloat) = point.attack_jsize_ns;
+        }
+        if (point.attack_psize_bits >= 0) {
+            overrideSetting(attack, "packet_size_bits", Setting::TypeInt) = (
+                static_cast<int>(point.attack_psize_bits));
+        }
+        if (point.attack_num_flows >= 0) {
+            overrideSetting(attack, "num_flows", Setting::TypeInt) = (
+                static_cast<int>(point.attack_num_flows));
+        }
+    }
+}
+
+std::vector<Sweep::Row> Sweep::simulatePoint(const size_t idx) {
+    const Point& point = points_[idx];
+    std::vector<Row> rows;
+    Row row;
+    row.innocent_rate_bps = NAN;
+    row.attack_rate_bps = 0;
+    try {
+        // Instantiate the point's configuration
+        libconfig::Config cfg;
+        cfg.readString(template_);
+        cfg.setAutoConvert(true);
+
+        libconfig::Setting& root = cfg.getRoot();
+        applyPoint(point, root);
+
+        // Record the effective parameters
+        root.lookupValue("policy", row.policy);
+        root.lookupValue("innocent_traffic.rate_bps", row.innocent_rate_bps);
+        root.lookupValue("attack_traffic.rate_bps", row.attack_rate_bps);
+
+        // NF chains are simulated separately (see ChainSimulator)
+        if (root.exists("chain")) {
+            throw std::runtime_error("NF chains are not supported in sweeps.");
+        }
+        // Run the simulation. Replications reuse the simulator
+        // instance; only the first one writes the packets file.
+        Simulator simulator(false, root, &trace_cache_);
+
+        // Seed the simulator. Without common random numbers, every
+        // point is assigned a distinct stream of the base seed.
+        row.seed = (is_seed_set_ || !root.exists("seed")) ?
+                   seed_ : simulator.getSeed();
+        if (!is_crn_) { row.seed = deriveSeed(row.seed, idx); }
+        simulator.setSeed(row.seed);
+        std::ofstream output_of;
+        if (!point.output_fp.empty()) {
+            output_of.open(point.output_fp, std::ios::trunc);
+        }
+        for (uint32_t replication = 0; replication < num_replications_;
+             replication++) {
+            row.replication = replication;
+            const std::vector<SimulationResults> results = simulator.runAll(
+                false, (replication == 0) ? point.packets_fp : "");
+
+            // In lockstep mode, every policy yields its own row
+            for (const SimulationResults& policy_results : results) {
+                row.policy = policy_results.policy;
+                row.results = policy_results;
+
+                // Write the results summary, if required
+                if (output_of) { row.results.print(output_of); }
+                rows.push_back(row);
+            }
+        }
+    }
+    catch(const libconfig::SettingException& e) {
+        row.error = std::string("Setting error at ") + e.getPath();
+        rows.push_back(row);
+    }
+    catch(const std::exception& e) {
+        row.error = e.what();
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+void Sweep::run(const std::string& results_fp) {
+    std::cout << "Running sweep: " << points_.size() << " point(s) x "
+              << num_replications_ << " replication(s) on "
+              << num_threads_ << " thread(s)" << std::endl;
+
+    // Work queue. Workers claim the next unsimulated point.
+    std::vector<std::vector<Row>> rows(points_.size());
+    std::atomic<size_t> next_idx(0);
+    std::mutex mutex; // Guards stdout and the completion count
+    size_t num_completed = 0;
+
+    auto worker = [&]() {
+        for (size_t idx = next_idx++; idx < points_.size();
+             idx = next_idx++) {
+            rows[idx] = simulatePoint(idx);
+            const Row& row = rows[idx].back();
+
+            // Report progress
+            std::lock_guard<std::mutex> lock(mutex);
+            std::cout << "[" << ++num_completed << "/" << points_.size()
+                      << "] " << points_[idx].name << ": ";
+            if (!row.error.empty()) {
+                std::cout << "Error: " << row.error << std::endl;
+            }
+            else {
+                std::cout << std::fixed << std::setprecision(4)
+                          << "SS goodput = " << row.results.ss_goodput_gbps
+                          << " Gbps, SS DF = " << row.results.ss_displacement_factor
+                          << std::endl;
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (uint32_t idx = 0; idx < num_threads_; idx++) {
+        workers.emplace_back(worker);
+    }
+    for (std::thread& thread : workers) { thread.join(); }
+
+    // Output the combined results table (ordered by grid point)
+    std::ofstream results_of;
+    if (!results_fp.empty()) {
+        results_of.open(results_fp, std::ios::trunc);
+        if (!results_of) {
+            throw std::runtime_error("Failed to open results file: " +
+                                     results_fp + ".");
+        }
+    }
+    std::ostream& out = results_fp.empty() ? std::cout : results_of;
+    out << "name,replication,policy,innocent_rate_bps,attack_rate_bps,"
+        << "service_rate_gbps,innocent_input_rate_gbps,"
+        << "attack_input_rate_gbps,average_psize_bits,"
+        << "maximum_psize_bits,average_jsize_ns,maximum_jsize_ns,"
+        << "innocent_arrivals,total_arrivals,num_drops_i,num_drops_a,"
+        << "num_preemptions,average_batch_size,average_goodput_gbps,"
+        << "ss_goodput_gbps,ss_displacement_factor,num_servers,"
+        << "server_utilizations,scheduler_utilizations,num_cores,"
+        << "core_goodputs_gbps,"
+        << "core_load_imbalance,latency_p50_ns_i,latency_p99_ns_i,"
+        << "latency_p999_ns_i,latency_p50_ns_a,latency_p99_ns_a,"
+        << "latency_p999_ns_a,bm_goodput_gbps,bm_goodput_ci_gbps,"
+        << "bm_displacement_factor,bm_displacement_factor_ci,num_batches,"
+        << "num_warmup_batches,is_converged,seed,error" << std::endl;
+
+    for (size_t idx = 0; idx < points_.size(); idx++) {
+        for (const Row& row : rows[idx]) {
+            const SimulationResults& results = row.results;
+
+            // Sanitize the error message
+            std::string error = row.error;
+            std::replace(error.begin(), error.end(), '"', '\'');
+
+            // Per-server utilizations, and per-core scheduler
+            // utilizations and goodputs (';'-separated)
+            std::stringstream utilizations, scheduler_utilizations, goodputs;
+            utilizations << std::fixed << std::setprecision(4);
+            for (size_t server = 0; server < results.server_utilizations.size();
+                 server++) {
+                utilizations << ((server == 0) ? "" : ";")
+                             << results.server_utilizations[server];
+            }
+            scheduler_utilizations << std::fixed << std::setprecision(4);
+            for (size_t core = 0; core < results.scheduler_utilizations.size();
+                 core++) {
+                scheduler_utilizations << ((core == 0) ? "" : ";")
+                                       << results.scheduler_utilizations[core];
+            }
+            goodputs << std::fixed << std::setprecision(4);
+            for (size_t core = 0; core < results.core_goodputs_gbps.size();
+                 core++) {
+                goodputs << ((core == 0) ? "" : ";")
+                         << results.core_goodputs_gbps[core];
+            }
+
+            out << points_[idx].name << "," << row.replication << ","
+                << row.policy << ","
+                << std::fixed << std::setprecision(0)
+                << row.innocent_rate_bps << "," << row.attack_rate_bps << ","
+                << std::setprecision(4)
+                << results.service_rate_gbps_i << ","
+                << results.input_rate_gbps_i << ","
+                << results.input_rate_gbps_a << ","
+                << results.average_psize_i << ","
+                << results.maximum_psize_i << ","
+                << results.average_jsize_i << ","
+                << results.maximum_jsize_i << ","
+                << results.num_innocent_arrivals << ","
+                << results.num_arrivals << ","
+                << results.num_drops_i << ","
+                << results.num_drops_a << ","
+                << results.num_preemptions << ","
+                << results.average_batch_size << ","
+                << results.last_goodput_gbps << ","
+                << results.ss_goodput_gbps << ","
+                << results.ss_displacement_factor << ","
+                << results.server_utilizations.size() << ","
+                << utilizations.str() << ","
+                << scheduler_utilizations.str() << ","
+                << results.core_goodputs_gbps.size() << ","
+                << goodputs.str() << ","
+                << results.core_load_imbalance << ","
+                << results.latency_p50_ns_i << ","
+                << results.latency_p99_ns_i << ","
+                << results.latency_p999_ns_i << ","
+                << results.latency_p50_ns_a << ","
+                << results.latency_p99_ns_a << ","
+                << results.latency_p999_ns_a << ","
+                << results.bm_goodput_gbps << ","
+                << results.bm_goodput_ci_gbps << ","
+                << results.bm_displacement_factor << ","
+                << results.bm_displacement_factor_ci << ","
+                << results.num_batches << ","
+                << results.num_warmup_batches << ","
+                << results.is_converged << ","
+                << row.seed << ","
+                << "\"" << error << "\"" << std::endl;
+        }
+    }
+    if (!results_fp.empty()) {
+        std::cout << "Wrote results: " << results_fp << std::endl;
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef SIMULATOR_SWEEP_H
+#define SIMULATOR_SWEEP_H
+
+// Library headers
+#include "simulator.h"
+#include "traffic/trace_cache.h"
+
+// STD headers
+#include <cmath>
+#include <string>
+#include <vector>
+
+// Libconfig
+#include <libconfig.h++>
+
+/**
+ * Implements an in-process parameter sweep. Given a template
+ * configuration and a grid specification, runs one simulation
+ * per grid point on a pool of worker threads, and writes the
+ * results of all the simulations to a single (CSV) table.
+ *
+ * Each point is simulated using a fresh copy of the template
+ * with the point's overrides applied. Immutable inputs (e.g.,
+ * parsed traces) are shared across points; components with
+ * mutable state (queues, applications, distributions and the
+ * RNGs they own) are instantiated afresh for every point. If
+ * several replications are requested, each point's simulator
+ * is reset and re-run (rather than reconstructed).
+ *
+ * By default, all points share the same RNG seed, so the n'th
+ * replication of every point sees common random numbers (e.g.,
+ * identical innocent packet and job sizes across policies).
+ */
+class Sweep final {
+public:
+    /**
+     * Represents a single point in the parameter grid. Unset
+     * parameters (NaN, negative, or empty) retain the value
+     * specified in the template configuration.
+     */
+    struct Point {
+        std::string name;                   // Point name
+        std::string policy;                 // Scheduling policy
+        double innocent_rate_bps = NAN;     // Innocent traffic rate (bps)
+        double innocent_psize_bits = NAN;   // Average innocent psize (bits)
+        double attack_rate_bps = NAN;       // Attack traffic rate (bps)
+        double attack_jsize_ns = NAN;       // Attack job size (ns)
+        int64_t attack_psize_bits = -1;     // Attack packet size (bits)
+        int64_t attack_num_flows = -1;      // Attack flow count
+        std::string output_fp;              // Path to a results summary
+        std::string packets_fp;             // Path to a packets file
+    };
+
+private:
+    std::string template_; // Template configuration (text)
+    std::vector<Point> points_; // Grid points
+    uint32_t num_threads_ = 0; // Worker thread count
+    uint32_t num_replications_ = 1; // Replications per point
+    uint64_t seed_ = 0; // Base RNG seed
+    bool is_seed_set_ = false; // Seed overrides the template's?
+    bool is_crn_ = true; // Use common random numbers across points?
+    TraceCache trace_cache_; // Shared, pre-parsed traces
+
+    /**
+     * Result of simulating a single replication of a grid point.
+     */
+    struct Row {
+        uint32_t replication = 0;   // Replication index
+        uint64_t seed = 0;          // RNG seed
+        std::string policy;         // Effective policy
+        double innocent_rate_bps;   // Effective innocent rate
+        double attack_rate_bps;     // Effective attack rate
+        SimulationResults results;  // Simulation results
+        std::string error;          // Error message (if any)
+    };
+
+    // Internal helper methods
+    void parseGrid(const libconfig::Setting& grid);
+    static void applyPoint(const Point& point, libconfig::Setting& root);
+    std::vector<Row> simulatePoint(const size_t idx);
+
+public:
+    explicit Sweep(const std::string& template_fp,
+                   const libconfig::Setting& grid,
+                   const uint32_t num_threads = 0);
+
+    // Accessors
+    size_t getNumPoints() const { return points_.size(); }
+    uint32_t getNumThreads() const { return num_threads_; }
+    uint32_t getNumReplications() const { return num_replications_; }
+
+    /**
+     * Sets the base RNG seed (overriding the grid and template).
+     */
+    void setSeed(const uint64_t seed) { seed_ = seed; is_seed_set_ = true; }
+
+    /**
+     * Runs the sweep, writing the combined results table to the
+     * given file path (or to stdout, if the path is empty).
+     */
+    void run(const std::string& results_fp="");
+};
+
+#endif // SIMULATOR_SWEEP_H
@@ -31,7 +31,7 @@ Packet SyntheticTrafficGenerator::getNextArrival(const uint64_t packet_idx) {
 Packet InnocentTrafficGenerator::
 getNextArrivalImpl(const uint64_t packet_idx) {
     // Generate the next (innocent) flow ID to use
-    FlowId flow_id = FlowId::from(next_flow_id_);
+    FlowId flow_id = FlowId::from(kFlowIdOffset + next_flow_id_);
     if (++next_flow_id_ == kNumFlows) {
         next_flow_id_ = 0;
     }
@@ -86,8 +86,12 @@ void InnocentTrafficGenerator::calibrate(const double rate) {
 AttackTrafficGenerator::AttackTrafficGenerator(
     const uint32_t num_flows, const uint32_t fid_offset,
     ConstantDistribution* const iat_dist, const uint32_t p,
-    const double j) : SyntheticTrafficGenerator(num_flows, iat_dist),
-    kFlowIdOffset(fid_offset), kAttackJobSizeNs(j), kAttackPacketSizeBits(p) {
+    const double j) : SyntheticTrafficGenerator(num_flows, fid_offset,
+    iat_dist), kAttackJobSizeNs(j),
+    kAttackPacketSizeBits(p) { AttackTrafficGenerator::reset(); }
+
+void AttackTrafficGenerator::reset() {
+    SyntheticTrafficGenerator::reset();
 
     // Special case: zero attack bandwidth (innocent arrivals only)
     if (iat_dist_->getSampleStats().getMean() == kDblPosInfty) {
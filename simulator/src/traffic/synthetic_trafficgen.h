@@ -18,14 +18,16 @@ protected:
     // the distribution should be a user-configurable parameter.
     ConstantDistribution* iat_dist_ = nullptr; // IATs (ns)
     const uint32_t kNumFlows = 1; // Number of flows to use
+    const uint32_t kFlowIdOffset = 0; // Flow ID offset
 
     // Housekeeping
     uint32_t next_flow_id_ = 0;
     bool is_calibrated_ = false; // Calibrated?
 
-    explicit SyntheticTrafficGenerator(
-        const uint32_t num_flows, ConstantDistribution* const iat_dist) :
-        TrafficGenerator(name()), iat_dist_(iat_dist), kNumFlows(num_flows) {}
+    explicit SyntheticTrafficGenerator(const uint32_t num_flows,
+        const uint32_t fid_offset, ConstantDistribution* const iat_dist) :
+        TrafficGenerator(name()), iat_dist_(iat_dist), kNumFlows(num_flows),
+        kFlowIdOffset(fid_offset) {}
 
     /**
      * Helper method. Returns the next packet arrival.
@@ -98,14 +100,22 @@ private:
 public:
     virtual ~InnocentTrafficGenerator() { delete(psize_dist_); }
     explicit InnocentTrafficGenerator(const uint32_t num_flows,
-        ConstantDistribution* const iat_dist, Distribution* const psize_dist) :
-        SyntheticTrafficGenerator(num_flows, iat_dist), psize_dist_(psize_dist) {}
+        ConstantDistribution* const iat_dist, Distribution* const psize_dist,
+        const uint32_t fid_offset=0) : SyntheticTrafficGenerator(num_flows,
+        fid_offset, iat_dist), psize_dist_(psize_dist) {}
 
     /**
      * Print the distribution configuration.
      */
     virtual void printConfiguration() const override;
 
+    /**
+     * Seeds the packet size distribution.
+     */
+    virtual void seed(const uint64_t seed) override {
+        psize_dist_->seed(seed);
+    }
+
     // Calibrate the traffic-generator
     void calibrate(const double rate);
 };
@@ -115,7 +125,6 @@ public:
  */
 class AttackTrafficGenerator final : public SyntheticTrafficGenerator {
 private:
-    const uint32_t kFlowIdOffset; // Flow ID offset
     const double kAttackJobSizeNs; // Adversarial job size (ns)
     const uint32_t kAttackPacketSizeBits; // Adversarial packet size (bits)
 
@@ -136,6 +145,11 @@ public:
 
     virtual ~AttackTrafficGenerator() {}
 
+    /**
+     * Resets the traffic-generator to its initial state.
+     */
+    virtual void reset() override;
+
     /**
      * Print the distribution configuration.
      */
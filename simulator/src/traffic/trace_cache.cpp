@@ -0,0 +1,30 @@
+#include "trace_cache.h"
+
+// Library headers
+#include "trace_trafficgen.h"
+
+// STD headers
+#include <fstream>
+#include <stdexcept>
+
+std::shared_ptr<const ParsedTrace>
+TraceCache::get(const std::string& trace_fp) {
+    // Note: Parsing happens under the lock, so concurrent
+    // requests for the same trace only parse it once.
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = traces_.find(trace_fp);
+    if (iter != traces_.end()) { return iter->second; }
+
+    std::ifstream trace_ifs(trace_fp);
+    if (!trace_ifs) {
+        throw std::runtime_error("Failed to open trace: " + trace_fp + ".");
+    }
+    auto trace = std::make_shared<ParsedTrace>();
+    std::string line;
+    while (std::getline(trace_ifs, line)) {
+        trace->push_back(TraceTrafficGenerator::parsePacket(
+            line, trace->size()));
+    }
+    traces_[trace_fp] = trace;
+    return trace;
+}
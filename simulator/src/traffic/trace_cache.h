@@ -0,0 +1,43 @@
+#ifndef SIMULATOR_TRAFFIC_TRACE_CACHE_H
+#define SIMULATOR_TRAFFIC_TRACE_CACHE_H
+
+// Library headers
+#include "common/macros.h"
+#include "packet/packet.h"
+
+// STD headers
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Represents a fully-parsed (immutable) packet trace.
+ */
+using ParsedTrace = std::vector<Packet>;
+
+/**
+ * Thread-safe cache of parsed packet traces. Allows several
+ * simulator instances (e.g., the points of a parameter sweep)
+ * to share a single in-memory copy of each trace, instead of
+ * re-reading and re-parsing the trace file in every instance.
+ */
+class TraceCache final {
+private:
+    std::mutex mutex_; // Guards the map below
+    std::unordered_map<std::string, std::shared_ptr<
+        const ParsedTrace>> traces_; // Trace path -> Trace
+
+public:
+    explicit TraceCache() {}
+    DISALLOW_COPY_AND_ASSIGN(TraceCache);
+
+    /**
+     * Returns the parsed trace corresponding to the given
+     * file path, reading and parsing it on first access.
+     */
+    std::shared_ptr<const ParsedTrace> get(const std::string& trace_fp);
+};
+
+#endif // SIMULATOR_TRAFFIC_TRACE_CACHE_H
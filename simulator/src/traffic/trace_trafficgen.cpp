@@ -17,6 +17,11 @@ TraceTrafficGenerator::TraceTrafficGenerator(const std::string& trace_fp,
     updateHasNewArrival();
 }
 
+TraceTrafficGenerator::TraceTrafficGenerator(const std::string& trace_fp,
+    std::shared_ptr<const ParsedTrace> trace, ConstantDistribution* const
+    iat_dist) : TrafficGenerator(name()), trace_fp_(trace_fp),
+    iat_dist_(iat_dist), trace_(trace) { updateHasNewArrival(); }
+
 TraceTrafficGenerator::~TraceTrafficGenerator() {
     // Deallocate resources
     trace_ifs_.close();
@@ -24,8 +29,11 @@ TraceTrafficGenerator::~TraceTrafficGenerator() {
 }
 
 void TraceTrafficGenerator::updateHasNewArrival() {
-    has_new_arrival_ = (trace_ifs_.peek() !=
-                        std::ifstream::traits_type::eof());
+    if (trace_) { has_new_arrival_ = (trace_pos_ < trace_->size()); }
+    else {
+        has_new_arrival_ = (trace_ifs_.peek() !=
+                            std::ifstream::traits_type::eof());
+    }
 }
 
 double TraceTrafficGenerator::getRateInBitsPerSecondImpl() const {
@@ -58,8 +66,11 @@ void TraceTrafficGenerator::printConfiguration() const {
 
 void TraceTrafficGenerator::reset() {
     arrival_time_ = 0;
-    trace_ifs_.clear();
-    trace_ifs_.seekg(0);
+    if (trace_) { trace_pos_ = 0; }
+    else {
+        trace_ifs_.clear();
+        trace_ifs_.seekg(0);
+    }
     updateHasNewArrival();
 }
 
@@ -69,10 +80,29 @@ void TraceTrafficGenerator::updateArrivalTime() {
 
 Packet TraceTrafficGenerator::getNextArrival(const uint64_t packet_idx) {
     assert(has_new_arrival_); // Sanity check
-    std::getline(trace_ifs_, line_);
 
+    // Fetch the next packet from the shared trace or filestream
+    Packet packet;
+    if (trace_) {
+        packet = (*trace_)[trace_pos_++];
+        packet.setPacketIdx(packet_idx);
+    }
+    else {
+        std::getline(trace_ifs_, line_);
+        packet = parsePacket(line_, packet_idx);
+    }
+    // End of trace?
+    updateHasNewArrival();
+
+    // Update the packet's arrival time and return
+    packet.setArriveTime(arrival_time_);
+    return packet;
+}
+
+Packet TraceTrafficGenerator::parsePacket(const std::string& line,
+                                          const uint64_t packet_idx) {
     // Parse the packet fields
-    auto values = split(line_, ",");
+    auto values = split(line, ",");
     assert(values.size() >= 9); // Minimum values
 
     // Extract Ethernet and IP fields
@@ -109,11 +139,6 @@ Packet TraceTrafficGenerator::getNextArrival(const uint64_t packet_idx) {
         double jsize = std::stod(values[9]);
         packet.setJobSizeEstimate(jsize);
     }
-    // End of trace?
-    updateHasNewArrival();
-
-    // Update the packet's arrival time and return
-    packet.setArriveTime(arrival_time_);
     return packet;
 }
 
@@ -3,10 +3,12 @@
 
 // Library headers
 #include "common/distributions/constant_distribution.h"
+#include "trace_cache.h"
 #include "trafficgen.h"
 
 // STD headers
 #include <fstream>
+#include <memory>
 #include <sstream>
 
 /**
@@ -23,6 +25,11 @@ private:
     std::ifstream trace_ifs_; // Trace input filestream
     double avg_psize_ = NAN; // Average packet size (in bits)
 
+    // If set, packets are read from a shared, pre-parsed
+    // copy of the trace instead of the input filestream.
+    std::shared_ptr<const ParsedTrace> trace_;
+    size_t trace_pos_ = 0; // Index of the next packet
+
     // Housekeeping
     std::string line_; // Scratchpad
 
@@ -39,11 +46,21 @@ public:
     explicit TraceTrafficGenerator(const std::string& trace_fp,
                                    ConstantDistribution* const iat_dist);
 
+    explicit TraceTrafficGenerator(const std::string& trace_fp,
+                                   std::shared_ptr<const ParsedTrace> trace,
+                                   ConstantDistribution* const iat_dist);
+
     /**
      * Returns the traffic-gen name.
      */
     static std::string name() { return "trace"; }
 
+    /**
+     * Parses a single line of a trace file into a packet.
+     */
+    static Packet parsePacket(const std::string& line,
+                              const uint64_t packet_idx);
+
     /**
      * Print the distribution configuration.
      */
@@ -47,6 +47,12 @@ public:
      */
     virtual void reset() = 0;
 
+    /**
+     * Seeds the traffic-generator's random streams (if any).
+     * Deterministic traffic-gens need not override this.
+     */
+    virtual void seed(const uint64_t /* seed */) {}
+
     /**
      * Invokes the implementation-specific virtual method to update the
      * arrival time. TODO(natre): This is a hack. Ideally, the traffic-
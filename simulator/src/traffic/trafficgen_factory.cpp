@@ -3,8 +3,6 @@
 // Library headers
 #include "common/distributions/distribution_factory.h"
 #include "common/macros.h"
-#include "synthetic_trafficgen.h"
-#include "trace_trafficgen.h"
 
 // STD headers
 #include <iostream>
@@ -13,7 +11,7 @@
 TrafficGenerator* TrafficGeneratorFactory::generate(
     const bool is_dry_run, const TrafficClass tg_type,
     const libconfig::Setting& tg_config,
-    const uint32_t fid_start_offset) {
+    const uint32_t fid_start_offset, TraceCache* const trace_cache) {
     TrafficGenerator* tg = nullptr;
 
     // Default inter-arrival time for dry-runs
@@ -50,7 +48,14 @@ TrafficGenerator* TrafficGeneratorFactory::generate(
         }
 
         ConstantDistribution* iat_dist = new ConstantDistribution(iat_ns);
-        auto trace_tg = new TraceTrafficGenerator(trace_fp, iat_dist);
+        TraceTrafficGenerator* trace_tg = nullptr;
+        if (trace_cache == nullptr) {
+            trace_tg = new TraceTrafficGenerator(trace_fp, iat_dist);
+        }
+        else {
+            trace_tg = new TraceTrafficGenerator(
+                trace_fp, trace_cache->get(trace_fp), iat_dist);
+        }
         if (is_calibrated) { trace_tg->calibrate(avg_psize); }
         tg = trace_tg;
     }
@@ -85,7 +90,7 @@ TrafficGenerator* TrafficGeneratorFactory::generate(
 
             ConstantDistribution* iat_dist = new ConstantDistribution(iat_ns);
             auto synthetic_tg = new InnocentTrafficGenerator(
-                nflows, iat_dist, psize_dist);
+                nflows, iat_dist, psize_dist, fid_start_offset);
 
             if (is_calibrated) {synthetic_tg->calibrate(rate); }
             tg = synthetic_tg;
@@ -2,6 +2,10 @@
 #define SIMULATOR_TRAFFIC_TRAFFICGEN_FACTORY_H
 
 // Library headers
+#include "common/type_dispatch.h"
+#include "synthetic_trafficgen.h"
+#include "trace_cache.h"
+#include "trace_trafficgen.h"
 #include "trafficgen.h"
 
 // Libconfig
@@ -12,15 +16,24 @@
  */
 class TrafficGeneratorFactory final {
 public:
+    // Built-in innocent and attack traffic-gen types (see Simulator::run)
+    typedef TypeDispatcher<TrafficGenerator, InnocentTrafficGenerator,
+                           TraceTrafficGenerator> InnocentTypes;
+
+    typedef TypeDispatcher<TrafficGenerator,
+                           AttackTrafficGenerator> AttackTypes;
+
     /**
-     * Returns a traffic-gen corresponding
-     * to the parameterized configuration.
+     * Returns a traffic-gen corresponding to the parameterized
+     * configuration. If a trace cache is provided, trace-driven
+     * traffic-gens read from a shared, pre-parsed trace.
      */
     static TrafficGenerator*
     generate(const bool is_dry_run,
              const TrafficClass tg_type,
              const libconfig::Setting& tg_config,
-             const uint32_t fid_start_offset = 0);
+             const uint32_t fid_start_offset = 0,
+             TraceCache* const trace_cache = nullptr);
 };
 
 #endif // SIMULATOR_TRAFFIC_TRAFFICGEN_FACTORY_H